@@ -0,0 +1,130 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#ifndef SWIG
+#include <vector>
+#include <cstddef>
+
+#include "tasks.h"
+#include "schedulability.h"
+#endif
+
+/* Many task sets in packed form.
+ *
+ * The tasks of all task sets are stored back to back in one flat array of
+ * TASK_PARAMS unsigned longs per task (wcet, period, deadline; a deadline
+ * of zero denotes an implicit deadline, as in TaskSet::add_task()). Task
+ * set i consists of the tasks with indices offsets[i] ... offsets[i+1]-1.
+ */
+class TaskSetBatch
+{
+  private:
+    std::vector<unsigned long> offsets;
+    std::vector<unsigned long> params;
+
+  public:
+    enum { TASK_PARAMS = 3 };
+
+    TaskSetBatch() : offsets(1, 0) {}
+
+    // offsets has num_sets + 1 entries, params TASK_PARAMS per task
+    bool load(const unsigned long *offsets, unsigned int num_sets,
+              const unsigned long *params);
+
+    // Same as above, but from raw machine words (e.g., the contents of
+    // Python's array.array('L')). Returns false if the buffers are
+    // inconsistent.
+    bool load_packed(const char *offsets, size_t offsets_len,
+                     const char *params, size_t params_len);
+
+    void add_task_set(const TaskSet &ts);
+
+    unsigned int get_task_set_count() const
+    {
+        return offsets.size() - 1;
+    }
+
+    unsigned int get_task_count(unsigned int task_set) const
+    {
+        return offsets[task_set + 1] - offsets[task_set];
+    }
+
+    void get_task_set(unsigned int task_set, TaskSet &ts) const;
+};
+
+/* Evaluates a list of schedulability tests for each task set in a batch.
+ *
+ * The result of test j for task set i is bit (i * get_test_count() + j)
+ * of the result bitmap, least-significant bit first.
+ *
+ * If a budget is set, each test is given a fresh copy of it for each task
+ * set; task sets for which a test runs out of budget are counted as not
+ * schedulable and flagged as unknown.
+ */
+class BatchSchedulabilityTest
+{
+  private:
+    // not owned; must outlive run()
+    std::vector<SchedulabilityTest*> tests;
+    std::vector<unsigned char> results;
+    std::vector<unsigned char> unknown;
+    unsigned int num_task_sets;
+
+    Budget budget;
+    bool use_budget;
+
+  public:
+    BatchSchedulabilityTest() : num_task_sets(0), use_budget(false) {}
+
+    // bound each test and task set by a copy of budget
+    void set_budget(const Budget &budget)
+    {
+        this->budget = budget;
+        use_budget = true;
+    }
+
+    void add_test(SchedulabilityTest *test)
+    {
+        tests.push_back(test);
+    }
+
+    unsigned int get_test_count() const
+    {
+        return tests.size();
+    }
+
+    unsigned int get_task_set_count() const
+    {
+        return num_task_sets;
+    }
+
+    void run(const TaskSetBatch &batch, bool check_preconditions = true);
+
+    bool is_schedulable(unsigned int task_set, unsigned int test) const
+    {
+        unsigned long bit = (unsigned long) task_set * tests.size() + test;
+        return (results[bit / 8] >> (bit % 8)) & 1;
+    }
+
+    // whether the test ran out of budget on the task set
+    bool is_unknown(unsigned int task_set, unsigned int test) const
+    {
+        unsigned long bit = (unsigned long) task_set * tests.size() + test;
+        return (unknown[bit / 8] >> (bit % 8)) & 1;
+    }
+
+    // number of task sets deemed schedulable by the given test
+    unsigned int count_schedulable(unsigned int test) const;
+
+    // number of task sets on which the given test ran out of budget
+    unsigned int count_unknown(unsigned int test) const;
+
+#ifndef SWIG
+    const std::vector<unsigned char>& get_results() const
+    {
+        return results;
+    }
+#endif
+};
+
+#endif
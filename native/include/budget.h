@@ -0,0 +1,143 @@
+#ifndef BUDGET_H
+#define BUDGET_H
+
+#ifndef SWIG
+#include <algorithm>
+
+#include "cpu_time.h"
+#endif
+
+enum sched_result_t
+{
+    SCHED_UNSCHEDULABLE = 0,
+    SCHED_SCHEDULABLE   = 1,
+    // the test ran out of budget before reaching a conclusion
+    SCHED_UNKNOWN       = 2
+};
+
+/* Limits the work of one call of an analysis: CPU time (of the calling
+ * thread, in seconds), iterations of its outer loops, and test points,
+ * i.e., points in time at which a demand or interference condition is
+ * evaluated. A limit of zero means unlimited. An analysis that runs out of
+ * budget gives up, and is_exhausted() tells this outcome apart from a
+ * negative result.
+ *
+ * A budget may be used by only one thread at a time, namely the one that
+ * created or last reset() it, since its clock is that thread's CPU time.
+ */
+class Budget
+{
+  private:
+    double max_cpu_time;
+    unsigned long max_iterations;
+    unsigned long max_test_points;
+
+    double start_time;
+    unsigned long iterations;
+    unsigned long test_points;
+    unsigned long steps;
+    bool exhausted;
+
+    // reading the clock is a system call; do so only every few steps
+    enum { CLOCK_CHECK_INTERVAL = 10 };
+
+    bool step()
+    {
+        if (max_cpu_time > 0 && ++steps % CLOCK_CHECK_INTERVAL == 0
+            && get_cpu_usage() > start_time + max_cpu_time)
+            exhausted = true;
+        return !exhausted;
+    }
+
+    // zero means unlimited, hence at least one step is left
+    static unsigned long left(unsigned long limit, unsigned long used)
+    {
+        return !limit ? 0 : (used < limit ? limit - used : 1);
+    }
+
+  public:
+    Budget(double max_cpu_time = 0,
+           unsigned long max_iterations = 0,
+           unsigned long max_test_points = 0)
+        : max_cpu_time(max_cpu_time),
+          max_iterations(max_iterations),
+          max_test_points(max_test_points)
+    {
+        reset();
+    }
+
+    // start over with the full budget on the calling thread
+    void reset()
+    {
+        start_time = get_cpu_usage();
+        iterations = test_points = steps = 0;
+        exhausted = false;
+    }
+
+    // Account for one iteration or test point. Returns false once the
+    // budget is exhausted; the caller should then give up.
+    bool charge_iteration()
+    {
+        if (++iterations > max_iterations && max_iterations)
+            exhausted = true;
+        return step();
+    }
+
+    bool charge_test_point()
+    {
+        if (++test_points > max_test_points && max_test_points)
+            exhausted = true;
+        return step();
+    }
+
+    bool is_exhausted() const
+    {
+        return exhausted;
+    }
+
+    /* For parallel analyses: a budget with the limits that are left, to be
+     * copied and reset() by each worker thread (so that each worker may
+     * use all of the remainder), and merged back with absorb() once the
+     * workers are done. Must not be called on an exhausted budget.
+     */
+    Budget remaining() const
+    {
+        double cpu_left = 0;
+        if (max_cpu_time > 0)
+            cpu_left = std::max(max_cpu_time - get_cpu_time(), 1E-6);
+        return Budget(cpu_left,
+                      left(max_iterations, iterations),
+                      left(max_test_points, test_points));
+    }
+
+    void absorb(const Budget &part)
+    {
+        iterations  += part.iterations;
+        test_points += part.test_points;
+        if (part.exhausted)
+            exhausted = true;
+    }
+
+    unsigned long get_iterations() const
+    {
+        return iterations;
+    }
+
+    unsigned long get_test_points() const
+    {
+        return test_points;
+    }
+
+    // CPU time used since the last reset()
+    double get_cpu_time() const
+    {
+        return get_cpu_usage() - start_time;
+    }
+
+    double get_max_cpu_time() const
+    {
+        return max_cpu_time;
+    }
+};
+
+#endif
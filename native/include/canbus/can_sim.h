@@ -4,6 +4,7 @@
 #include "canbus/msgs.h"
 #include "schedule_sim.h"
 #include "event.h"
+#include "object-pool.h"
 
 #include <vector>
 #include <queue>
@@ -26,16 +27,16 @@ using namespace std;
 class CANJob : public Job {
   protected:
     const CANTask  &task;
-    std::vector<simtime_t> omissions;
-    std::vector<simtime_t> commissions;
+    // host fault instants, consumed from next_host_fault onwards
     std::vector<int> host_faults;
+    unsigned int next_host_fault;
 
   public:
     CANJob(const CANTask &tsk,
            simtime_t relt = 0,
            unsigned long sequence_no = 1,
            simtime_t cst = 0)
-           : Job(tsk, relt, sequence_no, cst), task(tsk) {}
+           : Job(tsk, relt, sequence_no, cst), task(tsk), next_host_fault(0) {}
 
     const CANTask& get_task() const { return task; }
     simtime_t get_priority() const { return task.get_priority(); }
@@ -104,6 +105,22 @@ class SimCANJob : public CANJob, public Event<simtime_t>
 };
 
 typedef PeriodicJobSequenceTemplate<SimCANJob, CANTask> PeriodicCANJobSequence;
+
+/* Expiry of the deadline of a job; a copy of the job is kept because the
+job sequence moves on to the next job before the deadline. Allocated from
+the ObjectPool of the CANBusScheduler and returned to it after firing. */
+class DeadlineEvent : public SimCANJob
+{
+  public:
+    DeadlineEvent(const CANTask &task,
+                  unsigned long release,
+                  unsigned long seqno,
+                  unsigned long cost,
+                  CANBusScheduleSimulation *s) :
+                  SimCANJob(task, release, seqno, cost, s) {};
+
+    void fire(const simtime_t &time);
+};
 typedef ProcessorTemplate<CANJob> CANBus;
 typedef PreemptionOrderTemplate<FixedPriorityScheduling, CANBus> CANBusPreemptionOrder;
 
@@ -137,6 +154,10 @@ class CANBusScheduler : public CANBusScheduleSimulation
     bool aborted;
 
     std::vector<simtime_t> retransmissions;
+    unsigned int next_retransmission;
+
+    // outstanding deadline events, recycled across jobs and runs
+    ObjectPool<DeadlineEvent> deadline_events;
 
     bool is_retransmission(simtime_t, simtime_t);
     void advance_time(simtime_t);
@@ -146,6 +167,7 @@ class CANBusScheduler : public CANBusScheduleSimulation
     {
         aborted = false;
         current_time = 0;
+        next_retransmission = 0;
         processor = new CANBus();
     }
 
@@ -163,13 +185,18 @@ class CANBusScheduler : public CANBusScheduleSimulation
     void abort() { aborted = true; }
     void reset_current_time() { current_time = 0; }
     void reset_processors() { processor->idle(); }
-    void reset_retransmissions() { retransmissions.clear(); }
+    void reset_retransmissions()
+    {
+        retransmissions.clear();
+        next_retransmission = 0;
+    }
 
     void simulate_until(simtime_t end_of_simulation);
     void add_ready(CANJob *job);
     void add_release(SimCANJob *job);
     void reset_events_and_pending_queues();
     bool gen_retransmissions(double rate, simtime_t max);
+    void deadline_event_fired(DeadlineEvent *event);
 
     virtual void retransmit(CANJob *job);
     // simulation event callback interface
@@ -182,21 +209,4 @@ class CANBusScheduler : public CANBusScheduleSimulation
     virtual void job_deadline_expired(CANJob* job) {};
 };
 
-class DeadlineEvent : public SimCANJob
-{
-  public:
-    DeadlineEvent(const CANTask &task,
-                  unsigned long release,
-                  unsigned long seqno,
-                  unsigned long cost,
-                  CANBusScheduleSimulation *s) :
-                  SimCANJob(task, release, seqno, cost, s) {};
-    
-    void fire(const simtime_t &time)
-    {
-        ((CANBusScheduler *)sim)->job_deadline_expired(this);
-        delete this;
-    }
-};
-
 #endif
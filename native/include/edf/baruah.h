@@ -1,28 +1,54 @@
 #ifndef BARUAH_H
 #define BARUAH_H
 
+class TaskColumns;
+
 class BaruahGedf : public SchedulabilityTest
 {
 
 private:
     unsigned int m;
+    unsigned int num_threads;
 
     bool is_task_schedulable(unsigned int k,
                              const TaskSet &ts,
+                             const TaskColumns &cols,
                              const integral_t &ilen,
                              integral_t &i1,
                              integral_t &sum,
                              integral_t *idiff,
-                             integral_t **ptr);
+                             integral_t **ptr,
+                             long *words,
+                             unsigned long *dbf_fast,
+                             unsigned long *dbf_prime_fast);
 
     void get_max_test_points(const TaskSet &ts, fractional_t& m_minus_u,
                              integral_t* maxp);
 
-public:
-    BaruahGedf(unsigned int num_processors) : m(num_processors) {};
+    sched_result_t check_in_parallel(const TaskSet &ts,
+                                     const TaskColumns &cols,
+                                     integral_t *max_test_point,
+                                     unsigned int threads,
+                                     Budget &budget);
 
+public:
+    /* With num_threads != 1, the test points of all tasks are checked
+     * concurrently by num_threads workers (zero: one per hardware
+     * thread), which stop as soon as one of them finds a violation. The
+     * CPU time limit of a budget then applies to each worker separately.
+     */
+    BaruahGedf(unsigned int num_processors, unsigned int num_threads = 1)
+        : m(num_processors), num_threads(num_threads) {};
+
+    // bounded by a budget of MAX_RUNTIME; gives up (false) after that
     bool is_schedulable(const TaskSet &ts, bool check_preconditions = true);
 
+    sched_result_t check(const TaskSet &ts, Budget &budget,
+                         bool check_preconditions = true);
+
+    sched_result_t check_default_limits(const TaskSet &ts,
+                                        bool check_preconditions = true);
+
     static const double MAX_RUNTIME;
 };
 
@@ -1,28 +1,54 @@
 #ifndef FFDBF_H
 #define FFDBF_H
 
+struct FixedSpeed;
+struct FixedTime;
+
 class FFDBFGedf : public SchedulabilityTest
 {
   private:
     const unsigned int m;
     const unsigned long epsilon_denom;
+    const unsigned long sigma_granularity;
     const fractional_t sigma_step;
+    const unsigned int num_threads;
 
   private:
     bool witness_condition(const TaskSet &ts,
                            const integral_t q[], const fractional_t r[],
                            const fractional_t &time, const fractional_t &speed);
 
+    bool check_fixed(const TaskSet &ts, Budget &budget,
+                     sched_result_t &result);
+
+    bool scan_fixed(const TaskSet &ts, const FixedSpeed &s,
+                    long time_bound, FixedTime &t, Budget &budget);
+
+    bool scan_fixed_in_parallel(const TaskSet &ts, const FixedSpeed &s,
+                                long time_bound, FixedTime &t,
+                                unsigned int threads, Budget &budget);
+
   public:
+    /* With num_threads != 1, the test points of each speed are checked
+     * concurrently by num_threads workers (zero: one per hardware
+     * thread). The CPU time limit of a budget then applies to each worker
+     * separately.
+     */
     FFDBFGedf(unsigned int num_processors,
               unsigned long epsilon_denom = 10,
-              unsigned long sigma_granularity = 50)
+              unsigned long sigma_granularity = 50,
+              unsigned int num_threads = 1)
         :  m(num_processors),
            epsilon_denom(epsilon_denom),
-           sigma_step(1, sigma_granularity)
+           sigma_granularity(sigma_granularity),
+           sigma_step(1, sigma_granularity),
+           num_threads(num_threads)
         {};
 
     bool is_schedulable(const TaskSet &ts, bool check_preconditions = true);
+
+    sched_result_t check(const TaskSet &ts, Budget &budget,
+                         bool check_preconditions = true);
 };
 
 #endif
@@ -1,6 +1,21 @@
 #ifndef GEDF_H
 #define GEDF_H
 
+// the sub-tests of GlobalEDF, in their default order
+enum gedf_subtest_t
+{
+    GEDF_BAKER,
+    GEDF_GFB,
+    GEDF_RTA,
+    GEDF_BARUAH,
+    GEDF_FFDBF,
+    GEDF_LA,
+    GEDF_LOAD,
+    GEDF_NUM_SUBTESTS
+};
+
+class GEDFLearnedOrder;
+
 class GlobalEDF : public SchedulabilityTest
 {
 
@@ -13,6 +28,13 @@ class GlobalEDF : public SchedulabilityTest
     bool want_rta;
     bool want_la;
 
+    // NULL unless adaptive
+    GEDFLearnedOrder *learned;
+
+    // no copies
+    GlobalEDF(const GlobalEDF &);
+    GlobalEDF& operator=(const GlobalEDF &);
+
  public:
  GlobalEDF(unsigned int num_processors,
            unsigned long rta_min_step = 1,
@@ -26,9 +48,47 @@ class GlobalEDF : public SchedulabilityTest
        want_load(want_load),
        want_baruah(want_baruah),
        want_rta(want_rta),
-       want_la(want_la) {};
+       want_la(want_la),
+       learned(0) {};
+
+    ~GlobalEDF();
 
     bool is_schedulable(const TaskSet &ts, bool check_preconditions = true);
+
+    // all tests in the chain share the budget
+    sched_result_t check(const TaskSet &ts, Budget &budget,
+                         bool check_preconditions = true);
+
+    // each test in the chain applies its own default limits
+    sched_result_t check_default_limits(const TaskSet &ts,
+                                        bool check_preconditions = true);
+
+    /* In adaptive mode, the order of the sub-tests is learned online. For
+     * each class of task sets (by task count and utilization per
+     * processor), the CPU time and acceptance rate of every sub-test are
+     * recorded, and the sub-tests with the least time per acceptance are
+     * tried first. A task set is schedulable if any sub-test accepts it,
+     * so the order affects only the running time (and, with a budget,
+     * which tests run before it is exhausted). Calls from multiple threads
+     * share what has been learned. Switching the mode forgets it; it must
+     * not be switched while the test is in use (e.g., by a running batch
+     * or sweep).
+     */
+    void set_adaptive(bool adaptive);
+    bool is_adaptive() const;
+
+    // what has been learned so far, summed over all classes
+    unsigned long get_subtest_calls(gedf_subtest_t test) const;
+    unsigned long get_subtest_accepts(gedf_subtest_t test) const;
+    double get_subtest_time(gedf_subtest_t test) const;
+
+ private:
+    // budget == NULL: each test uses its default limits
+    sched_result_t apply_tests(const TaskSet &ts, Budget *budget,
+                               bool check_preconditions);
+
+    bool run_subtest(gedf_subtest_t test, const TaskSet &ts,
+                     Budget *budget, bool &unknown);
 };
 
 
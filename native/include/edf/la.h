@@ -1,6 +1,8 @@
 #ifndef LA_H
 #define LA_H
 
+class TaskColumns;
+
 class LAGedf : public SchedulabilityTest
 {
 
@@ -15,7 +17,12 @@ private:
 		integral_t &i1,
 		integral_t &sum,
 		integral_t *idiff,
-		integral_t **ptr);
+		integral_t **ptr,
+		long *words,
+		const TaskColumns &cols,
+		bool no_tardiness,
+		unsigned long *dbf_fast,
+		unsigned long *delta_fast);
 
 	bool is_task_schedulable_for_suspension_length(
 		const TaskSet &ts,
@@ -23,7 +30,10 @@ private:
 		unsigned long suspend,
 		const fractional_t &m_minus_u,
 		const fractional_t &test_point_sum,
-		const fractional_t &usum);
+		const fractional_t &usum,
+		const TaskColumns &cols,
+		bool no_tardiness,
+		Budget &budget);
 
 	integral_t get_max_test_point(
 		const TaskSet &ts,
@@ -33,11 +43,22 @@ private:
 		const fractional_t &usum,
 		unsigned long suspension);
 
+	// budget == NULL: MAX_RUNTIME per task and suspension length
+	sched_result_t check_all(const TaskSet &ts, Budget *budget,
+				 bool check_preconditions);
+
 public:
 	LAGedf(unsigned int num_processors) : m(num_processors) {};
 
+	// bounded by a budget of MAX_RUNTIME per task and suspension length
 	bool is_schedulable(const TaskSet &ts, bool check_preconditions = true);
 
+	sched_result_t check(const TaskSet &ts, Budget &budget,
+			     bool check_preconditions = true);
+
+	sched_result_t check_default_limits(const TaskSet &ts,
+					    bool check_preconditions = true);
+
 	static const double MAX_RUNTIME;
 };
 
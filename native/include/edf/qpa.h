@@ -1,6 +1,8 @@
 #ifndef QPA_H
 #define QPA_H
 
+class TaskColumns;
+
 class QPATest : public SchedulabilityTest
 {
  public:
@@ -8,8 +10,63 @@ class QPATest : public SchedulabilityTest
 
     bool is_schedulable(const TaskSet &ts, bool check_preconditions = true);
 
-    virtual integral_t get_demand(integral_t interval, const TaskSet &ts);
-    virtual integral_t get_max_interval(const TaskSet &ts, const fractional_t& util);
+    // cols is a columnar copy of ts
+    virtual integral_t get_demand(integral_t interval, const TaskSet &ts,
+                                  const TaskColumns &cols);
+    virtual integral_t get_max_interval(const TaskSet &ts,
+                                        const TaskColumns &cols,
+                                        const fractional_t& util);
+};
+
+/* QPA for a task set that changes one task at a time, such as a bin in a
+ * partitioning heuristic. Instead of recomputing them from scratch on
+ * every check, this keeps the exact utilization, density, and Zhang-Burns
+ * sums, the last EDF busy interval, and a columnar copy of the tasks.
+ *
+ * add_task_if_schedulable() additionally exploits that, if the bin was
+ * schedulable before, only test points at or after the new task's
+ * deadline need to be checked.
+ */
+class IncrementalQPA
+{
+ private:
+    TaskSet tasks;
+    TaskColumns *cols;
+
+    fractional_t util;
+    fractional_t density;      // sum of wcet / min(deadline, period)
+    fractional_t scaled_delta; // sum of (period - deadline) * utilization
+    int num_infeasible;        // infeasible or self-suspending tasks
+
+    integral_t busy_interval;
+    bool busy_interval_valid;
+
+    enum { UNKNOWN, SCHEDULABLE, UNSCHEDULABLE } state;
+
+    void update_sums(const Task &tsk, int sign);
+    bool check(unsigned long known_ok_below);
+
+    // no copies
+    IncrementalQPA(const IncrementalQPA &);
+    IncrementalQPA& operator=(const IncrementalQPA &);
+
+ public:
+    IncrementalQPA();
+    ~IncrementalQPA();
+
+    unsigned int get_task_count() const { return tasks.get_task_count(); }
+    const TaskSet& get_tasks() const { return tasks; }
+
+    void add_task(unsigned long wcet, unsigned long period,
+                  unsigned long deadline = 0);
+    void remove_task(unsigned int idx);
+
+    bool is_schedulable();
+
+    // Adds the task only if the result is schedulable; returns whether
+    // it was added.
+    bool add_task_if_schedulable(unsigned long wcet, unsigned long period,
+                                 unsigned long deadline = 0);
 };
 
 // support for C=D semi-partitioning assignment heuristic
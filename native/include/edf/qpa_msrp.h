@@ -26,8 +26,10 @@ private:
     QPA_MSRPTest(unsigned int num_processors, const ResourceSharingInfo& _info,
                  unsigned int _num_cpus, unsigned int _cpu_id); // Needed by msrp_bounds
 
-    integral_t get_demand(integral_t interval, const TaskSet &ts);
-    integral_t get_max_interval(const TaskSet &ts, const fractional_t& util);
+    integral_t get_demand(integral_t interval, const TaskSet &ts,
+                          const TaskColumns &cols);
+    integral_t get_max_interval(const TaskSet &ts, const TaskColumns &cols,
+                                const fractional_t& util);
 
 
     void set_max_relative_deadline(unsigned long d)
@@ -1,6 +1,10 @@
 #ifndef EDF_SIM_H
 #define EDF_SIM_H
 
+#ifndef SWIG
+#include <vector>
+#endif
+
 struct Stats
 {
     unsigned long num_tardy_jobs;
@@ -25,4 +29,81 @@ Stats edf_observe_tardiness(unsigned int num_procs,
                             unsigned long end_of_simulation,
                             bool preemptive = true);
 
+/* Monte-Carlo variant of edf_observe_tardiness(): simulates many randomized
+ * sporadic scenarios of the task set and collects per-task tardiness
+ * statistics and histograms.
+ *
+ * In each scenario, the first job of each task is released at a random
+ * offset in [0, max_offset], consecutive releases are separated by the
+ * period plus a random delay in [0, max_jitter], and each job executes for
+ * a random time in [min_cost_ratio * wcet, wcet] (uniformly distributed).
+ * By default, offsets and jitter are zero and jobs execute for their wcet,
+ * which makes every scenario the periodic one.
+ *
+ * Scenario i draws from its own random stream derived from the seed, so
+ * results do not depend on the number of threads.
+ */
+class EDFTardinessMonteCarlo
+{
+  private:
+    unsigned int num_procs;
+    TaskSet tasks;
+    unsigned long end_of_simulation;
+    bool preemptive;
+
+    unsigned long max_offset;
+    unsigned long max_jitter;
+    double min_cost_ratio;
+
+    unsigned long bucket_width;
+    unsigned int num_buckets;
+
+    unsigned int num_scenarios;
+    std::vector<Stats> task_stats;
+    // histogram[task * num_buckets + bucket]
+    std::vector<unsigned long> histogram;
+
+  public:
+    EDFTardinessMonteCarlo(unsigned int num_procs,
+                           const TaskSet &ts,
+                           unsigned long end_of_simulation,
+                           bool preemptive = true);
+
+    void set_max_offset(unsigned long offset) { max_offset = offset; }
+    void set_max_jitter(unsigned long jitter) { max_jitter = jitter; }
+    void set_min_cost_ratio(double ratio)     { min_cost_ratio = ratio; }
+
+    // Tardiness t of a job is counted in bucket t / width; the last
+    // bucket also counts all larger tardiness values. Jobs that meet
+    // their deadline fall into bucket 0.
+    void set_histogram(unsigned long width, unsigned int buckets)
+    {
+        bucket_width = width;
+        num_buckets  = buckets;
+    }
+
+    // num_threads == 0: one per hardware thread
+    void run(unsigned int num_scenarios, unsigned long seed = 0,
+             unsigned int num_threads = 0);
+
+    unsigned int get_scenario_count() const { return num_scenarios; }
+    unsigned int get_bucket_count() const { return num_buckets; }
+    unsigned long get_bucket_width() const { return bucket_width; }
+
+    // Summed over all scenarios; max_tardiness is the maximum and
+    // first_miss the earliest miss (zero if none) over all scenarios.
+    const Stats& get_task_stats(unsigned int task) const
+    {
+        return task_stats[task];
+    }
+
+    Stats get_stats() const;
+
+    unsigned long get_histogram_count(unsigned int task,
+                                      unsigned int bucket) const
+    {
+        return histogram[task * num_buckets + bucket];
+    }
+};
+
 #endif
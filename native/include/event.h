@@ -2,6 +2,10 @@
 #define EVENT_H
 
 #include <queue>
+#include <vector>
+#include <algorithm>
+#include <climits>
+#include <cassert>
 
 template <class time_t>
 class Event
@@ -44,4 +48,264 @@ class Timeout
 };
 
 
+/* Cancellable handle of an event in a RadixEventQueue. A handle becomes
+ * stale once its event is popped or cancelled.
+ */
+class EventHandle
+{
+  private:
+    unsigned int slot;
+    unsigned int generation;
+
+    template <class time_t> friend class RadixEventQueue;
+
+  public:
+    EventHandle() : slot(UINT_MAX), generation(0) {}
+};
+
+/* Monotone event queue (radix heap) for unsigned integral times.
+ *
+ * Times of new events must not precede the time of the last popped event,
+ * which holds for simulators that only schedule events in the future.
+ * Each event is kept in the bucket given by the highest bit in which its
+ * time differs from the last popped time, so that push() and cancel() take
+ * constant time and each event is moved to a lower bucket at most once per
+ * bit. Events with the same time are returned in FIFO (insertion) order.
+ */
+template <class time_t>
+class RadixEventQueue
+{
+  private:
+    enum { NUM_BUCKETS = sizeof(time_t) * CHAR_BIT + 1 };
+    static const unsigned int NONE = UINT_MAX;
+
+    struct Entry
+    {
+        time_t          fire_time;
+        Event<time_t>   *handler;
+        unsigned long long seq;
+        unsigned int    generation;
+        unsigned int    bucket;
+        unsigned int    pos;
+    };
+
+    std::vector<Entry> entries;
+    std::vector<unsigned int> free_slots;
+    std::vector<unsigned int> buckets[NUM_BUCKETS];
+    time_t last;
+    size_t count;
+    unsigned long long next_seq;
+
+    // Bucket 0 holds the events due at the last popped time in insertion
+    // order; the ones before head0 were popped already.
+    unsigned int head0;
+
+    // earliest event outside of bucket 0, if known
+    unsigned int min_slot;
+
+    unsigned int bucket_of(const time_t &when) const
+    {
+        if (when == last)
+            return 0;
+        else
+            // one plus the index of the highest differing bit
+            return sizeof(unsigned long long) * CHAR_BIT
+                - __builtin_clzll((unsigned long long) (when ^ last));
+    }
+
+    void place(unsigned int slot)
+    {
+        Entry &e = entries[slot];
+        e.bucket = bucket_of(e.fire_time);
+        e.pos    = buckets[e.bucket].size();
+        buckets[e.bucket].push_back(slot);
+    }
+
+    bool precedes(unsigned int a, unsigned int b) const
+    {
+        return entries[a].fire_time < entries[b].fire_time
+            || (entries[a].fire_time == entries[b].fire_time
+                && entries[a].seq < entries[b].seq);
+    }
+
+    struct SeqOrder
+    {
+        const std::vector<Entry> &entries;
+
+        SeqOrder(const std::vector<Entry> &e) : entries(e) {}
+
+        bool operator()(unsigned int a, unsigned int b) const
+        {
+            return entries[a].seq < entries[b].seq;
+        }
+    };
+
+    void remove(unsigned int slot)
+    {
+        Entry &e = entries[slot];
+        std::vector<unsigned int> &bucket = buckets[e.bucket];
+        if (e.bucket == 0)
+        {
+            // keep the insertion order
+            if (e.pos == head0)
+                head0++;
+            else
+            {
+                bucket.erase(bucket.begin() + e.pos);
+                for (unsigned int i = e.pos; i < bucket.size(); i++)
+                    entries[bucket[i]].pos = i;
+            }
+            if (head0 == bucket.size())
+            {
+                bucket.clear();
+                head0 = 0;
+            }
+        }
+        else
+        {
+            unsigned int moved = bucket.back();
+            bucket[e.pos] = moved;
+            entries[moved].pos = e.pos;
+            bucket.pop_back();
+        }
+
+        if (slot == min_slot)
+            min_slot = NONE;
+        e.generation++;
+        free_slots.push_back(slot);
+        count--;
+    }
+
+    unsigned int top_slot()
+    {
+        if (!buckets[0].empty())
+            return buckets[0][head0];
+
+        if (min_slot == NONE)
+        {
+            unsigned int b = 1;
+            while (buckets[b].empty())
+                b++;
+
+            min_slot = buckets[b][0];
+            for (unsigned int i = 1; i < buckets[b].size(); i++)
+                if (precedes(buckets[b][i], min_slot))
+                    min_slot = buckets[b][i];
+        }
+        return min_slot;
+    }
+
+  public:
+    RadixEventQueue()
+        : last(0), count(0), next_seq(0), head0(0), min_slot(NONE) {}
+
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+
+    EventHandle push(const time_t &when, Event<time_t> *what)
+    {
+        assert(when >= last);
+
+        unsigned int slot;
+        if (free_slots.empty())
+        {
+            slot = entries.size();
+            entries.push_back(Entry());
+            entries[slot].generation = 0;
+        }
+        else
+        {
+            slot = free_slots.back();
+            free_slots.pop_back();
+        }
+
+        entries[slot].fire_time = when;
+        entries[slot].handler   = what;
+        entries[slot].seq       = next_seq++;
+        place(slot);
+        count++;
+
+        if (min_slot != NONE && entries[slot].bucket
+            && when < entries[min_slot].fire_time)
+            min_slot = slot;
+
+        EventHandle h;
+        h.slot = slot;
+        h.generation = entries[slot].generation;
+        return h;
+    }
+
+    void push(const Timeout<time_t> &timeout)
+    {
+        push(timeout.time(), &timeout.event());
+    }
+
+    // Returns false if the event already fired or was cancelled.
+    bool cancel(const EventHandle &h)
+    {
+        if (h.slot >= entries.size()
+            || entries[h.slot].generation != h.generation)
+            return false;
+
+        remove(h.slot);
+        return true;
+    }
+
+    Timeout<time_t> top()
+    {
+        const Entry &e = entries[top_slot()];
+        return Timeout<time_t>(e.fire_time, e.handler);
+    }
+
+    void pop()
+    {
+        unsigned int slot = top_slot();
+        unsigned int b = entries[slot].bucket;
+
+        if (b)
+            last = entries[slot].fire_time;
+        remove(slot);
+
+        if (b)
+        {
+            // Relative to the new last time, the remaining events of
+            // bucket b belong to lower buckets. All other buckets below b
+            // are empty and those above b are unaffected.
+            std::vector<unsigned int> moving;
+            moving.swap(buckets[b]);
+            for (unsigned int i = 0; i < moving.size(); i++)
+                place(moving[i]);
+            // reuse the storage
+            moving.clear();
+            moving.swap(buckets[b]);
+            min_slot = NONE;
+
+            // Bucket 0 was empty; restore the insertion order of the
+            // events that are now due.
+            std::vector<unsigned int> &due = buckets[0];
+            std::sort(due.begin(), due.end(), SeqOrder(entries));
+            for (unsigned int i = 0; i < due.size(); i++)
+                entries[due[i]].pos = i;
+        }
+    }
+
+    void clear()
+    {
+        for (unsigned int b = 0; b < NUM_BUCKETS; b++)
+            buckets[b].clear();
+        // invalidate all outstanding handles
+        free_slots.clear();
+        for (unsigned int i = 0; i < entries.size(); i++)
+        {
+            entries[i].generation++;
+            free_slots.push_back(i);
+        }
+        last     = 0;
+        count    = 0;
+        next_seq = 0;
+        head0    = 0;
+        min_slot = NONE;
+    }
+};
+
 #endif
@@ -0,0 +1,866 @@
+#ifndef HYBRID_NUM_H
+#define HYBRID_NUM_H
+
+/* Exact integers and rationals that live in machine words for as long as
+ * all values fit into 64 bits, and that transparently fall back to GMP
+ * once an operation would overflow. Results are always normalized back
+ * into machine words if possible, so a single huge intermediate value does
+ * not slow down the rest of a computation.
+ *
+ * Intermediate results of the fast paths are computed with 128-bit
+ * arithmetic; any overflow is detected and handled by redoing the operation
+ * with mpz_class/mpq_class.
+ */
+
+#include <limits.h>
+#include <math.h>
+
+#include <iostream>
+#include <utility>
+
+/* include string.h for gmpxx.h */
+#include <string.h>
+#include <gmpxx.h>
+
+#define HYBRID_LIKELY(x)   __builtin_expect(!!(x), 1)
+#define HYBRID_UNLIKELY(x) __builtin_expect(!!(x), 0)
+
+typedef __int128 hybrid_wide_t;
+typedef unsigned __int128 hybrid_uwide_t;
+
+static inline unsigned long hybrid_abs(long x)
+{
+	/* well-defined even for LONG_MIN */
+	return x < 0 ? -(unsigned long) x : (unsigned long) x;
+}
+
+static inline hybrid_uwide_t hybrid_abs(hybrid_wide_t x)
+{
+	return x < 0 ? -(hybrid_uwide_t) x : (hybrid_uwide_t) x;
+}
+
+static inline bool hybrid_fits_long(hybrid_wide_t x)
+{
+	return x >= LONG_MIN && x <= LONG_MAX;
+}
+
+// binary GCD; gcd(0, b) = b
+static inline unsigned long hybrid_gcd(unsigned long a, unsigned long b)
+{
+	if (!a)
+		return b;
+	if (!b)
+		return a;
+
+	int shift = __builtin_ctzl(a | b);
+	a >>= __builtin_ctzl(a);
+	do {
+		b >>= __builtin_ctzl(b);
+		if (a > b)
+			std::swap(a, b);
+		b -= a;
+	} while (b);
+
+	return a << shift;
+}
+
+static inline void hybrid_set_mpz(mpz_class &z, hybrid_wide_t x)
+{
+	hybrid_uwide_t mag = hybrid_abs(x);
+	unsigned long limbs[2];
+
+	limbs[0] = (unsigned long) mag;
+	limbs[1] = (unsigned long) (mag >> 64);
+	mpz_import(z.get_mpz_t(), 2, -1, sizeof(unsigned long), 0, 0, limbs);
+	if (x < 0)
+		mpz_neg(z.get_mpz_t(), z.get_mpz_t());
+}
+
+class HybridFraction;
+
+class HybridInteger
+{
+  private:
+	// valid iff big == NULL
+	long small;
+	// non-NULL iff the value does not fit into a long
+	mpz_class *big;
+
+	void set_small(long val)
+	{
+		if (HYBRID_UNLIKELY(big != NULL))
+		{
+			delete big;
+			big = NULL;
+		}
+		small = val;
+	}
+
+	// store result of a slow-path operation, demoting if possible
+	void set_big(const mpz_class &val)
+	{
+		if (mpz_fits_slong_p(val.get_mpz_t()))
+			set_small(mpz_get_si(val.get_mpz_t()));
+		else if (big)
+			*big = val;
+		else
+			big = new mpz_class(val);
+	}
+
+	void set_ulong(unsigned long val)
+	{
+		if (HYBRID_LIKELY(val <= LONG_MAX))
+			set_small((long) val);
+		else
+			set_big(mpz_class(val));
+	}
+
+	void set_double(double val);
+	void set_wide(hybrid_wide_t val);
+
+	// slow paths
+	void add_big(const HybridInteger &other);
+	void sub_big(const HybridInteger &other);
+	void mul_big(const HybridInteger &other);
+	void div_big(const HybridInteger &other);
+	void mod_big(const HybridInteger &other);
+
+	friend class HybridFraction;
+
+  public:
+	HybridInteger() : small(0), big(NULL) {}
+	HybridInteger(int val) : small(val), big(NULL) {}
+	HybridInteger(long val) : small(val), big(NULL) {}
+	HybridInteger(unsigned int val) : small(val), big(NULL) {}
+	HybridInteger(unsigned long val) : small(0), big(NULL)
+	{
+		set_ulong(val);
+	}
+	HybridInteger(double val) : small(0), big(NULL)
+	{
+		set_double(val);
+	}
+	HybridInteger(const char *str) : small(0), big(NULL)
+	{
+		set_big(mpz_class(str));
+	}
+	HybridInteger(const mpz_class &val) : small(0), big(NULL)
+	{
+		set_big(val);
+	}
+
+	// truncates towards zero, like mpz_class
+	explicit HybridInteger(const HybridFraction &val);
+
+	HybridInteger(const HybridInteger &other)
+		: small(other.small),
+		  big(other.big ? new mpz_class(*other.big) : NULL)
+	{}
+
+	HybridInteger(HybridInteger &&other)
+		: small(other.small), big(other.big)
+	{
+		other.big = NULL;
+	}
+
+	~HybridInteger()
+	{
+		delete big;
+	}
+
+	HybridInteger& operator=(const HybridInteger &other)
+	{
+		if (HYBRID_LIKELY(!other.big))
+			set_small(other.small);
+		else if (this != &other)
+			set_big(*other.big);
+		return *this;
+	}
+
+	HybridInteger& operator=(HybridInteger &&other)
+	{
+		std::swap(small, other.small);
+		std::swap(big, other.big);
+		return *this;
+	}
+
+	HybridInteger& operator=(int val)           { set_small(val); return *this; }
+	HybridInteger& operator=(long val)          { set_small(val); return *this; }
+	HybridInteger& operator=(unsigned int val)  { set_small(val); return *this; }
+	HybridInteger& operator=(unsigned long val) { set_ulong(val); return *this; }
+	HybridInteger& operator=(const char *str)
+	{
+		set_big(mpz_class(str));
+		return *this;
+	}
+
+	// truncates towards zero, like mpz_class
+	HybridInteger& operator=(const HybridFraction &val);
+
+	bool is_small() const { return big == NULL; }
+
+	HybridInteger& operator+=(const HybridInteger &other)
+	{
+		long res;
+		if (HYBRID_LIKELY(!big && !other.big)
+		    && !__builtin_add_overflow(small, other.small, &res))
+			small = res;
+		else
+			add_big(other);
+		return *this;
+	}
+
+	HybridInteger& operator-=(const HybridInteger &other)
+	{
+		long res;
+		if (HYBRID_LIKELY(!big && !other.big)
+		    && !__builtin_sub_overflow(small, other.small, &res))
+			small = res;
+		else
+			sub_big(other);
+		return *this;
+	}
+
+	HybridInteger& operator*=(const HybridInteger &other)
+	{
+		long res;
+		if (HYBRID_LIKELY(!big && !other.big)
+		    && !__builtin_mul_overflow(small, other.small, &res))
+			small = res;
+		else
+			mul_big(other);
+		return *this;
+	}
+
+	// truncating division, like mpz_class
+	HybridInteger& operator/=(const HybridInteger &other)
+	{
+		// division by zero and LONG_MIN / -1 are left to GMP
+		if (HYBRID_LIKELY(!big && !other.big && other.small > 0))
+			small /= other.small;
+		else if (!big && !other.big && other.small < -1)
+			small /= other.small;
+		else
+			div_big(other);
+		return *this;
+	}
+
+	// remainder has the sign of the dividend, like mpz_class
+	HybridInteger& operator%=(const HybridInteger &other)
+	{
+		if (HYBRID_LIKELY(!big && !other.big && other.small > 0))
+			small %= other.small;
+		else if (!big && !other.big && other.small < -1)
+			small %= other.small;
+		else
+			mod_big(other);
+		return *this;
+	}
+
+	HybridInteger operator-() const
+	{
+		if (HYBRID_LIKELY(!big && small != LONG_MIN))
+			return HybridInteger(-small);
+		else
+			return HybridInteger(mpz_class(-get_mpz()));
+	}
+
+	int sgn() const
+	{
+		if (HYBRID_LIKELY(!big))
+			return (small > 0) - (small < 0);
+		else
+			return mpz_sgn(big->get_mpz_t());
+	}
+
+	friend int cmp(const HybridInteger &a, const HybridInteger &b)
+	{
+		if (HYBRID_LIKELY(!a.big && !b.big))
+			return (a.small > b.small) - (a.small < b.small);
+		else
+			return ::cmp(a.get_mpz(), b.get_mpz());
+	}
+
+	// division rounding towards positive infinity, like mpz_cdiv_q()
+	friend HybridInteger ceil_div(const HybridInteger &n,
+	                              const HybridInteger &d)
+	{
+		if (HYBRID_LIKELY(!n.big && !d.big && d.small > 0))
+		{
+			long q = n.small / d.small;
+			if (n.small % d.small > 0)
+				q++;
+			return HybridInteger(q);
+		}
+		else
+		{
+			mpz_class q;
+			mpz_cdiv_q(q.get_mpz_t(),
+			           n.get_mpz().get_mpz_t(), d.get_mpz().get_mpz_t());
+			return HybridInteger(q);
+		}
+	}
+
+	bool fits_ulong_p() const
+	{
+		if (HYBRID_LIKELY(!big))
+			return small >= 0;
+		else
+			return mpz_fits_ulong_p(big->get_mpz_t());
+	}
+
+	bool fits_slong_p() const
+	{
+		// demotion invariant: big values never fit
+		return !big;
+	}
+
+	// like mpz_get_ui(): least-significant bits of the absolute value
+	unsigned long get_ui() const
+	{
+		if (HYBRID_LIKELY(!big))
+			return hybrid_abs(small);
+		else
+			return big->get_ui();
+	}
+
+	long get_si() const
+	{
+		if (HYBRID_LIKELY(!big))
+			return small;
+		else
+			return big->get_si();
+	}
+
+	// truncates like mpz_get_d()
+	double get_d() const
+	{
+		if (HYBRID_LIKELY(!big && hybrid_abs(small) <= (1ul << 53)))
+			return (double) small;
+		else
+			return get_mpz().get_d();
+	}
+
+	mpz_class get_mpz() const
+	{
+		if (big)
+			return *big;
+		else
+			return mpz_class(small);
+	}
+
+	friend std::ostream& operator<<(std::ostream &os,
+	                                const HybridInteger &val)
+	{
+		if (val.big)
+			return os << *val.big;
+		else
+			return os << val.small;
+	}
+};
+
+class HybridFraction
+{
+  private:
+	// Canonical form: den > 0 and gcd(|num|, den) == 1.
+	// valid iff big == NULL
+	long num;
+	long den;
+	// non-NULL iff numerator or denominator does not fit into a long
+	mpq_class *big;
+
+	void set_small(long n, long d)
+	{
+		if (HYBRID_UNLIKELY(big != NULL))
+		{
+			delete big;
+			big = NULL;
+		}
+		num = n;
+		den = d;
+	}
+
+	// store result of a slow-path operation, demoting if possible
+	void set_big(const mpq_class &val)
+	{
+		if (mpz_fits_slong_p(mpq_numref(val.get_mpq_t()))
+		    && mpz_fits_slong_p(mpq_denref(val.get_mpq_t())))
+			set_small(mpz_get_si(mpq_numref(val.get_mpq_t())),
+			          mpz_get_si(mpq_denref(val.get_mpq_t())));
+		else if (big)
+			*big = val;
+		else
+			big = new mpq_class(val);
+	}
+
+	// store an already reduced fraction, if it fits
+	bool try_set_wide(hybrid_wide_t n, hybrid_wide_t d)
+	{
+		if (HYBRID_LIKELY(hybrid_fits_long(n) && hybrid_fits_long(d)))
+		{
+			set_small((long) n, (long) d);
+			return true;
+		}
+		else
+			return false;
+	}
+
+	void set_integer(const HybridInteger &val)
+	{
+		if (HYBRID_LIKELY(!val.big))
+			set_small(val.small, 1);
+		else
+			set_big(mpq_class(*val.big));
+	}
+
+	void set_double(double val);
+	void set_ratio(const HybridInteger &n, const HybridInteger &d);
+
+	bool add_small(long c, long d);
+	bool mul_small(long c, long d);
+
+	// slow paths
+	void add_big(const HybridFraction &other);
+	void sub_big(const HybridFraction &other);
+	void mul_big(const HybridFraction &other);
+	void div_big(const HybridFraction &other);
+
+	friend class HybridInteger;
+
+  public:
+	HybridFraction() : num(0), den(1), big(NULL) {}
+	HybridFraction(int val) : num(val), den(1), big(NULL) {}
+	HybridFraction(long val) : num(val), den(1), big(NULL) {}
+	HybridFraction(unsigned int val) : num(val), den(1), big(NULL) {}
+	HybridFraction(unsigned long val) : num(0), den(1), big(NULL)
+	{
+		set_integer(HybridInteger(val));
+	}
+	HybridFraction(const HybridInteger &val) : num(0), den(1), big(NULL)
+	{
+		set_integer(val);
+	}
+	HybridFraction(double val) : num(0), den(1), big(NULL)
+	{
+		set_double(val);
+	}
+	HybridFraction(const HybridInteger &n, const HybridInteger &d)
+		: num(0), den(1), big(NULL)
+	{
+		set_ratio(n, d);
+	}
+	HybridFraction(const mpq_class &val) : num(0), den(1), big(NULL)
+	{
+		set_big(val);
+	}
+
+	HybridFraction(const HybridFraction &other)
+		: num(other.num), den(other.den),
+		  big(other.big ? new mpq_class(*other.big) : NULL)
+	{}
+
+	HybridFraction(HybridFraction &&other)
+		: num(other.num), den(other.den), big(other.big)
+	{
+		other.big = NULL;
+	}
+
+	~HybridFraction()
+	{
+		delete big;
+	}
+
+	HybridFraction& operator=(const HybridFraction &other)
+	{
+		if (HYBRID_LIKELY(!other.big))
+			set_small(other.num, other.den);
+		else if (this != &other)
+			set_big(*other.big);
+		return *this;
+	}
+
+	HybridFraction& operator=(HybridFraction &&other)
+	{
+		std::swap(num, other.num);
+		std::swap(den, other.den);
+		std::swap(big, other.big);
+		return *this;
+	}
+
+	HybridFraction& operator=(const HybridInteger &val)
+	{
+		set_integer(val);
+		return *this;
+	}
+
+	HybridFraction& operator=(int val)  { set_small(val, 1); return *this; }
+	HybridFraction& operator=(long val) { set_small(val, 1); return *this; }
+	HybridFraction& operator=(unsigned int val)
+	{
+		set_small(val, 1);
+		return *this;
+	}
+	HybridFraction& operator=(unsigned long val)
+	{
+		set_integer(HybridInteger(val));
+		return *this;
+	}
+
+	bool is_small() const { return big == NULL; }
+
+	HybridFraction& operator+=(const HybridFraction &other)
+	{
+		if (!(HYBRID_LIKELY(!big && !other.big)
+		      && add_small(other.num, other.den)))
+			add_big(other);
+		return *this;
+	}
+
+	HybridFraction& operator-=(const HybridFraction &other)
+	{
+		if (!(HYBRID_LIKELY(!big && !other.big && other.num != LONG_MIN)
+		      && add_small(-other.num, other.den)))
+			sub_big(other);
+		return *this;
+	}
+
+	HybridFraction& operator*=(const HybridFraction &other)
+	{
+		if (!(HYBRID_LIKELY(!big && !other.big)
+		      && mul_small(other.num, other.den)))
+			mul_big(other);
+		return *this;
+	}
+
+	HybridFraction& operator/=(const HybridFraction &other)
+	{
+		// multiply with reciprocal; division by zero is left to GMP
+		if (!(HYBRID_LIKELY(!big && !other.big
+		                    && other.num != 0 && other.num != LONG_MIN)
+		      && mul_small(other.num < 0 ? -other.den : other.den,
+		                   other.num < 0 ? -other.num : other.num)))
+			div_big(other);
+		return *this;
+	}
+
+	HybridFraction operator-() const
+	{
+		HybridFraction neg(*this);
+		if (HYBRID_LIKELY(!big && num != LONG_MIN))
+			neg.num = -num;
+		else
+			neg.set_big(mpq_class(-get_mpq()));
+		return neg;
+	}
+
+	int sgn() const
+	{
+		if (HYBRID_LIKELY(!big))
+			return (num > 0) - (num < 0);
+		else
+			return mpq_sgn(big->get_mpq_t());
+	}
+
+	friend int cmp(const HybridFraction &a, const HybridFraction &b)
+	{
+		if (HYBRID_LIKELY(!a.big && !b.big))
+		{
+			if (a.den == b.den)
+				return (a.num > b.num) - (a.num < b.num);
+
+			hybrid_wide_t l = (hybrid_wide_t) a.num * b.den;
+			hybrid_wide_t r = (hybrid_wide_t) b.num * a.den;
+			return (l > r) - (l < r);
+		}
+		else
+			return ::cmp(a.get_mpq(), b.get_mpq());
+	}
+
+	HybridInteger get_num() const
+	{
+		if (HYBRID_LIKELY(!big))
+			return HybridInteger(num);
+		else
+			return HybridInteger(mpz_class(big->get_num()));
+	}
+
+	HybridInteger get_den() const
+	{
+		if (HYBRID_LIKELY(!big))
+			return HybridInteger(den);
+		else
+			return HybridInteger(mpz_class(big->get_den()));
+	}
+
+	// truncates like mpq_get_d()
+	double get_d() const
+	{
+		if (HYBRID_LIKELY(!big && hybrid_abs(num) <= (1ul << 53)
+		                  && den <= (1l << 53)))
+		{
+			// num and den are exact, so the quotient is correctly
+			// rounded and fma() yields the sign of the rounding error
+			double q = (double) num / (double) den;
+			double err = fma(q, (double) den, -(double) num);
+			if ((num > 0 && err > 0) || (num < 0 && err < 0))
+				q = nextafter(q, 0.0);
+			return q;
+		}
+		else
+			return get_mpq().get_d();
+	}
+
+	mpq_class get_mpq() const
+	{
+		if (big)
+			return *big;
+		else
+		{
+			mpq_class q;
+			mpq_set_si(q.get_mpq_t(), num, den);
+			return q;
+		}
+	}
+
+	// truncate towards zero
+	HybridInteger truncate() const
+	{
+		if (HYBRID_LIKELY(!big))
+			return HybridInteger(num / den);
+		else
+			return HybridInteger(mpz_class(*big));
+	}
+
+	// round towards positive infinity
+	HybridInteger ceil() const
+	{
+		if (HYBRID_LIKELY(!big))
+		{
+			long q = num / den;
+			if (num % den > 0)
+				q++;
+			return HybridInteger(q);
+		}
+		else
+		{
+			mpz_class q;
+			mpz_cdiv_q(q.get_mpz_t(),
+			           mpq_numref(big->get_mpq_t()),
+			           mpq_denref(big->get_mpq_t()));
+			return HybridInteger(q);
+		}
+	}
+
+	friend std::ostream& operator<<(std::ostream &os,
+	                                const HybridFraction &val)
+	{
+		if (val.big)
+			return os << *val.big;
+		os << val.num;
+		if (val.den != 1)
+			os << "/" << val.den;
+		return os;
+	}
+};
+
+/* ---------- HybridInteger out-of-line parts ---------- */
+
+inline HybridInteger::HybridInteger(const HybridFraction &val)
+	: small(0), big(NULL)
+{
+	*this = val.truncate();
+}
+
+inline HybridInteger& HybridInteger::operator=(const HybridFraction &val)
+{
+	return *this = val.truncate();
+}
+
+inline void HybridInteger::set_double(double val)
+{
+	// LONG_MAX is not exactly representable; stay clear of the boundary
+	if (val > -9.2e18 && val < 9.2e18)
+		set_small((long) val);
+	else
+		set_big(mpz_class(val));
+}
+
+inline void HybridInteger::set_wide(hybrid_wide_t val)
+{
+	if (hybrid_fits_long(val))
+		set_small((long) val);
+	else
+	{
+		mpz_class z;
+		hybrid_set_mpz(z, val);
+		set_big(z);
+	}
+}
+
+inline void HybridInteger::add_big(const HybridInteger &other)
+{
+	if (!big && !other.big)
+		set_wide((hybrid_wide_t) small + other.small);
+	else
+		set_big(get_mpz() + other.get_mpz());
+}
+
+inline void HybridInteger::sub_big(const HybridInteger &other)
+{
+	if (!big && !other.big)
+		set_wide((hybrid_wide_t) small - other.small);
+	else
+		set_big(get_mpz() - other.get_mpz());
+}
+
+inline void HybridInteger::mul_big(const HybridInteger &other)
+{
+	if (!big && !other.big)
+		set_wide((hybrid_wide_t) small * other.small);
+	else
+		set_big(get_mpz() * other.get_mpz());
+}
+
+inline void HybridInteger::div_big(const HybridInteger &other)
+{
+	set_big(get_mpz() / other.get_mpz());
+}
+
+inline void HybridInteger::mod_big(const HybridInteger &other)
+{
+	set_big(get_mpz() % other.get_mpz());
+}
+
+/* ---------- HybridFraction out-of-line parts ---------- */
+
+inline void HybridFraction::set_double(double val)
+{
+	if (val > -9.2e18 && val < 9.2e18 && val == (long) val)
+		set_small((long) val, 1);
+	else
+		set_big(mpq_class(val));
+}
+
+inline void HybridFraction::set_ratio(const HybridInteger &n,
+                                      const HybridInteger &d)
+{
+	if (!n.big && !d.big && d.small != 0
+	    && n.small != LONG_MIN && d.small != LONG_MIN)
+	{
+		long sign = d.small < 0 ? -1 : 1;
+		unsigned long g = hybrid_gcd(hybrid_abs(n.small),
+		                             hybrid_abs(d.small));
+		set_small(sign * (n.small / (long) g),
+		          sign * (d.small / (long) g));
+	}
+	else
+	{
+		mpq_class q(n.get_mpz(), d.get_mpz());
+		q.canonicalize();
+		set_big(q);
+	}
+}
+
+// *this += c/d, assuming both operands are small and canonical.
+// Leaves *this untouched and returns false on overflow.
+inline bool HybridFraction::add_small(long c, long d)
+{
+	if (den == d)
+	{
+		long sum;
+		if (__builtin_add_overflow(num, c, &sum))
+			return false;
+		if (d == 1)
+			num = sum;
+		else
+		{
+			long g = (long) hybrid_gcd(hybrid_abs(sum), d);
+			num = sum / g;
+			den = d / g;
+		}
+		return true;
+	}
+
+	// Knuth, TAOCP Vol. 2, Sec. 4.5.1
+	unsigned long g = hybrid_gcd(den, d);
+	if (g == 1)
+		return try_set_wide((hybrid_wide_t) num * d + (hybrid_wide_t) c * den,
+		                    (hybrid_wide_t) den * d);
+	else
+	{
+		long b1 = den / (long) g;
+		long d1 = d / (long) g;
+		hybrid_wide_t t = (hybrid_wide_t) num * d1 + (hybrid_wide_t) c * b1;
+		unsigned long g2 = hybrid_gcd((unsigned long) (hybrid_abs(t) % g), g);
+		return try_set_wide(t / (hybrid_wide_t) g2,
+		                    (hybrid_wide_t) b1 * (d / (long) g2));
+	}
+}
+
+// *this *= c/d, assuming both operands are small, d > 0, and gcd(c, d) == 1.
+// Leaves *this untouched and returns false on overflow.
+inline bool HybridFraction::mul_small(long c, long d)
+{
+	if (num == 0 || c == 0)
+	{
+		set_small(0, 1);
+		return true;
+	}
+
+	long g1 = (long) hybrid_gcd(hybrid_abs(num), d);
+	long g2 = (long) hybrid_gcd(hybrid_abs(c), den);
+	return try_set_wide((hybrid_wide_t) (num / g1) * (c / g2),
+	                    (hybrid_wide_t) (den / g2) * (d / g1));
+}
+
+inline void HybridFraction::add_big(const HybridFraction &other)
+{
+	set_big(get_mpq() + other.get_mpq());
+}
+
+inline void HybridFraction::sub_big(const HybridFraction &other)
+{
+	set_big(get_mpq() - other.get_mpq());
+}
+
+inline void HybridFraction::mul_big(const HybridFraction &other)
+{
+	set_big(get_mpq() * other.get_mpq());
+}
+
+inline void HybridFraction::div_big(const HybridFraction &other)
+{
+	set_big(get_mpq() / other.get_mpq());
+}
+
+/* ---------- operators ---------- */
+
+#define HYBRID_BINARY_OPS(T)                                          \
+	static inline T operator+(T a, const T &b) { return a += b; }     \
+	static inline T operator-(T a, const T &b) { return a -= b; }     \
+	static inline T operator*(T a, const T &b) { return a *= b; }     \
+	static inline T operator/(T a, const T &b) { return a /= b; }     \
+	static inline bool operator==(const T &a, const T &b)             \
+	{ return cmp(a, b) == 0; }                                        \
+	static inline bool operator!=(const T &a, const T &b)             \
+	{ return cmp(a, b) != 0; }                                        \
+	static inline bool operator<(const T &a, const T &b)              \
+	{ return cmp(a, b) < 0; }                                         \
+	static inline bool operator<=(const T &a, const T &b)             \
+	{ return cmp(a, b) <= 0; }                                        \
+	static inline bool operator>(const T &a, const T &b)              \
+	{ return cmp(a, b) > 0; }                                         \
+	static inline bool operator>=(const T &a, const T &b)             \
+	{ return cmp(a, b) >= 0; }
+
+HYBRID_BINARY_OPS(HybridInteger)
+HYBRID_BINARY_OPS(HybridFraction)
+
+#undef HYBRID_BINARY_OPS
+
+static inline HybridInteger operator%(HybridInteger a, const HybridInteger &b)
+{
+	return a %= b;
+}
+
+#endif
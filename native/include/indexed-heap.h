@@ -0,0 +1,83 @@
+#ifndef INDEXED_HEAP_H
+#define INDEXED_HEAP_H
+
+#include <vector>
+
+/* Binary heap over the fixed set of items 0 ... n-1, for keys that are
+ * stored elsewhere and change over time. After the key of an item
+ * changes, update(item) restores the heap order in O(log n).
+ *
+ * before(a, b) must return true iff item a is to be ordered before item b;
+ * the item ordered first is at the top.
+ */
+template <typename Order>
+class IndexedHeap
+{
+  private:
+    std::vector<unsigned int> heap; // items in heap order
+    std::vector<unsigned int> pos;  // position of each item in heap
+    Order before;
+
+    void swap_at(unsigned int i, unsigned int j)
+    {
+        unsigned int a = heap[i], b = heap[j];
+        heap[i] = b;
+        heap[j] = a;
+        pos[b] = i;
+        pos[a] = j;
+    }
+
+    void sift_up(unsigned int i)
+    {
+        while (i > 0)
+        {
+            unsigned int parent = (i - 1) / 2;
+            if (!before(heap[i], heap[parent]))
+                break;
+            swap_at(i, parent);
+            i = parent;
+        }
+    }
+
+    void sift_down(unsigned int i)
+    {
+        for (;;)
+        {
+            unsigned int first = i;
+            unsigned int left  = 2 * i + 1;
+            unsigned int right = left + 1;
+
+            if (left < heap.size() && before(heap[left], heap[first]))
+                first = left;
+            if (right < heap.size() && before(heap[right], heap[first]))
+                first = right;
+            if (first == i)
+                break;
+            swap_at(i, first);
+            i = first;
+        }
+    }
+
+  public:
+    IndexedHeap(unsigned int num_items, const Order &order)
+        : heap(num_items), pos(num_items), before(order)
+    {
+        for (unsigned int i = 0; i < num_items; i++)
+            heap[i] = pos[i] = i;
+        for (unsigned int i = num_items / 2; i > 0; i--)
+            sift_down(i - 1);
+    }
+
+    unsigned int top() const
+    {
+        return heap[0];
+    }
+
+    void update(unsigned int item)
+    {
+        sift_up(pos[item]);
+        sift_down(pos[item]);
+    }
+};
+
+#endif
@@ -4,6 +4,7 @@
 #include "linprog/model.h"
 
 class Solution;
+class LinearProgramSession;
 
 // solve with CPLEX connected via the "Concert Technology" API
 Solution *cplex_solve(const LinearProgram& lp, unsigned int max_num_vars);
@@ -11,6 +12,9 @@ Solution *cplex_solve(const LinearProgram& lp, unsigned int max_num_vars);
 // solve with CPLEX connected via the plain, old C API
 Solution *cpx_solve(const LinearProgram& lp, unsigned int max_num_vars);
 
+// solver session (see linprog/solver.h) based on the plain C API
+LinearProgramSession *cpx_session();
+
 #include "linprog/solver.h"
 
 #endif
@@ -0,0 +1,37 @@
+#ifndef LINPROG_DENSE_H
+#define LINPROG_DENSE_H
+
+#include "linprog/model.h"
+
+class Solution;
+
+/* Built-in solver for very small programs: a two-phase simplex on a dense
+ * tableau and, for programs with integer or binary variables, a depth-first
+ * branch-and-bound on top of it. It does not need any setup beyond a few
+ * small arrays and is therefore much cheaper than an external solver for
+ * LPs with a handful of variables.
+ *
+ * Variables are bounded by [var_lb, var_ub] unless declared otherwise (as
+ * in glpk_solve()). Returns NULL if the program is infeasible, unbounded, or
+ * too difficult (numerically or due to too many branch-and-bound nodes); the
+ * caller should then fall back to a full solver.
+ */
+Solution *dense_solve(const LinearProgram& lp, unsigned int max_num_vars,
+		      double var_lb = 0.0, double var_ub = 1.0);
+
+/* Programs with at most this many variables and at most this many
+ * constraints are first given to dense_solve() by linprog_solve(). Zero (the
+ * default) disables the built-in solver. Also exported in lp_analysis.h.
+ */
+void set_lp_dense_limit(unsigned int max_size);
+unsigned int get_lp_dense_limit();
+
+static inline bool is_dense_lp_candidate(const LinearProgram& lp,
+					 unsigned int max_num_vars)
+{
+	const unsigned int limit = get_lp_dense_limit();
+	return max_num_vars <= limit
+		&& lp.get_equalities().size() + lp.get_inequalities().size() <= limit;
+}
+
+#endif
@@ -4,9 +4,15 @@
 #include "linprog/model.h"
 
 class Solution;
+class LinearProgramSession;
 
 Solution *glpk_solve(const LinearProgram& lp, unsigned int max_num_vars);
 
+LinearProgramSession *glpk_session();
+
+// free the calling thread's GLPK environment
+void glpk_thread_exit();
+
 #include "linprog/solver.h"
 
 #endif
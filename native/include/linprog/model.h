@@ -3,7 +3,6 @@
 
 #include <vector>
 #include <utility>
-#include <set>
 
 #include <sstream>
 
@@ -79,10 +78,113 @@ struct VariableRange {
 #endif
 
 
-typedef std::pair<LinearExpression *, double> Constraint;
-typedef std::vector<Constraint> Constraints;
 typedef std::vector<VariableRange> VariableRanges;
 
+/* A set of constraints in compressed sparse row (CSR) format. The terms of
+ * all rows are stored back to back in a single array; row r consists of
+ * the terms at positions get_row_start(r) ... get_row_start(r+1)-1 and is
+ * bounded by get_bound(r). Rows are appended either by copying a
+ * LinearExpression (add_row()) or term by term (add_term() followed by
+ * finish_row()), in which case no temporary objects are allocated.
+ */
+class ConstraintMatrix
+{
+	Terms terms;
+	std::vector<unsigned int> row_start;
+	std::vector<double> bounds;
+
+public:
+	ConstraintMatrix() : row_start(1, 0) {}
+
+	// add a term to the row under construction
+	void add_term(double coefficient, unsigned int variable_index)
+	{
+		terms.push_back(Term(coefficient, variable_index));
+	}
+
+	// Complete the row under construction. Returns false (and adds
+	// no row) if no terms were added.
+	bool finish_row(double bound)
+	{
+		if (terms.size() == row_start.back())
+			return false;
+		row_start.push_back(terms.size());
+		bounds.push_back(bound);
+		return true;
+	}
+
+	// drop the terms of the row under construction
+	void discard_row()
+	{
+		terms.resize(row_start.back());
+	}
+
+	bool add_row(const LinearExpression &exp, double bound)
+	{
+		const Terms &t = exp.get_terms();
+		terms.insert(terms.end(), t.begin(), t.end());
+		return finish_row(bound);
+	}
+
+	void reserve(unsigned int num_rows, unsigned int num_terms)
+	{
+		row_start.reserve(num_rows + 1);
+		bounds.reserve(num_rows);
+		terms.reserve(num_terms);
+	}
+
+	unsigned int size() const
+	{
+		return bounds.size();
+	}
+
+	bool empty() const
+	{
+		return bounds.empty();
+	}
+
+	// total number of terms in all (finished) rows
+	unsigned int get_num_terms() const
+	{
+		return row_start.back();
+	}
+
+	unsigned int get_row_start(unsigned int row) const
+	{
+		return row_start[row];
+	}
+
+	unsigned int get_row_size(unsigned int row) const
+	{
+		return row_start[row + 1] - row_start[row];
+	}
+
+	const Term *row_begin(unsigned int row) const
+	{
+		return &terms[0] + row_start[row];
+	}
+
+	const Term *row_end(unsigned int row) const
+	{
+		return &terms[0] + row_start[row + 1];
+	}
+
+	double get_bound(unsigned int row) const
+	{
+		return bounds[row];
+	}
+
+	const Terms& get_terms() const
+	{
+		return terms;
+	}
+
+	const std::vector<double>& get_bounds() const
+	{
+		return bounds;
+	}
+};
+
 // builds a maximization problem piece-wise
 class LinearProgram
 {
@@ -90,41 +192,59 @@ class LinearProgram
 	LinearExpression *objective;
 
 	// linear expressions constrained to an exact value
-	Constraints equalities;
+	ConstraintMatrix equalities;
 
 	// linear expressions constrained by an upper bound (exp <= bound)
-	Constraints inequalities;
-
-	// set of integer variables
-	std::set<unsigned int> variables_integer;
+	ConstraintMatrix inequalities;
 
-	// set of binary variables
-	std::set<unsigned int> variables_binary;
+	// variable kinds, indexed by variable id
+	std::vector<bool> variables_integer;
+	std::vector<bool> variables_binary;
+	unsigned int num_integer, num_binary;
 
 	// By default all variables have a lower bound of zero and an upper bound of one.
 	// Exceptional cases are stored in this (unsorted) vector.
 	VariableRanges non_default_bounds;
 
+	static bool mark_variable(std::vector<bool> &kind, unsigned int variable_index)
+	{
+		if (kind.size() <= variable_index)
+			kind.resize(variable_index + 1, false);
+		if (kind[variable_index])
+			return false;
+		kind[variable_index] = true;
+		return true;
+	}
+
+	static bool test_variable(const std::vector<bool> &kind, unsigned int variable_index)
+	{
+		return variable_index < kind.size() && kind[variable_index];
+	}
+
+	// no copies
+	LinearProgram(const LinearProgram &);
+	LinearProgram& operator=(const LinearProgram &);
+
 public:
-	LinearProgram() : objective(new LinearExpression()) {};
+	LinearProgram()
+		: objective(new LinearExpression()), num_integer(0), num_binary(0)
+	{};
 
 	~LinearProgram()
 	{
 		delete objective;
-		foreach(equalities, eq)
-			delete eq->first;
-		foreach(inequalities, ineq)
-			delete ineq->first;
 	}
 
 	void declare_variable_integer(unsigned int variable_index)
 	{
-		variables_integer.insert(variable_index);
+		if (mark_variable(variables_integer, variable_index))
+			num_integer++;
 	}
 
 	void declare_variable_binary(unsigned int variable_index)
 	{
-		variables_binary.insert(variable_index);
+		if (mark_variable(variables_binary, variable_index))
+			num_binary++;
 	}
 
 	void declare_variable_bounds(unsigned int variable_id,
@@ -145,55 +265,82 @@ public:
 		objective = exp;
 	}
 
+	// The terms of exp are copied into the constraint matrix;
+	// exp itself is deleted.
 	void add_inequality(LinearExpression *exp, double upper_bound)
 	{
-		if (exp->has_terms())
-			inequalities.push_back(Constraint(exp, upper_bound));
-		else
-			delete exp;
+		inequalities.add_row(*exp, upper_bound);
+		delete exp;
 	}
 
 	void add_equality(LinearExpression *exp, double equal_to)
 	{
-		if (exp->has_terms())
-			equalities.push_back(Constraint(exp, equal_to));
-		else
-			delete exp;
+		equalities.add_row(*exp, equal_to);
+		delete exp;
 	}
 
-	const LinearExpression *get_objective() const
+	/* Alternatively, constraints can be written directly into the
+	 * constraint matrix, e.g.,
+	 *
+	 *     lp.add_inequality_term(1, x);
+	 *     lp.add_inequality_term(-1, y);
+	 *     lp.finish_inequality(0);       // x - y <= 0
+	 *
+	 * As with add_inequality(), rows without terms are dropped.
+	 */
+	void add_inequality_term(double coefficient, unsigned int variable_index)
 	{
-		return objective;
+		inequalities.add_term(coefficient, variable_index);
+	}
+
+	void finish_inequality(double upper_bound)
+	{
+		inequalities.finish_row(upper_bound);
+	}
+
+	void add_equality_term(double coefficient, unsigned int variable_index)
+	{
+		equalities.add_term(coefficient, variable_index);
+	}
+
+	void finish_equality(double equal_to)
+	{
+		equalities.finish_row(equal_to);
 	}
 
-	const std::set<unsigned int>& get_integer_variables() const
+	const LinearExpression *get_objective() const
 	{
-		return variables_integer;
+		return objective;
 	}
 
 	bool has_binary_variables() const
 	{
-		return !variables_binary.empty();
+		return num_binary > 0;
 	}
 
 	bool has_integer_variables() const
 	{
-		return !variables_integer.empty();
+		return num_integer > 0;
 	}
 
-	bool is_integer_variable(unsigned int variable_id) const
+	unsigned int get_num_binary_variables() const
 	{
-		return variables_integer.find(variable_id) != variables_integer.end();
+		return num_binary;
 	}
 
-	bool is_binary_variable(unsigned int variable_id) const
+	unsigned int get_num_integer_variables() const
 	{
-		return variables_binary.find(variable_id) != variables_binary.end();
+		return num_integer;
 	}
 
-	const std::set<unsigned int>& get_binary_variables() const
+	bool is_integer_variable(unsigned int variable_id) const
+	{
+		return test_variable(variables_integer, variable_id);
+	}
+
+	bool is_binary_variable(unsigned int variable_id) const
 	{
-		return variables_binary;
+		return test_variable(variables_binary, variable_id);
 	}
 
 	LinearExpression *get_objective()
@@ -201,12 +348,12 @@ public:
 		return objective;
 	}
 
-	const Constraints& get_equalities() const
+	const ConstraintMatrix& get_equalities() const
 	{
 		return equalities;
 	}
 
-	const Constraints& get_inequalities() const
+	const ConstraintMatrix& get_inequalities() const
 	{
 		return inequalities;
 	}
@@ -0,0 +1,123 @@
+#ifndef LINPROG_SESSION_H
+#define LINPROG_SESSION_H
+
+#include <vector>
+
+#include "linprog/model.h"
+#include "linprog/solver.h"
+
+// solver-independent copy of a LinearProgram, one row per constraint
+struct LinearProgramSnapshot
+{
+	enum column_kind_t {
+		CONTINUOUS = 0,
+		INTEGER    = 1,
+		BINARY     = 2
+	};
+
+	unsigned int num_cols;
+	unsigned int num_equalities; // rows 0 ... num_equalities-1
+
+	std::vector<double> objective;
+	std::vector<char> kind;
+	std::vector<VariableRange> bounds;
+
+	// row r has the terms row_start[r] ... row_start[r+1]-1
+	std::vector<unsigned int> row_start;
+	std::vector<unsigned int> cols;
+	std::vector<double> coeffs;
+	std::vector<double> rhs;
+
+	void load(const LinearProgram &lp, unsigned int num_cols,
+		  double var_lb, double var_ub);
+
+	unsigned int get_num_rows() const
+	{
+		return rhs.size();
+	}
+
+	bool is_mip() const;
+
+	// same variables, rows, and sparsity patterns
+	bool has_same_structure(const LinearProgramSnapshot &other) const;
+
+	bool row_differs(const LinearProgramSnapshot &other, unsigned int r) const;
+};
+
+// solution of a program without variables
+class EmptySolution : public Solution
+{
+public:
+	double get_value(unsigned int variable_index) const
+	{
+		return 0;
+	}
+};
+
+/* Common part of the LinearProgramSession implementations: keeps a snapshot
+ * of the previously solved program and translates a new program into the
+ * minimal set of in-place updates, which the solver backends apply.
+ */
+class IncrementalLPSession : public LinearProgramSession
+{
+private:
+	LinearProgramSnapshot current, next;
+	bool loaded;
+	EmptySolution empty;
+
+	unsigned int num_loads, num_updates;
+
+protected:
+	double var_lb, var_ub;
+
+	const LinearProgramSnapshot& get_snapshot() const
+	{
+		return current;
+	}
+
+	// (re)build the solver problem from get_snapshot()
+	virtual bool load_problem() = 0;
+
+	// after an update of get_snapshot(): copy over the changed parts
+	virtual bool update_rhs(unsigned int row) = 0;
+	virtual bool update_row(unsigned int row) = 0;
+	virtual bool update_objective(unsigned int col) = 0;
+	virtual bool update_bounds(unsigned int col) = 0;
+
+	// Solve the current problem; warm == true if the problem was
+	// updated in place since the last successful optimize().
+	virtual bool optimize(bool warm) = 0;
+
+	// the solution found by the last successful optimize()
+	virtual const Solution *get_solution() const = 0;
+
+	// release the solver problem, if any
+	virtual void free_problem() = 0;
+
+	// report why the last solve() failed (as glpk_solve() does)
+	virtual void show_error() const {}
+
+public:
+	IncrementalLPSession(double var_lb = 0.0, double var_ub = 1.0)
+		: loaded(false), num_loads(0), num_updates(0),
+		  var_lb(var_lb), var_ub(var_ub)
+	{}
+
+	const Solution *solve(const LinearProgram &lp,
+			      unsigned int max_num_vars);
+
+	void reset();
+
+	// number of solve() calls that (re)built resp. updated the problem
+	unsigned int get_load_count() const
+	{
+		return num_loads;
+	}
+
+	unsigned int get_update_count() const
+	{
+		return num_updates;
+	}
+};
+
+#endif
@@ -24,6 +24,32 @@ public:
 	}
 };
 
+/* A solver session keeps the solver's copy of a linear program alive across
+ * calls to solve(). If the program passed to solve() has the same structure
+ * as the previous one (the same variables and the same constraints over the
+ * same variables, in the same order), only the right-hand sides,
+ * coefficients, objective coefficients, and variable bounds that changed
+ * are updated in place, and the solver starts from the previous basis.
+ * Otherwise, the problem is rebuilt from scratch.
+ *
+ * This pays off when the same LP is re-solved many times with slightly
+ * different parameters, e.g., in a response-time fixed-point iteration.
+ * The returned solution belongs to the session and remains valid until the
+ * next call to solve() or reset(); NULL is returned if the LP could not be
+ * solved.
+ */
+class LinearProgramSession
+{
+public:
+	virtual ~LinearProgramSession() {};
+
+	virtual const Solution *solve(const LinearProgram &lp,
+				      unsigned int max_num_vars) = 0;
+
+	// forget the current problem
+	virtual void reset() = 0;
+};
+
 #if defined(CONFIG_HAVE_GLPK)
 #include "linprog/glpk.h"
 #elif defined(CONFIG_HAVE_CPLEX)
@@ -32,20 +58,76 @@ public:
 #warning No LP solver available.
 #endif
 
+#include "linprog/dense.h"
+#include "linprog/stats.h"
+
 
 static inline Solution *linprog_solve(
 	const LinearProgram& lp,
 	unsigned int max_num_vars)
 {
+#if defined(CONFIG_HAVE_GLPK) || defined(CONFIG_HAVE_CPLEX)
+	Solution *sol = NULL;
+
+	lp_stats_solve_begin();
 
+	// tiny LP: avoid the setup costs of the external solver
+	if (is_dense_lp_candidate(lp, max_num_vars))
+		sol = dense_solve(lp, max_num_vars);
+
+	if (!sol)
 #if defined(CONFIG_HAVE_GLPK)
-	return glpk_solve(lp, max_num_vars);
+		sol = glpk_solve(lp, max_num_vars);
+#else
+		sol = cpx_solve(lp, max_num_vars);
+#endif
+
+	lp_stats_solve_end(lp, max_num_vars);
+	return sol;
+#else
+	assert(0);
+	return NULL;
+#endif
+}
+
+static inline LinearProgramSession *linprog_session()
+{
+#if defined(CONFIG_HAVE_GLPK)
+	return glpk_session();
 #elif defined(CONFIG_HAVE_CPLEX)
-	return cpx_solve(lp, max_num_vars);
+	return cpx_session();
 #else
 	assert(0);
 	return NULL;
 #endif
 }
 
+// As linprog_solve() above, but in the given session unless it is NULL.
+// The caller deletes the returned solution only if session is NULL.
+static inline const Solution *linprog_solve(
+	const LinearProgram& lp,
+	unsigned int max_num_vars,
+	LinearProgramSession *session)
+{
+	const Solution *sol;
+
+	if (!session)
+		return linprog_solve(lp, max_num_vars);
+
+	lp_stats_solve_begin();
+	sol = session->solve(lp, max_num_vars);
+	lp_stats_solve_end(lp, max_num_vars);
+	return sol;
+}
+
+// Release the solver state of a worker thread that solved LPs; must be
+// called by the thread itself before it exits, once none of its
+// solutions or sessions are in use anymore.
+static inline void linprog_thread_exit()
+{
+#if defined(CONFIG_HAVE_GLPK)
+	glpk_thread_exit();
+#endif
+}
+
 #endif
@@ -0,0 +1,97 @@
+#ifndef LINPROG_STATS_H
+#define LINPROG_STATS_H
+
+/* Costs of the LPs solved on behalf of one analysis, summed over all calls
+ * since the last reset_lp_stats(). Times are in seconds of CPU time of the
+ * threads that did the work. Model generation covers everything up to the
+ * start of the solver (including the preparation of the next LP after a
+ * solution), extraction everything after the last solution of a task.
+ */
+struct LPStats
+{
+	unsigned long calls;
+	unsigned long num_lps;
+
+	double model_gen_time;
+	double solver_time;
+	double extract_time;
+
+	// totals over all solved LPs (nonzeros: constraint coefficients)
+	unsigned long rows;
+	unsigned long cols;
+	unsigned long nonzeros;
+	unsigned long integer_vars;
+
+	// largest single LP
+	unsigned long max_rows;
+	unsigned long max_cols;
+	unsigned long max_nonzeros;
+
+	LPStats()
+		: calls(0), num_lps(0),
+		  model_gen_time(0), solver_time(0), extract_time(0),
+		  rows(0), cols(0), nonzeros(0), integer_vars(0),
+		  max_rows(0), max_cols(0), max_nonzeros(0)
+	{}
+
+#ifndef SWIG
+	void merge(const LPStats& other);
+#endif
+};
+
+/* Recording is disabled by default; while it is disabled, the
+ * instrumentation costs one thread-local lookup per LP.
+ */
+void set_lp_stats_enabled(bool enabled);
+bool get_lp_stats_enabled();
+
+// zero all counters
+void reset_lp_stats();
+
+// analyses that have been recorded, in order of their names
+unsigned int get_lp_stats_count();
+const char *get_lp_stats_name(unsigned int index);
+LPStats get_lp_stats(unsigned int index);
+
+#ifndef SWIG
+
+class LinearProgram;
+
+/* While an LPStatsScope exists, the LPs solved by the creating thread are
+ * attributed to one analysis. The outermost scope of a thread determines
+ * the analysis; nested scopes (e.g., one per task) only delimit the
+ * phases. Scopes must be destroyed in reverse order of creation.
+ */
+class LPStatsScope
+{
+private:
+	LPStats *saved_target;
+	bool saved_solved;
+
+	void enter(LPStats *target);
+
+	// no copies
+	LPStatsScope(const LPStatsScope &);
+	LPStatsScope& operator=(const LPStatsScope &);
+
+public:
+	// start a call of the named analysis (a string literal) unless
+	// the thread is already recording
+	explicit LPStatsScope(const char *analysis);
+
+	// continue recording for target, e.g., on a worker thread
+	explicit LPStatsScope(LPStats *target);
+
+	~LPStatsScope();
+
+	// the analysis that the calling thread records for, or NULL
+	static LPStats *current();
+};
+
+// called by the solver interfaces immediately before and after solving
+void lp_stats_solve_begin();
+void lp_stats_solve_end(const LinearProgram &lp, unsigned int max_num_vars);
+
+#endif
+
+#endif
@@ -2,26 +2,49 @@
 #define VARMAPPERBASE_H
 
 #include <stdint.h>
+#include <climits>
+#include <cassert>
 #include <string>
+#include <vector>
 
 #include "stl-helper.h"
 #include "stl-hashmap.h"
 
+/* Assigns LP variable indices to keys, in the order in which the keys are
+ * first referenced.
+ *
+ * Subclasses whose keys are made of small, dense ids (task, resource,
+ * variable type, request number) should map them with var_for_slot():
+ * the key is split into a block number, computed arithmetically from
+ * the ids, and an index within the block (usually the request number),
+ * so that a lookup costs two array accesses. Other keys are mapped with
+ * var_for_key(), which uses a hash table.
+ */
 class VarMapperBase {
 
 private:
+	enum { UNMAPPED = UINT_MAX };
+
+	// keys mapped with var_for_key()
 	hashmap<uint64_t, unsigned int> map;
-	unsigned int next_var;
+
+	// keys mapped with var_for_slot(): blocks[block][index]
+	std::vector< std::vector<unsigned int> > blocks;
+
+	// reverse map: the key of variable start_var + i is keys[i]
+	std::vector<uint64_t> keys;
+
+	unsigned int start_var, next_var;
 	bool sealed;
 
 protected:
-	void insert(uint64_t key)
+	unsigned int insert(uint64_t key)
 	{
 		assert(next_var < UINT_MAX);
 		assert(!sealed);
 
-		unsigned int idx = next_var++;
-		map[key] = idx;
+		keys.push_back(key);
+		return next_var++;
 	}
 
 	bool exists(uint64_t key) const
@@ -37,27 +60,50 @@ protected:
 	unsigned int var_for_key(uint64_t key)
 	{
 		if (!exists(key))
-			insert(key);
+			map[key] = insert(key);
 		return get(key);
 	}
 
+	// Set up the blocks for var_for_slot(); must be called before
+	// the first variable is mapped.
+	void set_num_blocks(unsigned int num_blocks)
+	{
+		assert(keys.empty());
+		blocks.resize(num_blocks);
+	}
+
+	unsigned int get_num_blocks() const
+	{
+		return blocks.size();
+	}
+
+	// key must identify (block, index) uniquely; it is used only for
+	// the reverse mapping
+	unsigned int var_for_slot(unsigned int block, unsigned int index,
+	                          uint64_t key)
+	{
+		assert(block < blocks.size());
+
+		std::vector<unsigned int> &slots = blocks[block];
+		if (index >= slots.size())
+			slots.resize(index + 1, UNMAPPED);
+		if (slots[index] == UNMAPPED)
+			slots[index] = insert(key);
+		return slots[index];
+	}
+
 	bool search_key_for_var(unsigned int var, uint64_t &key) const
 	{
-		foreach(map, it)
-		{
-			if (it->second == var)
-			{
-				key = it->first;
-				return true;
-			}
-		}
-		return false;
+		if (var < start_var || var - start_var >= keys.size())
+			return false;
+		key = keys[var - start_var];
+		return true;
 	}
 
 public:
 
 	VarMapperBase(unsigned int start_var = 0)
-		: next_var(start_var), sealed(false)
+		: start_var(start_var), next_var(start_var), sealed(false)
 	{}
 
 
@@ -69,7 +115,7 @@ public:
 
 	unsigned int get_num_vars() const
 	{
-		return map.size();
+		return keys.size();
 	}
 
 	unsigned int get_next_var() const
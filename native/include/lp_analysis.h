@@ -2,6 +2,100 @@
 #define LP_ANALYSYS_H_
 
 #include "sharedres_types.h"
+#include "linprog/stats.h"
+#include "budget.h"
+
+class LinearProgramSession;
+
+/* Solver sessions (see linprog/solver.h) for the DPCP, DFLP, MPCP, and
+ * partitioned FMLP analyses and the suspension-aware analyses under global
+ * scheduling below, one per task. When the same LPSessions object is passed
+ * to an analysis repeatedly for the same task set, e.g., in each step of a
+ * response-time fixed-point iteration, the LP of each task is updated in
+ * place and re-solved from the previous basis instead of being rebuilt from
+ * scratch. Use one LPSessions object per analysis. LPs solved in a session
+ * bypass the built-in solver of set_lp_dense_limit().
+ */
+class LPSessions
+{
+private:
+	std::vector<LinearProgramSession*> sessions;
+
+	// no copies
+	LPSessions(const LPSessions &);
+	LPSessions& operator=(const LPSessions &);
+
+public:
+	LPSessions() {}
+	~LPSessions();
+
+	LinearProgramSession *for_task(unsigned int task_index);
+
+	// forget all LPs, e.g., before moving on to another task set
+	void reset();
+};
+
+/* The analyses below solve one LP per task. These LPs are independent and
+ * can be solved in parallel by up to this many worker threads (zero means
+ * one per hardware thread). The default is one, i.e., all LPs are solved on
+ * the calling thread, which is preferable if the caller already runs
+ * several analyses concurrently. The bounds do not depend on this setting.
+ * LPs that are solved in LPSessions are always solved on the calling
+ * thread.
+ */
+void set_lp_num_threads(unsigned int num_threads);
+unsigned int get_lp_num_threads();
+
+/* LPs with at most this many variables and constraints are solved with a
+ * small built-in simplex solver (see linprog/dense.h) instead of the
+ * external solver, which is faster for tiny LPs. Where an LP has several
+ * optimal solutions, the built-in solver may pick a different one than the
+ * external solver, which can shift blocking between the local and remote
+ * components reported by some analyses (their sum is unaffected). Zero (the
+ * default) disables the built-in solver.
+ */
+void set_lp_dense_limit(unsigned int max_size);
+unsigned int get_lp_dense_limit();
+
+/* The LPs of the DPCP and DFLP analyses below contain one set of variables
+ * per request instance, i.e., the model size grows with the ratio of the
+ * response time of the analyzed task and the periods of the other tasks. If
+ * enabled, all instances of a request share one set of variables with a
+ * correspondingly larger range instead, which yields the same bounds with
+ * much smaller LPs. Disabled by default.
+ */
+void set_lp_instance_aggregation(bool enabled);
+bool get_lp_instance_aggregation();
+
+/* Optional memoization of the bounds returned by the analyses below (except
+ * for the nested spin lock analysis). The bounds are cached per task: if
+ * enabled, the analysis of each task first checks whether the same analysis
+ * has been applied to the same task with identical inputs (all task
+ * parameters, requests, analysis parameters, resource locality, and the LP
+ * settings above) and, if so, uses the earlier bounds without solving the
+ * task's LP. The DPCP (without use_rta), DFLP, partitioned FMLP, and OMIP
+ * analyses read the other tasks' response times only through the number of
+ * their jobs that overlap with the analyzed task's response time, and are
+ * keyed on these numbers instead; hence, an iterative response-time analysis
+ * reuses the bounds of tasks that do not see any additional jobs. Up to
+ * max_entries per-task results are kept, the least recently used ones are
+ * dropped first. The cache is disabled (zero entries) by default.
+ */
+void set_lp_cache_capacity(unsigned int max_entries);
+unsigned int get_lp_cache_capacity();
+
+// drop all cached results and reset the counters below
+void clear_lp_cache();
+
+// per-task lookups
+unsigned long get_lp_cache_hits();
+unsigned long get_lp_cache_misses();
+
+/* If enabled with set_lp_stats_enabled() (see linprog/stats.h), each of the
+ * analyses below records the time spent generating, solving, and evaluating
+ * its LPs and their sizes. get_lp_stats() returns the totals of the
+ * analysis named get_lp_stats_name(), e.g., "lp_dpcp_bounds".
+ */
 
 /* The following analyses are described in the extended version of:
  *
@@ -10,14 +104,18 @@
  */
 
 BlockingBounds* lp_dpcp_bounds(const ResourceSharingInfo& info,
-		    const ResourceLocality& locality, bool use_RTA = true);
+		    const ResourceLocality& locality, bool use_RTA = true,
+		    LPSessions *sessions = NULL);
 
 BlockingBounds* lp_dflp_bounds(const ResourceSharingInfo& info,
-		    const ResourceLocality& locality);
+		    const ResourceLocality& locality,
+		    LPSessions *sessions = NULL);
 
-BlockingBounds* lp_mpcp_bounds(const ResourceSharingInfo& info);
+BlockingBounds* lp_mpcp_bounds(const ResourceSharingInfo& info,
+		    LPSessions *sessions = NULL);
 
-BlockingBounds* lp_part_fmlp_bounds(const ResourceSharingInfo& info);
+BlockingBounds* lp_part_fmlp_bounds(const ResourceSharingInfo& info,
+		    LPSessions *sessions = NULL);
 
 /* The analysis of the OMIP is described in the extended version of:
  *
@@ -85,55 +183,71 @@ BlockingBounds* lp_pfp_prio_fifo_spinlock_bounds(
  */
 BlockingBounds* lp_global_pip_bounds(
 	const ResourceSharingInfo& info,
-	unsigned int number_of_cpus);
+	unsigned int number_of_cpus,
+	LPSessions *sessions = NULL);
 
 /* Suspension-aware analysis of the parallel priority ceiling protocol (P-PCP)
  * under global scheduling */
 BlockingBounds* lp_ppcp_bounds(
 	const ResourceSharingInfo& info,
 	unsigned int number_of_cpus,
-	bool reasonable_priority_assignment = false);
+	bool reasonable_priority_assignment = false,
+	LPSessions *sessions = NULL);
 
 /* Suspension-aware analysis of the flexible multiprocessor locking protocol
  * (FMLP) under global scheduling */
 BlockingBounds* lp_sa_gfmlp_bounds(
 	const ResourceSharingInfo& info,
-	unsigned int number_of_cpus);
+	unsigned int number_of_cpus,
+	LPSessions *sessions = NULL);
 
 /* Suspension-aware analysis of the generalized FIFO multiprocessor locking
  * protocol (FMLP+) under global scheduling */
 BlockingBounds* lp_global_fmlpp_bounds(
 	const ResourceSharingInfo& info,
-	unsigned int number_of_cpus);
+	unsigned int number_of_cpus,
+	LPSessions *sessions = NULL);
 
 /* Suspension-aware analysis of the Priority-based Restricted Segment Boosting
  * (PRSB) protocol under global scheduling*/
 BlockingBounds* lp_prsb_bounds(
 	const ResourceSharingInfo& info,
-	unsigned int number_of_cpus);
+	unsigned int number_of_cpus,
+	LPSessions *sessions = NULL);
 
 /* Suspension-aware analysis for no progress mechanism and FIFO queuing under
  * global scheduling */
 BlockingBounds* lp_no_progress_fifo_bounds(
 	const ResourceSharingInfo& info,
-	unsigned int number_of_cpus);
+	unsigned int number_of_cpus,
+	LPSessions *sessions = NULL);
 
 /* Suspension-aware analysis for no progress mechanism and priority queuing
  * under global scheduling */
 BlockingBounds* lp_no_progress_priority_bounds(
 	const ResourceSharingInfo& info,
-	unsigned int number_of_cpus);
+	unsigned int number_of_cpus,
+	LPSessions *sessions = NULL);
+
+/* The following P-EDF analyses iterate until they reach a conclusion, which
+ * may take very long. If a budget is given, they give up when it is
+ * exhausted and return SCHED_UNKNOWN.
+ */
 
 /* P-EDF MSRP analysis, using blocking-aware PDC */
-bool lp_pedf_msrp_is_schedulable(const ResourceSharingInfo& info);
+sched_result_t lp_pedf_msrp_is_schedulable(const ResourceSharingInfo& info,
+					   Budget *budget = NULL);
 
 /* P-EDF FIFO Preemptive spin locks analysis, using blocking-aware PDC */
-bool lp_pedf_fifo_preempt_is_schedulable(const ResourceSharingInfo& info);
+sched_result_t lp_pedf_fifo_preempt_is_schedulable(const ResourceSharingInfo& info,
+						   Budget *budget = NULL);
 
 /* P-EDF Lock-Free Synchronization with Preemptive Commit Loops, using blocking aware PDC */
-bool lp_pedf_lockfree_preempt_is_schedulable(const ResourceSharingInfo& info);
+sched_result_t lp_pedf_lockfree_preempt_is_schedulable(const ResourceSharingInfo& info,
+						       Budget *budget = NULL);
 
 /* P-EDF Lock-Free Synchronization with NP Commit Loops, using blocking aware PDC */
-bool lp_pedf_lockfree_NP_is_schedulable(const ResourceSharingInfo& info);
+sched_result_t lp_pedf_lockfree_NP_is_schedulable(const ResourceSharingInfo& info,
+						  Budget *budget = NULL);
 
 #endif /* LP_ANALYSYS_H_ */
@@ -0,0 +1,146 @@
+#ifndef LP_CACHE_H_
+#define LP_CACHE_H_
+
+#include <vector>
+
+#include "lp_common.h"
+
+// analyses whose results are memoized (see set_lp_cache_capacity())
+enum lp_cache_analysis_t
+{
+	LP_CACHE_DPCP,
+	LP_CACHE_DFLP,
+	LP_CACHE_MPCP,
+	LP_CACHE_PART_FMLP,
+	LP_CACHE_OMIP,
+	LP_CACHE_GFMLP,
+	LP_CACHE_PFP_MSRP,
+	LP_CACHE_PFP_PREEMPTIVE_FIFO,
+	LP_CACHE_PFP_UNORDERED,
+	LP_CACHE_PFP_PRIO,
+	LP_CACHE_PFP_PRIO_FIFO,
+	LP_CACHE_PFP_BASELINE,
+	LP_CACHE_GLOBAL_PIP,
+	LP_CACHE_PPCP,
+	LP_CACHE_SA_GFMLP,
+	LP_CACHE_GLOBAL_FMLPP,
+	LP_CACHE_PRSB,
+	LP_CACHE_NO_PROGRESS_FIFO,
+	LP_CACHE_NO_PROGRESS_PRIORITY
+};
+
+/* Canonical encoding of everything the analysis of one task reads from its
+ * input: the analysis, its parameters, the LP settings, and all task
+ * parameters and requests. Two analyses of the same task with equal keys
+ * yield the same bounds, so the bounds are cached per task. If the cache is
+ * disabled, the key remains empty and is not used.
+ */
+class LPCacheKey
+{
+private:
+	const ResourceSharingInfo& info;
+	std::vector<unsigned long> words;
+	bool active;
+	bool jobs_in_response;
+
+	std::vector<unsigned long> task_key(unsigned int i) const;
+
+public:
+	LPCacheKey(lp_cache_analysis_t analysis,
+		   const ResourceSharingInfo& info);
+
+	LPCacheKey(lp_cache_analysis_t analysis,
+		   const ResourceSharingInfo& info,
+		   const ResourceLocality& locality);
+
+	LPCacheKey& add(unsigned long param)
+	{
+		if (active)
+			words.push_back(param);
+		return *this;
+	}
+
+	/* The analysis of a task ti reads the response time of any other task
+	 * tx only through tx.get_max_num_jobs(ti.get_response()), i.e., the
+	 * number of jobs (and hence requests) of tx that overlap with a job of
+	 * ti. Key on these counts instead of the response times, so that ti's
+	 * bounds are reused while an iterative response-time analysis updates
+	 * the other tasks' response times.
+	 */
+	LPCacheKey& count_jobs_in_response()
+	{
+		jobs_in_response = true;
+		return *this;
+	}
+
+	bool is_active() const
+	{
+		return active;
+	}
+
+	const ResourceSharingInfo& get_info() const
+	{
+		return info;
+	}
+
+	// copy the cached bounds of task i into results; false on a miss
+	bool lookup(unsigned int i, BlockingBounds& results) const;
+
+	void insert(unsigned int i, const BlockingBounds& results) const;
+};
+
+/* Call fn(i) for each task index i of info (as foreach_task_in_parallel())
+ * whose bounds are not cached under key, and remember the bounds that fn(i)
+ * stores in results. The cached bounds of the other tasks are copied into
+ * results instead.
+ */
+template <typename Func>
+void foreach_uncached_task_in_parallel(const LPCacheKey& key,
+                                       BlockingBounds& results, Func fn,
+                                       unsigned int num_threads = get_lp_num_threads())
+{
+	if (!key.is_active())
+	{
+		foreach_task_in_parallel(key.get_info(), fn, num_threads);
+		return;
+	}
+
+	foreach_task_in_parallel(key.get_info(), [&](unsigned int i)
+	{
+		if (!key.lookup(i, results))
+		{
+			fn(i);
+			key.insert(i, results);
+		}
+	}, num_threads);
+}
+
+/* For analyses that bound all tasks at once (CONFIG_MERGED_LINPROGS):
+ * return the cached bounds if all tasks are cached, or compute them with
+ * analysis() and remember them for later calls.
+ */
+template <typename Analysis>
+BlockingBounds* cached_lp_bounds(const LPCacheKey& key, Analysis analysis)
+{
+	const unsigned int num_tasks = key.get_info().get_tasks().size();
+	BlockingBounds* results;
+
+	if (key.is_active())
+	{
+		results = new BlockingBounds(key.get_info());
+		unsigned int i = 0;
+		while (i < num_tasks && key.lookup(i, *results))
+			i++;
+		if (i == num_tasks)
+			return results;
+		delete results;
+	}
+
+	results = analysis();
+	if (key.is_active())
+		for (unsigned int i = 0; i < num_tasks; i++)
+			key.insert(i, *results);
+	return results;
+}
+
+#endif
@@ -2,6 +2,7 @@
 #define LP_COMMON_H_
 
 #include <stdint.h>
+#include <set>
 
 #include "sharedres_types.h"
 #include "blocking.h"
@@ -12,6 +13,9 @@
 #include "linprog/solver.h"
 #include "linprog/varmapperbase.h"
 
+#include "lp_analysis.h"
+#include "parallel.h"
+
 enum blocking_type
 {
 	BLOCKING_DIRECT,
@@ -23,6 +27,33 @@ enum blocking_type
 // s-oblivious analysis reuses BLOCKING_DIRECT as a catch-all blocking type.
 #define BLOCKING_SOB BLOCKING_DIRECT
 
+/* Call fn(i) for each task index i of info, spreading the tasks over
+ * num_threads workers (see set_lp_num_threads()). fn(i) may write only the
+ * results of task i.
+ */
+template <typename Func>
+void foreach_task_in_parallel(const ResourceSharingInfo& info, Func fn,
+                              unsigned int num_threads = get_lp_num_threads())
+{
+#if DEBUG_LP_OVERHEADS >= 1
+	// keep the overhead reports in order
+	num_threads = 1;
+#endif
+	// the workers record their LPs for the caller's analysis
+	LPStats *stats = LPStatsScope::current();
+
+	parallel_for(info.get_tasks().size(), num_threads,
+		[&fn, stats](unsigned int worker, unsigned long i)
+		{
+			LPStatsScope scope(stats);
+			fn(i);
+		},
+		linprog_thread_exit);
+}
+
+// one more than the largest resource ID used in info
+unsigned int get_resource_id_limit(const ResourceSharingInfo& info);
+
 class VarMapper : public VarMapperBase {
 private:
 
@@ -57,21 +88,82 @@ private:
 		return var & (uint64_t) 0x3ff;
 	}
 
+	enum { NUM_BLOCKING_TYPES = BLOCKING_OTHER + 1 };
+
+	// dimensions of the dense key space, see VarMapperBase
+	unsigned int num_tasks, num_resources;
+
+	bool aggregate_instances;
+
 public:
 	VarMapper(unsigned int start_var = 0)
-		: VarMapperBase(start_var)
+		: VarMapperBase(start_var), num_tasks(0), num_resources(0),
+		  aggregate_instances(false)
 	{}
 
+	// One block per (blocking type, task, resource), indexed by
+	// request number; tasks and resources not in info are still
+	// supported, but looked up by hashing.
+	VarMapper(const ResourceSharingInfo& info, unsigned int start_var = 0)
+		: VarMapperBase(start_var),
+		  num_tasks(info.get_tasks().size()),
+		  num_resources(get_resource_id_limit(info)),
+		  aggregate_instances(false)
+	{
+		set_num_blocks(NUM_BLOCKING_TYPES * num_tasks * num_resources);
+	}
+
+	/* Represent all request instances of a request by the variables of
+	 * its first instance, which then range over [0, number of
+	 * instances] instead of [0, 1]. Only valid for LPs in which all
+	 * instances of a request are interchangeable, i.e., all constraints
+	 * either sum over all instances or are the same for each instance.
+	 */
+	void aggregate_request_instances()
+	{
+		aggregate_instances = true;
+	}
+
+	// number of instances of request (as seen by ti) with own variables
+	unsigned int num_instance_vars(const RequestBound& request,
+	                               const TaskInfo& ti) const
+	{
+		unsigned int n = request.get_max_num_requests(ti.get_response());
+		return aggregate_instances ? std::min(n, 1u) : n;
+	}
+
+	// number of request instances represented by each of these variables
+	unsigned int instance_multiplicity(const RequestBound& request,
+	                                   const TaskInfo& ti) const
+	{
+		if (aggregate_instances)
+			return request.get_max_num_requests(ti.get_response());
+		else
+			return 1;
+	}
+
 	unsigned int lookup(unsigned int task_id, unsigned int res_id, unsigned int req_id,
 	                    blocking_type type)
 	{
 		uint64_t key = encode_request(task_id, res_id, req_id, type);
-		return var_for_key(key);
+		if (task_id < num_tasks && res_id < num_resources)
+			return var_for_slot((type * num_tasks + task_id) * num_resources + res_id,
+			                    req_id, key);
+		else
+			return var_for_key(key);
 	}
 
 	std::string key2str(uint64_t key, unsigned int var) const;
 };
 
+// like foreach_request_instance(), but only over the instances that have
+// their own variables in vars
+#define foreach_request_instance_var(vars, tx_request, task_ti, v)	\
+	for (unsigned int __num_instance_vars =				\
+		(vars).num_instance_vars(tx_request, task_ti), v = 0;	\
+	     v < __num_instance_vars;					\
+	     v++)
+
 // spinlock analysis: re-use indirect for arrival
 #define BLOCKING_ARRIVAL BLOCKING_INDIRECT
 
@@ -80,6 +172,8 @@ class VarMapperSpinlocks : public VarMapper
 public:
 	VarMapperSpinlocks(unsigned int start_var = 0)
 		: VarMapper(start_var) { }
+	VarMapperSpinlocks(const ResourceSharingInfo& info, unsigned int start_var = 0)
+		: VarMapper(info, start_var) { }
 	// re-use preemption blocking for arrival blocking decision variables
 	unsigned int lookup_arrival_enabled(unsigned int res_id)
 	{
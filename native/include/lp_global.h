@@ -76,71 +76,86 @@ class GlobalVarMapper : public VarMapperBase
 
 	};
 
+	enum {
+		NUM_BLOCKING_TYPES     = 4,
+		NUM_INTERFERENCE_TYPES = 3
+	};
+
+	// dimensions of the dense key space, see VarMapperBase
+	unsigned int num_tasks, num_resources;
+
+	// One block per (blocking type, task, resource), indexed by request
+	// number, followed by one block per interference type, indexed by task.
+	unsigned int blocking_var(unsigned int task_id, unsigned int res_id,
+	                          unsigned int cs_id, blocking_type_t btype)
+	{
+		lookup_key_t k;
+
+		k.make_var_for(task_id, res_id, cs_id, btype);
+		if (task_id < num_tasks && res_id < num_resources)
+			return var_for_slot((btype * num_tasks + task_id) * num_resources + res_id,
+			                    cs_id, k.raw);
+		else
+			return var_for_key(k.raw);
+	}
+
+	unsigned int interference_var(unsigned int task_id, blocking_type_t btype)
+	{
+		lookup_key_t k;
+
+		k.make_interference_var_for(task_id, btype);
+		return var_for_slot(NUM_BLOCKING_TYPES * num_tasks * num_resources + btype,
+		                    task_id, k.raw);
+	}
+
 public:
+	GlobalVarMapper(const ResourceSharingInfo& info);
+
 	unsigned int direct(unsigned int task_id, unsigned int res_id,
 	                    unsigned int cs_id)
 	{
-		lookup_key_t k;
-
-		k.make_var_for(task_id, res_id, cs_id, DIRECT_BLOCKING);
-		return var_for_key(k.raw);
+		return blocking_var(task_id, res_id, cs_id, DIRECT_BLOCKING);
 	}
 
 	unsigned int indirect(unsigned int task_id, unsigned int res_id,
 	                      unsigned int cs_id)
 	{
-		lookup_key_t k;
-
-		k.make_var_for(task_id, res_id, cs_id, INDIRECT_BLOCKING);
-		return var_for_key(k.raw);
+		return blocking_var(task_id, res_id, cs_id, INDIRECT_BLOCKING);
 	}
 
 	unsigned int preemption(unsigned int task_id, unsigned int res_id,
 	                        unsigned int cs_id)
 	{
-		lookup_key_t k;
-
-		k.make_var_for(task_id, res_id, cs_id, PREEMPTION_BLOCKING);
-		return var_for_key(k.raw);
+		return blocking_var(task_id, res_id, cs_id, PREEMPTION_BLOCKING);
 	}
 
 	unsigned int expelling(unsigned int task_id, unsigned int res_id,
 	                       unsigned int cs_id)
 	{
-		lookup_key_t k;
-
-		k.make_var_for(task_id, res_id, cs_id, EXPELLING_BLOCKING);
-		return var_for_key(k.raw);
+		return blocking_var(task_id, res_id, cs_id, EXPELLING_BLOCKING);
 	}
 
 	unsigned int regular_interference(unsigned int task_id)
 	{
-		lookup_key_t k;
-
-		k.make_interference_var_for(task_id, REGULAR_INTERFERENCE);
-		return var_for_key(k.raw);
+		return interference_var(task_id, REGULAR_INTERFERENCE);
 	}
 
 	unsigned int co_boosting_interference(unsigned int task_id)
 	{
-		lookup_key_t k;
-
-		k.make_interference_var_for(task_id, CO_BOOSTING_INTERFERENCE);
-		return var_for_key(k.raw);
+		return interference_var(task_id, CO_BOOSTING_INTERFERENCE);
 	}
 
 	unsigned int stalling_interference(unsigned int task_id)
 	{
-		lookup_key_t k;
-
-		k.make_interference_var_for(task_id, STALLING_INTERFERENCE);
-		return var_for_key(k.raw);
+		return interference_var(task_id, STALLING_INTERFERENCE);
 	}
 
 	std::string key2str(uint64_t key, unsigned int var) const;
 };
 
 
+class LinearProgramSession;
+
 class GlobalSuspensionAwareLP : protected LinearProgram
 {
 
@@ -190,7 +205,9 @@ public:
 		unsigned int task_index,
 		unsigned int number_of_cpus);
 
-	unsigned long solve();
+	// With a session, the LP is solved in it rather than from scratch;
+	// see linprog/solver.h.
+	unsigned long solve(LinearProgramSession *session = NULL);
 	unsigned long solve_debug();
 
 	// set bounds of interference variables properly, ie, not upper-bounded
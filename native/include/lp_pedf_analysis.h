@@ -14,13 +14,12 @@
 // the tasks in the system:
 // #define __PEDF_BLK_ANALYSIS_ENABLE_HP_STOP__
 
-// Enable a timeout for the analysis loop:
-// Warning: based on SIGALARM, hence not 100% portable
-// #define  __PEDF_BLK_ANALYSIS_ENABLE_TIMEOUT__
-
 // ------------------------------------------------------------------
 
 
+#include "task_columns.h"
+#include "budget.h"
+
 // Default value used for blocking lower-bound
 static unsigned long AVAL = 0;
 
@@ -29,7 +28,8 @@ class PEDFBlockingAnalysis
   public:
     PEDFBlockingAnalysis(const ResourceSharingInfo& _info, unsigned int _cluster);
 
-    bool is_schedulable();
+    // Gives up (SCHED_UNKNOWN) once budget is exhausted.
+    sched_result_t check(Budget &budget);
 
   protected:
     virtual unsigned long compute_blocking_PDC(unsigned long interval_length) = 0;
@@ -47,9 +47,13 @@ class PEDFBlockingAnalysis
     unsigned int max_deadline, min_deadline;
 
   private:
+    // vectorized DBF/arrival curve of the local tasks
+    TaskColumns local_tasks;
+    // DBF() may use local_tasks only for intervals of at least this length
+    unsigned long min_exact_dbf_interval;
 
     //bool processorDemandCriterion(std::map<int, unsigned int>& nJobs, unsigned long maxTime);
-    bool QPA(unsigned long t_LB, unsigned long t_UB, unsigned long blk_LB_in = 0, unsigned long& blk_LB_out = AVAL);
+    bool QPA(Budget &budget, unsigned long t_LB, unsigned long t_UB, unsigned long blk_LB_in = 0, unsigned long& blk_LB_out = AVAL);
     bool raw_PDC(unsigned long t_LB, unsigned long t_UB);
     unsigned long DBF(unsigned long interval_length);
     unsigned long arrival_curve(unsigned long interval_length);
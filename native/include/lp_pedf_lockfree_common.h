@@ -123,6 +123,7 @@ private:
 	// Generic constraints:
     void add_blocking_upper_and_lower_bound(unsigned long blocking_LB,
                                             unsigned long blocking_UB);
+    void add_blocking_objective_terms(double sign);
     void add_no_retries_for_resources_not_accessed();
     void add_one_retry_for_at_most_one_remote_commit();
 
@@ -50,37 +50,49 @@ class SpinVarMapper : public VarMapperBase
 		}
 	};
 
-public:
-	unsigned int spin(unsigned int task_id, unsigned int res_id)
+	enum { NUM_VARIABLE_TYPES = 4 };
+
+	// dimension of the dense key space, see VarMapperBase
+	unsigned int num_tasks;
+
+	// one block per (variable type, task), indexed by resource
+	unsigned int var_for(unsigned int task_id, unsigned int res_id,
+	                     variable_type_t vtype)
 	{
 		lookup_key_t k;
 
-		k.make_var_for(task_id, res_id, SPIN_BLOCKING);
-		return var_for_key(k.raw);
+		k.make_var_for(task_id, res_id, vtype);
+		if (task_id < num_tasks)
+			return var_for_slot(vtype * num_tasks + task_id, res_id, k.raw);
+		else
+			return var_for_key(k.raw);
 	}
 
-	unsigned int arrival(unsigned int task_id, unsigned int res_id)
+public:
+	SpinVarMapper(const ResourceSharingInfo& info)
+		: num_tasks(info.get_tasks().size())
 	{
-		lookup_key_t k;
+		set_num_blocks(NUM_VARIABLE_TYPES * num_tasks);
+	}
+
+	unsigned int spin(unsigned int task_id, unsigned int res_id)
+	{
+		return var_for(task_id, res_id, SPIN_BLOCKING);
+	}
 
-		k.make_var_for(task_id, res_id, ARRIVAL_BLOCKING);
-		return var_for_key(k.raw);
+	unsigned int arrival(unsigned int task_id, unsigned int res_id)
+	{
+		return var_for(task_id, res_id, ARRIVAL_BLOCKING);
 	}
 
     unsigned int indicator_arrival(unsigned int res_id)
 	{
-		lookup_key_t k;
-
-		k.make_var_for(0, res_id, INDICATOR_ARRIVAL_BLOCKING);
-		return var_for_key(k.raw);
+		return var_for(0, res_id, INDICATOR_ARRIVAL_BLOCKING);
 	}
 
     unsigned int cancellations(unsigned int task_id, unsigned int res_id)
 	{
-		lookup_key_t k;
-
-		k.make_var_for(task_id, res_id, CANCELLATIONS);
-		return var_for_key(k.raw);
+		return var_for(task_id, res_id, CANCELLATIONS);
 	}
 
 	std::string key2str(uint64_t key, unsigned int var) const;
@@ -112,6 +124,16 @@ protected:
 
 	const std::set<unsigned int> all_resources;
 
+	// If set, the arrival blocking indicators A_q are not declared binary,
+	// which yields an LP whose (safe) bound is cheaper to compute.
+	const bool integer_relaxation;
+
+	// Extra constraints for speed-up: bounds on the objective, e.g., from
+	// a relaxed solution (blocking_UB = 0: none)
+	void add_blocking_lower_and_upper_bound(unsigned long blocking_LB,
+	                                        unsigned long blocking_UB);
+	void add_blocking_objective_terms(double sign);
+
 	// Hack that may be needed in derived classes if some
 	// constraints need to reference member fields that are not yet initialized
 	// during object construction.
@@ -155,7 +177,8 @@ public:
 		const ResourceSharingInfo& info,
 		analysis_type_t analysis_type,
 		unsigned long interval_length,
-        unsigned int cluster);
+        unsigned int cluster,
+		bool relax = false);
 
 	unsigned long solve(bool verbose = false);
 };
@@ -1,6 +1,9 @@
 #ifndef MATH_HELPER_H
 #define MATH_HELPER_H
 
+#include <algorithm>
+#include <functional>
+
 #include "time-types.h"
 
 static inline unsigned long divide_with_ceil(unsigned long numer,
@@ -20,6 +23,8 @@ static inline unsigned long divide_with_floor(unsigned long numer,
 	return (numer / denom);
 }
 
+#ifdef CONFIG_PURE_GMP_TIME
+
 static inline integral_t divide_with_ceil(const integral_t &numer,
 					  const integral_t &denom)
 {
@@ -36,5 +41,61 @@ static inline integral_t round_up(const fractional_t &f)
 	return result;
 }
 
+#else
+
+static inline integral_t divide_with_ceil(const integral_t &numer,
+					  const integral_t &denom)
+{
+	return ceil_div(numer, denom);
+}
+
+
+static inline integral_t round_up(const fractional_t &f)
+{
+	return f.ceil();
+}
+
+#endif
+
+/* Adds the k largest of the n values vals[0..n-1] to sum, which is what
+ * the G-EDF tests need to bound the carry-in interference. Selection takes
+ * linear time instead of sorting. words (n longs) is scratch space for
+ * the common case that all values fit into machine words; otherwise the
+ * pointers in ptr (a permutation of &vals[0..n-1]) are reordered. */
+static inline void add_largest(integral_t &sum, unsigned int k,
+			       const integral_t *vals, unsigned int n,
+			       integral_t **ptr, long *words)
+{
+	if (k >= n) {
+		for (unsigned int i = 0; i < n; i++)
+			sum += vals[i];
+		return;
+	}
+	if (!k)
+		return;
+
+	bool fits = true;
+	for (unsigned int i = 0; fits && i < n; i++) {
+		fits = vals[i].fits_slong_p();
+		if (fits)
+			words[i] = vals[i].get_si();
+	}
+
+	if (fits) {
+		std::nth_element(words, words + k - 1, words + n,
+				 std::greater<long>());
+		/* accumulate in a wide type; the sum of k longs may overflow */
+		integral_t total = 0;
+		for (unsigned int i = 0; i < k; i++)
+			total += words[i];
+		sum += total;
+	} else {
+		std::nth_element(ptr, ptr + k - 1, ptr + n,
+				 [](const integral_t *a, const integral_t *b)
+				 { return *b < *a; });
+		for (unsigned int i = 0; i < k; i++)
+			sum += *ptr[i];
+	}
+}
 
 #endif
@@ -0,0 +1,65 @@
+#ifndef MEMO_H
+#define MEMO_H
+
+#ifndef SWIG
+#include "tasks.h"
+#include "schedulability.h"
+#endif
+
+class MemoTable;
+
+/* Remembers the results of another test and answers from them whenever
+ * they settle the outcome for a new task set. This relies on the wrapped
+ * test being sustainable with regard to execution costs, as the G-EDF
+ * tests are: a task set whose tasks have the same periods, deadlines,
+ * suspensions, and tardiness thresholds as those of an accepted task set,
+ * and no larger WCETs, is accepted as well. Conversely, one with no
+ * smaller WCETs than those of a rejected task set is rejected. Tasks are
+ * matched irrespective of their order.
+ *
+ * This avoids most re-evaluations when the same base task set is tested
+ * again and again with WCETs inflated by varying overheads. Only definite
+ * results are remembered, never those of calls that ran out of budget or
+ * hit the test's built-in limits, so remembering does not change any
+ * result. Task sets that fail the feasibility precondition (e.g., have a
+ * zero WCET) are always passed on to the test.
+ * For each combination of timing parameters, only the maximal accepted and
+ * minimal rejected WCET vectors are kept, at most max_entries of each
+ * (oldest first out). Once results for more than max_groups combinations
+ * have been stored, everything is forgotten.
+ *
+ * The table is shared by all threads that call the test concurrently.
+ */
+class MemoizedTest : public SchedulabilityTest
+{
+  private:
+    SchedulabilityTest *test; // not owned
+    MemoTable *table;
+
+    // no copies
+    MemoizedTest(const MemoizedTest &);
+    MemoizedTest& operator=(const MemoizedTest &);
+
+  public:
+    MemoizedTest(SchedulabilityTest *test,
+                 unsigned int max_entries = 16,
+                 unsigned int max_groups = 100000);
+
+    ~MemoizedTest();
+
+    bool is_schedulable(const TaskSet &ts, bool check_preconditions = true);
+
+    sched_result_t check(const TaskSet &ts, Budget &budget,
+                         bool check_preconditions = true);
+
+    sched_result_t check_default_limits(const TaskSet &ts,
+                                        bool check_preconditions = true);
+
+    void clear();
+
+    // calls answered from the table and calls passed on to the test
+    unsigned long get_hits() const;
+    unsigned long get_misses() const;
+};
+
+#endif
@@ -0,0 +1,99 @@
+#ifndef OBJECT_POOL_H
+#define OBJECT_POOL_H
+
+#include <vector>
+#include <new>
+#include <utility>
+
+/* Pool of objects of type T that are created and destroyed at a high rate
+ * during a simulation run (e.g., per-job events). Storage is allocated in
+ * chunks and recycled through a free list, so that a long run does not
+ * call malloc/free once per object. clear() destroys all objects that are
+ * still alive and makes their storage available again; the memory itself
+ * is returned only when the pool is destroyed.
+ */
+template <typename T, unsigned int CHUNK_SIZE = 256>
+class ObjectPool
+{
+  private:
+    struct Slot
+    {
+        alignas(T) char storage[sizeof(T)];
+        Slot *next_free;
+        bool live;
+
+        T* object()
+        {
+            return reinterpret_cast<T*>(storage);
+        }
+    };
+
+    std::vector<Slot*> chunks;
+    Slot *free_list;
+
+    void add_chunk()
+    {
+        Slot *chunk = static_cast<Slot*>(
+            ::operator new(sizeof(Slot) * CHUNK_SIZE));
+        for (unsigned int i = 0; i < CHUNK_SIZE; i++)
+        {
+            chunk[i].live = false;
+            chunk[i].next_free = i + 1 < CHUNK_SIZE ? chunk + i + 1 : free_list;
+        }
+        free_list = chunk;
+        chunks.push_back(chunk);
+    }
+
+    static Slot* slot_of(T *obj)
+    {
+        // storage is the first member of Slot
+        return reinterpret_cast<Slot*>(obj);
+    }
+
+    // no copies
+    ObjectPool(const ObjectPool &);
+    ObjectPool& operator=(const ObjectPool &);
+
+  public:
+    ObjectPool() : free_list(NULL) {}
+
+    ~ObjectPool()
+    {
+        clear();
+        for (unsigned int i = 0; i < chunks.size(); i++)
+            ::operator delete(chunks[i]);
+    }
+
+    template <typename... Args>
+    T* create(Args&&... args)
+    {
+        if (!free_list)
+            add_chunk();
+        Slot *slot = free_list;
+        T *obj = new (slot->storage) T(std::forward<Args>(args)...);
+        free_list = slot->next_free;
+        slot->live = true;
+        return obj;
+    }
+
+    // obj must have been returned by create() of this pool
+    void destroy(T *obj)
+    {
+        Slot *slot = slot_of(obj);
+        obj->~T();
+        slot->live = false;
+        slot->next_free = free_list;
+        free_list = slot;
+    }
+
+    // destroy all live objects
+    void clear()
+    {
+        for (unsigned int c = 0; c < chunks.size(); c++)
+            for (unsigned int i = 0; i < CHUNK_SIZE; i++)
+                if (chunks[c][i].live)
+                    destroy(chunks[c][i].object());
+    }
+};
+
+#endif
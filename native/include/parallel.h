@@ -0,0 +1,184 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+
+// number of hardware threads (at least one)
+static inline unsigned int default_thread_count()
+{
+	unsigned int n = std::thread::hardware_concurrency();
+	return n ? n : 1;
+}
+
+// Seed of the index-th random stream derived from seed (SplitMix64
+// finalizer), so that neighboring streams are decorrelated and results
+// do not depend on which thread processes which item.
+static inline unsigned long mix_seed(unsigned long seed, unsigned long index)
+{
+	unsigned long z = seed + (index + 1) * 0x9E3779B97F4A7C15UL;
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9UL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBUL;
+	return z ^ (z >> 31);
+}
+
+/* Work-stealing loop over the items 0 ... num_items-1.
+ *
+ * Each worker starts out with a contiguous range of items, which it
+ * processes front to back. A worker that runs out of work steals the upper
+ * half of the largest remaining range of another worker. This balances
+ * items whose costs differ by orders of magnitude without any central
+ * queue.
+ *
+ * fn(worker, item) is called exactly once per item. Calls for different
+ * items may run concurrently, but a given worker index is never used by
+ * two threads at the same time, so fn may keep per-worker state indexed by
+ * worker (0 <= worker < num_threads). If num_threads is zero,
+ * default_thread_count() workers are used. With one worker, all items are
+ * processed in order on the calling thread.
+ */
+class WorkStealingRanges
+{
+  private:
+	struct Range
+	{
+		std::mutex lock;
+		unsigned long begin, end;
+		// keep ranges of different workers in separate cache lines
+		char padding[64];
+	};
+
+	std::vector<Range> ranges;
+
+	bool take(unsigned int worker, unsigned long &item)
+	{
+		Range &r = ranges[worker];
+		std::lock_guard<std::mutex> guard(r.lock);
+		if (r.begin == r.end)
+			return false;
+		item = r.begin++;
+		return true;
+	}
+
+	unsigned long remaining(unsigned int worker)
+	{
+		Range &r = ranges[worker];
+		std::lock_guard<std::mutex> guard(r.lock);
+		return r.end - r.begin;
+	}
+
+	bool steal(unsigned int thief)
+	{
+		for (;;)
+		{
+			// pick the victim with the most remaining work
+			unsigned int victim = thief;
+			unsigned long most = 0;
+			for (unsigned int i = 0; i < ranges.size(); i++)
+			{
+				unsigned long left = i != thief ? remaining(i) : 0;
+				if (left > most)
+				{
+					victim = i;
+					most = left;
+				}
+			}
+			if (victim == thief)
+				return false;
+
+			unsigned long begin, end;
+			{
+				Range &v = ranges[victim];
+				std::lock_guard<std::mutex> guard(v.lock);
+				if (v.begin == v.end)
+					continue; // lost the race, look again
+				// upper half, rounded up: a single item moves entirely
+				end   = v.end;
+				begin = v.begin + (v.end - v.begin) / 2;
+				v.end = begin;
+			}
+
+			Range &r = ranges[thief];
+			std::lock_guard<std::mutex> guard(r.lock);
+			r.begin = begin;
+			r.end   = end;
+			return true;
+		}
+	}
+
+	template <typename Func>
+	void work(unsigned int worker, Func &fn)
+	{
+		unsigned long item;
+		do
+		{
+			while (take(worker, item))
+				fn(worker, item);
+		} while (steal(worker));
+	}
+
+  public:
+	WorkStealingRanges(unsigned long num_items, unsigned int num_threads)
+		: ranges(num_threads)
+	{
+		for (unsigned int i = 0; i < num_threads; i++)
+		{
+			ranges[i].begin = num_items * i / num_threads;
+			ranges[i].end   = num_items * (i + 1) / num_threads;
+		}
+	}
+
+	// at_thread_exit() is called by each spawned thread when it is done
+	template <typename Func, typename Exit>
+	void run(Func &fn, Exit &at_thread_exit)
+	{
+		std::vector<std::thread> threads;
+		for (unsigned int i = 1; i < ranges.size(); i++)
+			threads.push_back(std::thread([this, i, &fn, &at_thread_exit]
+				{
+					work(i, fn);
+					at_thread_exit();
+				}));
+		// the calling thread is worker 0
+		work(0, fn);
+		for (unsigned int i = 0; i < threads.size(); i++)
+			threads[i].join();
+	}
+
+	template <typename Func>
+	void run(Func &fn)
+	{
+		auto nothing = [] {};
+		run(fn, nothing);
+	}
+};
+
+// at_thread_exit() is called on each thread other than the calling thread
+// before it terminates, e.g., to release thread-local library state
+template <typename Func, typename Exit>
+void parallel_for(unsigned long num_items, unsigned int num_threads, Func fn,
+                  Exit at_thread_exit)
+{
+	if (!num_threads)
+		num_threads = default_thread_count();
+	if (num_threads > num_items)
+		num_threads = num_items ? num_items : 1;
+
+	if (num_threads == 1)
+		for (unsigned long i = 0; i < num_items; i++)
+			fn(0, i);
+	else
+	{
+		WorkStealingRanges ranges(num_items, num_threads);
+		ranges.run(fn, at_thread_exit);
+	}
+}
+
+template <typename Func>
+void parallel_for(unsigned long num_items, unsigned int num_threads, Func fn)
+{
+	parallel_for(num_items, num_threads, fn, [] {});
+}
+
+#endif
@@ -0,0 +1,152 @@
+#ifndef PARTITION_H
+#define PARTITION_H
+
+#ifndef SWIG
+#include <vector>
+
+#include "tasks.h"
+#endif
+
+class IncrementalQPA;
+
+/* Decides whether a task may be assigned to a bin (i.e., a processor)
+ * during partitioning. Tasks are identified by their index in the task set
+ * passed to reset(); bins are numbered 0 ... num_bins-1.
+ */
+class PartitionFitTest
+{
+  public:
+    virtual ~PartitionFitTest() {}
+
+    // start over with num_bins empty bins
+    virtual void reset(const TaskSet &ts, unsigned int num_bins) = 0;
+
+    // Assign the task to the bin if the bin remains schedulable;
+    // returns whether it was assigned.
+    virtual bool try_assign(unsigned int task, unsigned int bin) = 0;
+
+    // undo the most recent successful try_assign() for the bin
+    virtual void unassign_last(unsigned int bin) = 0;
+
+    // Size of the task: the sort key of the decreasing heuristics and the
+    // load that the best/worst fit heuristics use to order the bins.
+    virtual void get_size(unsigned int task, fractional_t &size) const = 0;
+};
+
+// total utilization of each bin at most capacity
+class UtilizationFit : public PartitionFitTest
+{
+  private:
+    fractional_t capacity;
+    std::vector<fractional_t> sizes;
+    std::vector<fractional_t> loads;
+    std::vector<std::vector<unsigned int> > assigned;
+
+  protected:
+    virtual void get_exact_size(const Task &tsk, fractional_t &size) const;
+
+  public:
+    UtilizationFit(unsigned long capacity_num = 1,
+                   unsigned long capacity_denom = 1)
+    {
+        capacity  = capacity_num;
+        capacity /= capacity_denom;
+    }
+
+    void reset(const TaskSet &ts, unsigned int num_bins);
+    bool try_assign(unsigned int task, unsigned int bin);
+    void unassign_last(unsigned int bin);
+    void get_size(unsigned int task, fractional_t &size) const;
+};
+
+// total density, wcet / min(deadline, period), of each bin at most capacity
+class DensityFit : public UtilizationFit
+{
+  protected:
+    void get_exact_size(const Task &tsk, fractional_t &size) const;
+
+  public:
+    DensityFit(unsigned long capacity_num = 1,
+               unsigned long capacity_denom = 1)
+        : UtilizationFit(capacity_num, capacity_denom)
+    {}
+};
+
+// exact uniprocessor EDF test, using one IncrementalQPA per bin
+class QPAFit : public PartitionFitTest
+{
+  private:
+    const TaskSet *tasks;
+    std::vector<IncrementalQPA*> bins;
+
+    void clear();
+
+    // no copies
+    QPAFit(const QPAFit &);
+    QPAFit& operator=(const QPAFit &);
+
+  public:
+    QPAFit() : tasks(0) {}
+    ~QPAFit();
+
+    void reset(const TaskSet &ts, unsigned int num_bins);
+    bool try_assign(unsigned int task, unsigned int bin);
+    void unassign_last(unsigned int bin);
+    void get_size(unsigned int task, fractional_t &size) const;
+};
+
+enum partition_heuristic_t
+{
+    NEXT_FIT,
+    FIRST_FIT,
+    BEST_FIT,         // fitting bin with the highest load
+    WORST_FIT,        // fitting bin with the lowest load
+    ALMOST_WORST_FIT  // fitting bin with the second-lowest load value
+};
+
+/* Bin-packing heuristics of schedcat.mapping.binpack over a TaskSet, with
+ * a pluggable fit test. The decreasing variants consider the tasks in
+ * order of decreasing size (ties in task set order); otherwise, tasks are
+ * considered in task set order. Ties between bins of equal load are broken
+ * in favor of the lower bin index.
+ *
+ * partition() starts by resetting the fit test, which afterwards holds the
+ * resulting bins.
+ */
+class Partitioner
+{
+  private:
+    partition_heuristic_t heuristic;
+    bool decreasing;
+
+    // bin of each task, or -1 if it did not fit anywhere
+    std::vector<int> assignment;
+    unsigned int num_misfits;
+
+  public:
+    Partitioner(partition_heuristic_t heuristic = FIRST_FIT,
+                bool decreasing = false)
+        : heuristic(heuristic), decreasing(decreasing), num_misfits(0)
+    {}
+
+    // Returns true if all tasks were assigned to some bin.
+    bool partition(const TaskSet &ts, unsigned int num_bins,
+                   PartitionFitTest &fit);
+
+    unsigned int get_task_count() const
+    {
+        return assignment.size();
+    }
+
+    int get_assignment(unsigned int task) const
+    {
+        return assignment[task];
+    }
+
+    unsigned int get_misfit_count() const
+    {
+        return num_misfits;
+    }
+};
+
+#endif
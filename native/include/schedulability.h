@@ -1,12 +1,36 @@
 #ifndef SCHEDULABILITY_H
 #define SCHEDULABILITY_H
 
+#include "budget.h"
+
 class SchedulabilityTest
 {
   public:
     virtual bool is_schedulable(const TaskSet &ts,
                                 bool check_preconditions = true) = 0;
 
+    /* Like is_schedulable(), but bounded by the given budget instead of
+     * the test's built-in limits (if any). Tests that are cheap enough to
+     * always run to completion ignore the budget.
+     */
+    virtual sched_result_t check(const TaskSet &ts, Budget &budget,
+                                 bool check_preconditions = true)
+    {
+        return is_schedulable(ts, check_preconditions) ?
+            SCHED_SCHEDULABLE : SCHED_UNSCHEDULABLE;
+    }
+
+    /* Same result as is_schedulable() with the test's built-in limits,
+     * but tells whether the test gave up (SCHED_UNKNOWN) rather than
+     * rejecting the task set.
+     */
+    virtual sched_result_t check_default_limits(const TaskSet &ts,
+                                                bool check_preconditions = true)
+    {
+        return is_schedulable(ts, check_preconditions) ?
+            SCHED_SCHEDULABLE : SCHED_UNSCHEDULABLE;
+    }
+
     virtual ~SchedulabilityTest() {};
 };
 
@@ -3,9 +3,11 @@
 
 #include "tasks.h"
 #include "event.h"
+#include "indexed-heap.h"
 #include <vector>
 #include <queue>
 #include <algorithm>
+#include <functional>
 
 typedef unsigned long simtime_t;
 
@@ -105,12 +107,17 @@ class PeriodicJobSequenceTemplate : public SimJob
 
 typedef PeriodicJobSequenceTemplate<SimJob, Task> PeriodicJobSequence;
 
+// Ties are broken in favor of the task that comes first in the task set,
+// so that the schedule does not depend on the order of events.
 class EarliestDeadlineFirst {
   public:
     bool operator()(const Job* a, const Job* b)
     {
         if (a && b)
-            return a->get_deadline() > b->get_deadline();
+            return a->get_deadline() > b->get_deadline()
+                || (a->get_deadline() == b->get_deadline()
+                    && std::less<const Task*>()(&b->get_task(),
+                                                &a->get_task()));
         else if (b && !a)
             return true;
         else
@@ -171,8 +178,46 @@ class GlobalScheduler : public ScheduleSimulation
                                 std::vector<Job*>,
                                 JobPriority > ReadyQueue;
 
+    static const simtime_t NEVER = ~0UL;
+
+    // processors with the earliest completion first; ties by index
+    class ByCompletion
+    {
+        const simtime_t* completion;
+
+      public:
+        ByCompletion(const simtime_t* c) : completion(c) {}
+
+        bool operator()(unsigned int a, unsigned int b)
+        {
+            return completion[a] < completion[b] ||
+                (completion[a] == completion[b] && a < b);
+        }
+    };
+
+    // processors in the order in which they are preempted (idle ones
+    // first, then those with the lowest-priority jobs); ties by index
+    class ByPreemptionOrder
+    {
+        const Processor* processors;
+        PreemptionOrderTemplate<JobPriority, Processor> first_to_preempt;
+
+      public:
+        ByPreemptionOrder(const Processor* p) : processors(p) {}
+
+        bool operator()(unsigned int a, unsigned int b)
+        {
+            if (first_to_preempt(processors[a], processors[b]))
+                return true;
+            else if (first_to_preempt(processors[b], processors[a]))
+                return false;
+            else
+                return a < b;
+        }
+    };
+
   private:
-    EventQueue events;
+    RadixEventQueue<simtime_t> events;
     ReadyQueue pending;
     simtime_t  current_time;
 
@@ -180,43 +225,58 @@ class GlobalScheduler : public ScheduleSimulation
     int num_procs;
     bool preemptive;
 
-    JobPriority                   lower_prio;
-    PreemptionOrderTemplate<JobPriority, Processor>  first_to_preempt;
+    // The allocation of a scheduled job is updated only when it completes
+    // or is preempted, so that advancing time touches only processors
+    // with completing jobs.
+    simtime_t* dispatched; // when the current job was scheduled
+    simtime_t* completion; // when it completes, or NEVER if idle
 
-    Event<simtime_t> dummy;
+    IndexedHeap<ByCompletion>      by_completion;
+    IndexedHeap<ByPreemptionOrder> by_preemption_order;
+
+    JobPriority                   lower_prio;
 
     bool aborted;
 
   private:
 
-    void advance_time(simtime_t until)
+    simtime_t next_completion() const
     {
-        simtime_t last = current_time;
+        return completion[by_completion.top()];
+    }
 
+    void advance_time(simtime_t until)
+    {
         current_time = until;
 
-        // 1) advance time until next event (job completion or event)
-        for (int i = 0; i < num_procs; i++)
-            if (processors[i].advance_time(current_time - last))
-            {
-                // process job completion
-                Job* sched = processors[i].get_scheduled();
-                processors[i].idle();
-                // notify simulation callback
-                job_completed(i, sched);
-                // nofity job callback
-                sched->completed(current_time, i);
-            }
+        // 1) process job completions, in order of processor index
+        while (next_completion() <= current_time)
+        {
+            int i = by_completion.top();
+            Job* sched = processors[i].get_scheduled();
+
+            sched->increase_allocation(completion[i] - dispatched[i]);
+            processors[i].idle();
+            completion[i] = NEVER;
+            by_completion.update(i);
+            by_preemption_order.update(i);
+
+            // notify simulation callback
+            job_completed(i, sched);
+            // nofity job callback
+            sched->completed(current_time, i);
+        }
 
         // 2) process any pending events
         while (!events.empty())
         {
-            const Timeout<simtime_t>& next_event = events.top();
+            Timeout<simtime_t> next_event = events.top();
 
             if (next_event.time() <= current_time)
             {
-                next_event.event().fire(current_time);
+                // pop first: the handler may add events
                 events.pop();
+                next_event.event().fire(current_time);
             }
             else
                 // no more expired events
@@ -228,12 +288,8 @@ class GlobalScheduler : public ScheduleSimulation
         while (!pending.empty() && !all_checked)
         {
             Job* highest_prio = pending.top();
-            Processor* lowest_prio_proc;
-
-            lowest_prio_proc = std::min_element(processors,
-                                                processors + num_procs,
-                                                first_to_preempt);
-            Job* scheduled = lowest_prio_proc->get_scheduled();
+            int proc = by_preemption_order.top();
+            Job* scheduled = processors[proc].get_scheduled();
 
             if ((!scheduled || preemptive) // don't preempt a running job if !preemptive
                 && lower_prio(scheduled, highest_prio))
@@ -241,23 +297,25 @@ class GlobalScheduler : public ScheduleSimulation
                 // do a preemption
                 pending.pop();
 
+                if (scheduled)
+                    scheduled->increase_allocation(current_time -
+                                                   dispatched[proc]);
 
                 // schedule
-                lowest_prio_proc->schedule(highest_prio);
+                processors[proc].schedule(highest_prio);
+                dispatched[proc] = current_time;
+                completion[proc] = current_time +
+                    highest_prio->remaining_demand();
+                by_completion.update(proc);
+                by_preemption_order.update(proc);
 
                 // notify simulation callback
-                job_scheduled(lowest_prio_proc - processors,
+                job_scheduled(proc,
                               scheduled,
                               highest_prio);
                 if (scheduled && !scheduled->is_complete())
                     // add back into the pending queue
                     pending.push(scheduled);
-
-                // schedule job completion event
-                Timeout<simtime_t> ev(highest_prio->remaining_demand() +
-                                      current_time,
-                                      &dummy);
-                events.push(ev);
             }
             else
                 all_checked = true;
@@ -266,17 +324,28 @@ class GlobalScheduler : public ScheduleSimulation
 
   public:
     GlobalScheduler(int num_procs, bool preemptive = true)
+        : processors(new Processor[num_procs]),
+          dispatched(new simtime_t[num_procs]),
+          completion(new simtime_t[num_procs]),
+          by_completion(num_procs, ByCompletion(completion)),
+          by_preemption_order(num_procs, ByPreemptionOrder(processors))
     {
         aborted = false;
         current_time = 0;
         this->num_procs = num_procs;
         this->preemptive = preemptive;
-        processors = new Processor[num_procs];
+        for (int i = 0; i < num_procs; i++)
+        {
+            dispatched[i] = 0;
+            completion[i] = NEVER;
+        }
     }
 
     virtual ~GlobalScheduler()
     {
         delete [] processors;
+        delete [] dispatched;
+        delete [] completion;
     }
 
     simtime_t get_current_time() { return current_time; }
@@ -287,8 +356,10 @@ class GlobalScheduler : public ScheduleSimulation
     {
         while (current_time <= end_of_simulation &&
                !aborted &&
-               !events.empty()) {
-            simtime_t next = events.top().time();
+               (!events.empty() || next_completion() != NEVER)) {
+            simtime_t next = next_completion();
+            if (!events.empty())
+                next = std::min(next, events.top().time());
             advance_time(next);
         }
     }
@@ -307,8 +378,7 @@ class GlobalScheduler : public ScheduleSimulation
         if (job->get_release() >= current_time)
         {
             // schedule future release
-            Timeout<simtime_t> rel(job->get_release(), job);
-            events.push(rel);
+            events.push(job->get_release(), job);
         }
         else
             add_ready(job);
@@ -3,6 +3,10 @@
 
 #include "sharedres_types.h"
 
+#ifndef SWIG
+#include "partition.h"
+#endif
+
 // spinlocks
 
 BlockingBounds* task_fair_mutex_bounds(const ResourceSharingInfo& info,
@@ -72,6 +76,37 @@ unsigned long get_EDF_arrival_blocking(const ResourceSharingInfo& info, unsigned
 
 bool pedf_msrp_classic_is_schedulable(const ResourceSharingInfo& info, unsigned int num_cpus);
 
+/* Partitioning fit test for P-EDF with the MSRP: a task fits if all tasks
+ * assigned so far pass pedf_msrp_classic_is_schedulable(). Since remote
+ * blocking couples the bins, every placement re-checks the whole system.
+ *
+ * Task i of the task set being partitioned issues the requests of the i-th
+ * task in info and has its locking priority and response-time bound (e.g.,
+ * its deadline, as in get_cpp_model(use_task_deadline=True)); clusters in
+ * info are ignored.
+ */
+class MSRPPartitionFit : public PartitionFitTest
+{
+  private:
+	const ResourceSharingInfo& info;
+	const TaskSet* tasks;
+	unsigned int num_cpus;
+	std::vector<int> cluster;
+	std::vector<std::vector<unsigned int> > assigned;
+
+	bool is_schedulable() const;
+
+  public:
+	MSRPPartitionFit(const ResourceSharingInfo& info)
+		: info(info), tasks(0), num_cpus(0)
+	{}
+
+	void reset(const TaskSet& ts, unsigned int num_bins);
+	bool try_assign(unsigned int task, unsigned int bin);
+	void unassign_last(unsigned int bin);
+	void get_size(unsigned int task, fractional_t& size) const;
+};
+
 // Still missing:
 // ==============
 
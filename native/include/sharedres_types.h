@@ -508,6 +508,12 @@ public:
 		remote[tsk_index] = inf;
 	}
 
+	Interference get_raw_local_blocking(unsigned int tsk_index) const
+	{
+		assert( tsk_index < local.size() );
+		return local[tsk_index];
+	}
+
 	unsigned long get_local_blocking(unsigned int tsk_index) const
 	{
 		assert( tsk_index < local.size() );
@@ -527,6 +533,12 @@ public:
 		local[tsk_index] = inf;
 	}
 
+	Interference get_raw_arrival_blocking(unsigned int tsk_index) const
+	{
+		assert( tsk_index < arrival.size() );
+		return arrival[tsk_index];
+	}
+
 	unsigned long get_arrival_blocking(unsigned int tsk_index) const
 	{
 		assert( tsk_index < arrival.size() );
@@ -0,0 +1,151 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#ifndef SWIG
+#include <vector>
+
+#include "tasks.h"
+#include "schedulability.h"
+#include "batch.h"
+#endif
+
+/* Random implicit-deadline task sets, generated like
+ * schedcat.generator.tasks.TaskGenerator does with uniform period and
+ * utilization distributions: tasks with periods drawn uniformly from
+ * [min_period, max_period] and utilizations drawn uniformly from
+ * [min_util, max_util] are added until the target utilization is reached.
+ * The task that would exceed the target is dropped, or if squeeze is set,
+ * shrunk to fit exactly.
+ *
+ * Each task set is a function of the seed only, which keeps sweeps
+ * reproducible independently of how work is distributed across threads.
+ */
+class TaskSetGenerator
+{
+  private:
+    unsigned long min_period, max_period;
+    double min_util, max_util;
+    bool squeeze;
+
+  public:
+    TaskSetGenerator(unsigned long min_period, unsigned long max_period,
+                     double min_util, double max_util,
+                     bool squeeze = false)
+        : min_period(min_period), max_period(max_period),
+          min_util(min_util), max_util(max_util), squeeze(squeeze)
+    {}
+
+    void generate(double target_util, unsigned long seed, TaskSet &ts) const;
+};
+
+/* Evaluates a list of schedulability tests on many task sets using all
+ * cores and aggregates the outcomes per utilization bucket.
+ *
+ * Task set costs vary by orders of magnitude, so task sets are distributed
+ * among the worker threads by work stealing. All tests must be reentrant,
+ * i.e., is_schedulable() must not modify the test object. This holds for
+ * all tests in src/edf.
+ *
+ * A task set with total utilization U falls into bucket
+ * floor(U / bucket_width). If bucket_width is not positive, all task sets
+ * fall into bucket 0.
+ *
+ * With a budget (see set_budget()), each test call is bounded by a fresh
+ * copy of it on the worker thread, which keeps slow task sets from
+ * stalling a sweep. Calls that run out of budget count as not schedulable
+ * and, separately, as unknown.
+ */
+class SchedulabilitySweep
+{
+  private:
+    // not owned; must outlive run()
+    std::vector<SchedulabilityTest*> tests;
+    double bucket_width;
+    unsigned int num_threads;
+
+    // per bucket
+    std::vector<unsigned long> samples;
+    // per bucket and test: schedulable[bucket * tests.size() + test]
+    std::vector<unsigned long> schedulable;
+    std::vector<unsigned long> unknown;
+
+    Budget budget;
+    bool use_budget;
+
+#ifndef SWIG
+    template <typename Source>
+    void sweep(unsigned long num_task_sets, const Source &source,
+               bool check_preconditions);
+#endif
+
+  public:
+    // num_threads == 0: one per hardware thread
+    SchedulabilitySweep(double bucket_width = 0.05,
+                        unsigned int num_threads = 0)
+        : bucket_width(bucket_width), num_threads(num_threads),
+          use_budget(false)
+    {}
+
+    void set_budget(const Budget &budget)
+    {
+        this->budget = budget;
+        use_budget = true;
+    }
+
+    void add_test(SchedulabilityTest *test)
+    {
+        tests.push_back(test);
+    }
+
+    unsigned int get_test_count() const
+    {
+        return tests.size();
+    }
+
+    // evaluate all task sets in the batch
+    void run(const TaskSetBatch &batch, bool check_preconditions = true);
+
+    // evaluate samples task sets for each target utilization
+    // min_util, min_util + step, ... (up to max_util)
+    void run(const TaskSetGenerator &gen,
+             double min_util, double max_util, double step,
+             unsigned int samples, unsigned long seed = 0,
+             bool check_preconditions = true);
+
+    unsigned int get_bucket_count() const
+    {
+        return samples.size();
+    }
+
+    // lower end of the bucket's utilization range
+    double get_bucket_utilization(unsigned int bucket) const
+    {
+        return bucket * bucket_width;
+    }
+
+    unsigned long get_sample_count(unsigned int bucket) const
+    {
+        return samples[bucket];
+    }
+
+    unsigned long get_schedulable_count(unsigned int bucket,
+                                        unsigned int test) const
+    {
+        return schedulable[bucket * tests.size() + test];
+    }
+
+    // number of task sets on which the test ran out of budget
+    unsigned long get_unknown_count(unsigned int bucket,
+                                    unsigned int test) const
+    {
+        return unknown[bucket * tests.size() + test];
+    }
+
+    double get_schedulable_ratio(unsigned int bucket, unsigned int test) const
+    {
+        return samples[bucket] ?
+            (double) get_schedulable_count(bucket, test) / samples[bucket] : 0;
+    }
+};
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef TASK_COLUMNS_H
+#define TASK_COLUMNS_H
+
+#ifndef SWIG
+#include "tasks.h"
+#endif
+
+/* Columnar (structure-of-arrays) copy of the parameters of a task set,
+ * laid out for vectorized evaluation of demand and request bound functions.
+ *
+ * All parameters are stored as doubles in separate, aligned, and padded
+ * arrays. Integers below 2^52 are represented exactly, and the kernels
+ * below only answer if every intermediate result provably stays in this
+ * range. Otherwise, they return false and the caller has to fall back to
+ * exact integral_t arithmetic.
+ */
+class TaskColumns
+{
+  private:
+    unsigned int count;
+    unsigned int capacity; // padded to a multiple of the vector width
+
+    double *wcet;
+    double *period;
+    double *deadline;
+
+    // running sums for the exactness bound
+    double wcet_sum;
+    double util;
+    bool representable;
+
+    // inputs larger than this cannot be evaluated exactly
+    unsigned long max_time;
+
+    void add_to_sums(double wcet, double period, double deadline);
+    void update_max_time();
+
+    // no copies
+    TaskColumns(const TaskColumns &);
+    TaskColumns& operator=(const TaskColumns &);
+
+  public:
+    // initially room for num_tasks tasks, to be filled with add_task()
+    TaskColumns(unsigned int num_tasks);
+    TaskColumns(const TaskSet &ts);
+    ~TaskColumns();
+
+    void add_task(unsigned long wcet, unsigned long period,
+                  unsigned long deadline);
+    // keeps the order of the remaining tasks
+    void remove_task(unsigned int idx);
+
+    unsigned int get_task_count() const { return count; }
+
+    // Can bound_demand() etc. compute an exact result for time?
+    bool is_exact_at(unsigned long time) const
+    {
+        return representable && time <= max_time;
+    }
+
+    // sum of DBFs: sum_i (floor((time - d_i) / p_i) + 1) * e_i
+    bool bound_demand(unsigned long time, unsigned long &demand) const;
+
+    // sum of RBFs: sum_i ceil(time / p_i) * e_i
+    bool bound_request(unsigned long time, unsigned long &request) const;
+
+    // per-task DBF values
+    bool demand_per_task(unsigned long time, unsigned long *demand) const;
+
+    // per-task carry-in demand: floor(time / p_i) * e_i + min(e_i, time % p_i)
+    bool carry_in_demand_per_task(unsigned long time,
+                                  unsigned long *demand) const;
+
+    // double-precision sums (not exact)
+    double get_utilization() const;
+    double get_density() const;
+};
+
+#endif
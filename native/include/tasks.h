@@ -9,6 +9,7 @@
 #include <math.h>
 
 #include "time-types.h"
+#include "math-helper.h"
 
 #endif
 
@@ -165,7 +166,7 @@ class Task
             approx -= deadline;
             approx *= wcet;
 
-            mpz_cdiv_q_ui(demand.get_mpz_t(), approx.get_mpz_t(), period);
+            demand = divide_with_ceil(approx, period);
 
             demand += wcet;
         }
@@ -209,6 +210,11 @@ class TaskSet
             prio_pt, suspension, tardiness_threshold));
     }
 
+    void remove_task(unsigned int idx)
+    {
+        tasks.erase(tasks.begin() + idx);
+    }
+
     unsigned int get_task_count() const { return tasks.size(); }
 
     Task& operator[](int idx) { return tasks[idx]; }
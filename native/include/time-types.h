@@ -1,6 +1,8 @@
 #ifndef TIME_TYPES_H
 #define TIME_TYPES_H
 
+#ifdef CONFIG_PURE_GMP_TIME
+
 /* include string.h for gmpxx.h */
 #include <string.h>
 #include <gmpxx.h>
@@ -14,4 +16,19 @@ static inline void truncate_fraction(fractional_t &val)
     val.canonicalize();
 }
 
+#else
+
+/* Machine-word arithmetic with GMP fallback on overflow. */
+#include "hybrid-num.h"
+
+typedef HybridInteger integral_t;
+typedef HybridFraction fractional_t;
+
+static inline void truncate_fraction(fractional_t &val)
+{
+    val = val.truncate();
+}
+
+#endif
+
 #endif
@@ -25,5 +25,8 @@
 
 %include "sharedres_types.i"
 
+// base class of MSRPPartitionFit; wrapped in the sched module
+%import "partition.h"
+
 #include "sharedres.h"
 
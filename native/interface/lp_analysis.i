@@ -31,6 +31,8 @@
 
 %include "sharedres_types.i"
 
+%ignore LPSessions::for_task;
+
 %include "lp_analysis.h"
 
 %ignore CriticalSectionsOfTaskset::get_transitive_nesting_relationship;
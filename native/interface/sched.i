@@ -2,6 +2,7 @@
 %{
 #define SWIG_FILE_WITH_INIT
 #include "tasks.h"
+#include "budget.h"
 #include "schedulability.h"
 #include "edf/baker.h"
 #include "edf/gfb.h"
@@ -15,6 +16,10 @@
 #include "edf/gel_pl.h"
 #include "edf/qpa.h"
 #include "edf/la.h"
+#include "batch.h"
+#include "sweep.h"
+#include "memo.h"
+#include "partition.h"
 
 #ifdef CONFIG_HAVE_LP
 #include "apa_feas.h"
@@ -36,10 +41,17 @@
 %ignore TaskSet::get_max_density const;
 %ignore TaskSet::approx_load const;
 
-%ignore QPATest::get_demand(integral_t interval, const TaskSet &ts);
-%ignore QPATest::get_max_interval(const TaskSet &ts, const fractional_t& util);
+%ignore QPATest::get_demand;
+%ignore QPATest::get_max_interval;
+
+%ignore TaskSetBatch::load;
+%apply (const char *STRING, size_t LENGTH) {
+	(const char *offsets, size_t offsets_len),
+	(const char *params, size_t params_len)
+};
 
 #include "tasks.h"
+#include "budget.h"
 #include "schedulability.h"
 #include "edf/baker.h"
 #include "edf/gfb.h"
@@ -53,6 +65,10 @@
 #include "edf/gel_pl.h"
 #include "edf/qpa.h"
 #include "edf/la.h"
+#include "batch.h"
+#include "sweep.h"
+#include "memo.h"
+#include "partition.h"
 
 #ifdef CONFIG_HAVE_LP
 %ignore APAFeasibleSolution::set_fraction;
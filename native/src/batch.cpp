@@ -0,0 +1,117 @@
+#include <cstring>
+
+#include "tasks.h"
+#include "schedulability.h"
+#include "batch.h"
+
+bool TaskSetBatch::load(const unsigned long *offs, unsigned int num_sets,
+                        const unsigned long *prms)
+{
+	if (offs[0] != 0)
+		return false;
+	for (unsigned int i = 0; i < num_sets; i++)
+		if (offs[i + 1] < offs[i])
+			return false;
+
+	offsets.assign(offs, offs + num_sets + 1);
+	params.assign(prms, prms + offsets[num_sets] * TASK_PARAMS);
+	return true;
+}
+
+bool TaskSetBatch::load_packed(const char *offs, size_t offs_len,
+                               const char *prms, size_t prms_len)
+{
+	const size_t word = sizeof(unsigned long);
+
+	if (offs_len < word || offs_len % word || prms_len % word)
+		return false;
+
+	unsigned int num_sets = offs_len / word - 1;
+	std::vector<unsigned long> o(num_sets + 1);
+	std::vector<unsigned long> p(prms_len / word);
+
+	// the buffers need not be aligned
+	memcpy(&o[0], offs, offs_len);
+	if (prms_len)
+		memcpy(&p[0], prms, prms_len);
+
+	if (o[num_sets] * TASK_PARAMS != p.size())
+		return false;
+
+	return load(&o[0], num_sets, p.size() ? &p[0] : NULL);
+}
+
+void TaskSetBatch::add_task_set(const TaskSet &ts)
+{
+	for (unsigned int i = 0; i < ts.get_task_count(); i++)
+	{
+		params.push_back(ts[i].get_wcet());
+		params.push_back(ts[i].get_period());
+		params.push_back(ts[i].get_deadline());
+	}
+	offsets.push_back(offsets.back() + ts.get_task_count());
+}
+
+void TaskSetBatch::get_task_set(unsigned int task_set, TaskSet &ts) const
+{
+	for (unsigned long i = offsets[task_set]; i < offsets[task_set + 1]; i++)
+	{
+		const unsigned long *p = &params[i * TASK_PARAMS];
+		ts.add_task(p[0], p[1], p[2]);
+	}
+}
+
+void BatchSchedulabilityTest::run(const TaskSetBatch &batch,
+                                  bool check_preconditions)
+{
+	num_task_sets = batch.get_task_set_count();
+
+	unsigned long bits = (unsigned long) num_task_sets * tests.size();
+	results.assign((bits + 7) / 8, 0);
+	unknown.assign((bits + 7) / 8, 0);
+
+	unsigned long bit = 0;
+	for (unsigned int i = 0; i < num_task_sets; i++)
+	{
+		TaskSet ts;
+		batch.get_task_set(i, ts);
+
+		for (unsigned int j = 0; j < tests.size(); j++, bit++)
+		{
+			sched_result_t result;
+			if (use_budget)
+			{
+				Budget b = budget;
+				b.reset();
+				result = tests[j]->check(ts, b, check_preconditions);
+			}
+			else if (tests[j]->is_schedulable(ts, check_preconditions))
+				result = SCHED_SCHEDULABLE;
+			else
+				result = SCHED_UNSCHEDULABLE;
+
+			if (result == SCHED_SCHEDULABLE)
+				results[bit / 8] |= 1 << (bit % 8);
+			else if (result == SCHED_UNKNOWN)
+				unknown[bit / 8] |= 1 << (bit % 8);
+		}
+	}
+}
+
+unsigned int BatchSchedulabilityTest::count_schedulable(unsigned int test) const
+{
+	unsigned int count = 0;
+	for (unsigned int i = 0; i < num_task_sets; i++)
+		if (is_schedulable(i, test))
+			count++;
+	return count;
+}
+
+unsigned int BatchSchedulabilityTest::count_unknown(unsigned int test) const
+{
+	unsigned int count = 0;
+	for (unsigned int i = 0; i < num_task_sets; i++)
+		if (is_unknown(i, test))
+			count++;
+	return count;
+}
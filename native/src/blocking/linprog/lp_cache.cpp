@@ -0,0 +1,213 @@
+#include <list>
+#include <mutex>
+
+#include "lp_common.h"
+#include "lp_cache.h"
+
+#include "stl-hashmap.h"
+
+LPCacheKey::LPCacheKey(lp_cache_analysis_t analysis,
+		       const ResourceSharingInfo& info)
+	: info(info), active(get_lp_cache_capacity() > 0),
+	  jobs_in_response(false)
+{
+	if (active)
+	{
+		words.push_back(analysis);
+		// the solver settings may change how the bounds are split
+		words.push_back(get_lp_dense_limit());
+		words.push_back(get_lp_instance_aggregation());
+	}
+}
+
+LPCacheKey::LPCacheKey(lp_cache_analysis_t analysis,
+		       const ResourceSharingInfo& info,
+		       const ResourceLocality& locality)
+	: info(info), active(get_lp_cache_capacity() > 0),
+	  jobs_in_response(false)
+{
+	if (active)
+	{
+		words.push_back(analysis);
+		words.push_back(get_lp_dense_limit());
+		words.push_back(get_lp_instance_aggregation());
+		// only the placement of resources that are actually used matters
+		const unsigned int num_resources = get_resource_id_limit(info);
+		for (unsigned int q = 0; q < num_resources; q++)
+			words.push_back((long) locality[q]);
+	}
+}
+
+std::vector<unsigned long> LPCacheKey::task_key(unsigned int i) const
+{
+	std::vector<unsigned long> key(words);
+	const TaskInfo& ti = info.get_tasks()[i];
+
+	key.push_back(i);
+	key.push_back(info.get_tasks().size());
+	foreach(info.get_tasks(), tx)
+	{
+		key.push_back(tx->get_priority());
+		key.push_back(tx->get_period());
+		key.push_back(tx->get_deadline());
+		if (jobs_in_response && tx->get_id() != i)
+			key.push_back(tx->get_max_num_jobs(ti.get_response()));
+		else
+			key.push_back(tx->get_response());
+		key.push_back(tx->get_cluster());
+		key.push_back(tx->get_cost());
+		key.push_back(tx->get_requests().size());
+		foreach(tx->get_requests(), req)
+		{
+			key.push_back(req->get_resource_id());
+			key.push_back(req->get_num_requests());
+			key.push_back(req->get_request_length());
+			key.push_back(req->get_request_type());
+			key.push_back(req->get_request_priority());
+		}
+	}
+	return key;
+}
+
+static unsigned long hash_key(const std::vector<unsigned long>& key)
+{
+	unsigned long h = key.size();
+	foreach(key, w)
+		h = mix_seed(h, *w);
+	return h;
+}
+
+// the bounds of one task
+struct LPCacheEntry
+{
+	std::vector<unsigned long> key;
+	unsigned long hash;
+	Interference blocking, request_span, arrival, remote, local;
+
+	LPCacheEntry(const std::vector<unsigned long>& k, unsigned long h,
+		     const BlockingBounds& b, unsigned int i)
+		: key(k), hash(h),
+		  blocking(b[i]),
+		  request_span(b.get_max_request_span(i)),
+		  arrival(b.get_raw_arrival_blocking(i)),
+		  remote(b.get_raw_remote_blocking(i)),
+		  local(b.get_raw_local_blocking(i))
+	{}
+
+	void copy_to(BlockingBounds& b, unsigned int i) const
+	{
+		b[i] = blocking;
+		b.raise_request_span(i, request_span);
+		b.set_arrival_blocking(i, arrival);
+		b.set_remote_blocking(i, remote);
+		b.set_local_blocking(i, local);
+	}
+};
+
+// most recently used entry first
+typedef std::list<LPCacheEntry> LPCacheEntries;
+
+static std::mutex cache_lock;
+static LPCacheEntries cache_entries;
+static std::unordered_multimap<unsigned long, LPCacheEntries::iterator> cache_index;
+static unsigned int cache_capacity = 0;
+static unsigned long cache_hits = 0, cache_misses = 0;
+
+static LPCacheEntries::iterator find_entry(const std::vector<unsigned long>& key,
+					   unsigned long hash)
+{
+	auto range = cache_index.equal_range(hash);
+	for (auto it = range.first; it != range.second; it++)
+		if (it->second->key == key)
+			return it->second;
+	return cache_entries.end();
+}
+
+static void evict_entry(LPCacheEntries::iterator entry)
+{
+	auto range = cache_index.equal_range(entry->hash);
+	for (auto it = range.first; it != range.second; it++)
+		if (it->second == entry)
+		{
+			cache_index.erase(it);
+			break;
+		}
+	cache_entries.erase(entry);
+}
+
+bool LPCacheKey::lookup(unsigned int i, BlockingBounds& results) const
+{
+	const std::vector<unsigned long> key = task_key(i);
+	const unsigned long hash = hash_key(key);
+
+	std::lock_guard<std::mutex> guard(cache_lock);
+
+	LPCacheEntries::iterator entry = find_entry(key, hash);
+	if (entry == cache_entries.end())
+	{
+		cache_misses++;
+		return false;
+	}
+
+	cache_hits++;
+	cache_entries.splice(cache_entries.begin(), cache_entries, entry);
+	entry->copy_to(results, i);
+	return true;
+}
+
+void LPCacheKey::insert(unsigned int i, const BlockingBounds& results) const
+{
+	const std::vector<unsigned long> key = task_key(i);
+	const unsigned long hash = hash_key(key);
+
+	std::lock_guard<std::mutex> guard(cache_lock);
+
+	if (!cache_capacity)
+		return;
+
+	LPCacheEntries::iterator entry = find_entry(key, hash);
+	if (entry != cache_entries.end())
+		evict_entry(entry);
+
+	while (cache_entries.size() >= cache_capacity)
+		evict_entry(--cache_entries.end());
+
+	cache_entries.push_front(LPCacheEntry(key, hash, results, i));
+	cache_index.insert(std::make_pair(hash, cache_entries.begin()));
+}
+
+void set_lp_cache_capacity(unsigned int max_entries)
+{
+	std::lock_guard<std::mutex> guard(cache_lock);
+
+	cache_capacity = max_entries;
+	while (cache_entries.size() > cache_capacity)
+		evict_entry(--cache_entries.end());
+}
+
+unsigned int get_lp_cache_capacity()
+{
+	std::lock_guard<std::mutex> guard(cache_lock);
+	return cache_capacity;
+}
+
+void clear_lp_cache()
+{
+	std::lock_guard<std::mutex> guard(cache_lock);
+
+	cache_entries.clear();
+	cache_index.clear();
+	cache_hits = cache_misses = 0;
+}
+
+unsigned long get_lp_cache_hits()
+{
+	std::lock_guard<std::mutex> guard(cache_lock);
+	return cache_hits;
+}
+
+unsigned long get_lp_cache_misses()
+{
+	std::lock_guard<std::mutex> guard(cache_lock);
+	return cache_misses;
+}
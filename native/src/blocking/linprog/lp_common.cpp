@@ -3,6 +3,29 @@
 
 #include "lp_common.h"
 
+static unsigned int lp_num_threads = 1;
+static bool lp_instance_aggregation = false;
+
+void set_lp_num_threads(unsigned int num_threads)
+{
+	lp_num_threads = num_threads;
+}
+
+unsigned int get_lp_num_threads()
+{
+	return lp_num_threads;
+}
+
+void set_lp_instance_aggregation(bool enabled)
+{
+	lp_instance_aggregation = enabled;
+}
+
+bool get_lp_instance_aggregation()
+{
+	return lp_instance_aggregation;
+}
+
 std::string VarMapper::key2str(uint64_t key, unsigned int var) const
 {
 	std::ostringstream buf;
@@ -64,7 +87,10 @@ void set_blocking_objective(
 
 			length = request->get_request_length();
 
-			foreach_request_instance(*request, ti, v)
+			const unsigned int multiplicity =
+				vars.instance_multiplicity(*request, ti);
+
+			foreach_request_instance_var(vars, *request, ti, v)
 			{
 				unsigned int var_id;
 
@@ -74,6 +100,8 @@ void set_blocking_objective(
 					local_obj->add_term(length, var_id);
 				else if (!local && remote_obj)
 					remote_obj->add_term(length, var_id);
+				if (multiplicity > 1)
+					lp.declare_variable_bounds(var_id, true, 0, true, multiplicity);
 
 				var_id = vars.lookup(t, q, v, BLOCKING_INDIRECT);
 				obj->add_term(length, var_id);
@@ -81,6 +109,8 @@ void set_blocking_objective(
 					local_obj->add_term(length, var_id);
 				else if (!local && remote_obj)
 					remote_obj->add_term(length, var_id);
+				if (multiplicity > 1)
+					lp.declare_variable_bounds(var_id, true, 0, true, multiplicity);
 
 				var_id = vars.lookup(t, q, v, BLOCKING_PREEMPT);
 				obj->add_term(length, var_id);
@@ -88,6 +118,8 @@ void set_blocking_objective(
 					local_obj->add_term(length, var_id);
 				else if (!local && remote_obj)
 					remote_obj->add_term(length, var_id);
+				if (multiplicity > 1)
+					lp.declare_variable_bounds(var_id, true, 0, true, multiplicity);
 			}
 		}
 	}
@@ -199,7 +231,7 @@ void add_mutex_constraints(
 		foreach(tx->get_requests(), request)
 		{
 			unsigned int q = request->get_resource_id();
-			foreach_request_instance(*request, ti, v)
+			foreach_request_instance_var(vars, *request, ti, v)
 			{
 				LinearExpression *exp = new LinearExpression();
 				unsigned int var_id;
@@ -213,7 +245,7 @@ void add_mutex_constraints(
 				var_id = vars.lookup(t, q, v, BLOCKING_PREEMPT);
 				exp->add_var(var_id);
 
-				lp.add_inequality(exp, 1);
+				lp.add_inequality(exp, vars.instance_multiplicity(*request, ti));
 			}
 		}
 	}
@@ -235,7 +267,7 @@ void add_topology_constraints(
 		foreach_remote_request(tx->get_requests(), locality, ti, request)
 		{
 			unsigned int q = request->get_resource_id();
-			foreach_request_instance(*request, ti, v)
+			foreach_request_instance_var(vars, *request, ti, v)
 			{
 				unsigned int var_id;
 				var_id = vars.lookup(t, q, v, BLOCKING_PREEMPT);
@@ -286,7 +318,7 @@ void add_local_lower_priority_constraints(
 			// is it a resource local to Ti?
 			if (locality[q] == (int) ti.get_cluster())
 			{
-				foreach_request_instance(*request, ti, v)
+				foreach_request_instance_var(vars, *request, ti, v)
 				{
 					unsigned int var_id;
 					var_id = vars.lookup(t, q, v,
@@ -5,6 +5,7 @@
 #include "stl-hashmap.h"
 
 #include "cpu_time.h"
+#include "lp_cache.h"
 
 // Constraint 5
 // only one blocking request each time a job of T_i
@@ -39,7 +40,7 @@ static void add_fifo_cluster_constraints(
 
 			exp = constraints[c];
 
-			foreach_request_instance(*request, ti, v)
+			foreach_request_instance_var(vars, *request, ti, v)
 			{
 				unsigned int var_id;
 				var_id = vars.lookup(t, q, v, BLOCKING_DIRECT);
@@ -79,7 +80,7 @@ static void add_fifo_resource_constraints(
 			unsigned int q = request->get_resource_id();
 			LinearExpression *exp = new LinearExpression();
 
-			foreach_request_instance(*request, ti, v)
+			foreach_request_instance_var(vars, *request, ti, v)
 			{
 				unsigned int var_id;
 				var_id = vars.lookup(t, q, v, BLOCKING_DIRECT);
@@ -112,8 +113,9 @@ void add_dflp_constraints(
 
 #ifdef CONFIG_MERGED_LINPROGS
 
-static BlockingBounds* _lp_dflp_bounds(const ResourceSharingInfo& info,
-				       const ResourceLocality& locality)
+static BlockingBounds* _lp_dflp_merged_bounds(const ResourceSharingInfo& info,
+					      const ResourceLocality& locality,
+					      LinearProgramSession *session)
 {
 	BlockingBounds *results = new BlockingBounds(info);
 	const unsigned int num_tasks = info.get_tasks().size();
@@ -139,7 +141,9 @@ static BlockingBounds* _lp_dflp_bounds(const ResourceSharingInfo& info,
 	for (unsigned int i = 0; i < num_tasks; i++)
 	{
 		const TaskInfo &ti = info.get_tasks()[i];
-		VarMapper vars = VarMapper(var_idx);
+		VarMapper vars = VarMapper(info, var_idx);
+		if (get_lp_instance_aggregation())
+			vars.aggregate_request_instances();
 
 		set_blocking_objective(vars, info, locality, ti, lp,
 				       local_obj + i, remote_obj + i);
@@ -154,7 +158,7 @@ static BlockingBounds* _lp_dflp_bounds(const ResourceSharingInfo& info,
 #endif
 
 	// Solve the big, combined LP.
-	Solution *sol = linprog_solve(lp, var_idx);
+	const Solution *sol = linprog_solve(lp, var_idx, session);
 
 	assert(sol != NULL);
 
@@ -186,7 +190,8 @@ static BlockingBounds* _lp_dflp_bounds(const ResourceSharingInfo& info,
 	std::cout << total_cost << std::endl;
 #endif
 
-	delete sol;
+	if (!session)
+		delete sol;
 	delete[] local_obj;
 	delete[] remote_obj;
 
@@ -194,16 +199,32 @@ static BlockingBounds* _lp_dflp_bounds(const ResourceSharingInfo& info,
 }
 
 
+static BlockingBounds* _lp_dflp_bounds(const LPCacheKey& key,
+				       const ResourceSharingInfo& info,
+				       const ResourceLocality& locality,
+				       LPSessions *sessions)
+{
+	return cached_lp_bounds(key, [&]()
+	{
+		// the merged LP lives in the first session
+		return _lp_dflp_merged_bounds(info, locality,
+					      sessions ? sessions->for_task(0) : NULL);
+	});
+}
+
 #else // per-task LPs
 
 static void apply_dflp_bounds_for_task(
 	unsigned int i,
 	BlockingBounds& bounds,
 	const ResourceSharingInfo& info,
-	const ResourceLocality& locality)
+	const ResourceLocality& locality,
+	LinearProgramSession *session)
 {
 	LinearProgram lp;
-	VarMapper vars;
+	VarMapper vars(info);
+	if (get_lp_instance_aggregation())
+		vars.aggregate_request_instances();
 	const TaskInfo& ti = info.get_tasks()[i];
 	LinearExpression *local_obj = new LinearExpression();
 
@@ -226,7 +247,7 @@ static void apply_dflp_bounds_for_task(
 	solver_cost.start();
 #endif
 
-	Solution *sol = linprog_solve(lp, vars.get_num_vars());
+	const Solution *sol = linprog_solve(lp, vars.get_num_vars(), session);
 
 #if DEBUG_LP_OVERHEADS >=2
 	solver_cost.stop();
@@ -246,16 +267,22 @@ static void apply_dflp_bounds_for_task(
 	bounds.set_local_blocking(i, local);
 
 	delete local_obj;
-	delete sol;
+	if (!session)
+		delete sol;
 }
 
-static BlockingBounds* _lp_dflp_bounds(const ResourceSharingInfo& info,
-				       const ResourceLocality& locality)
+static BlockingBounds* _lp_dflp_bounds(const LPCacheKey& key,
+				       const ResourceSharingInfo& info,
+				       const ResourceLocality& locality,
+				       LPSessions *sessions)
 {
 	BlockingBounds *results = new BlockingBounds(info);
 
-	for (unsigned int i = 0; i < info.get_tasks().size(); i++)
-		apply_dflp_bounds_for_task(i, *results, info, locality);
+	foreach_uncached_task_in_parallel(key, *results, [&](unsigned int i)
+	{
+		apply_dflp_bounds_for_task(i, *results, info, locality,
+					   sessions ? sessions->for_task(i) : NULL);
+	}, sessions ? 1 : get_lp_num_threads());
 
 	return results;
 }
@@ -263,15 +290,21 @@ static BlockingBounds* _lp_dflp_bounds(const ResourceSharingInfo& info,
 #endif
 
 BlockingBounds* lp_dflp_bounds(const ResourceSharingInfo& info,
-				const ResourceLocality& locality)
+				const ResourceLocality& locality,
+				LPSessions *sessions)
 {
+	LPStatsScope stats(__FUNCTION__);
+
 #if DEBUG_LP_OVERHEADS >= 1
 	static DEFINE_CPU_CLOCK(cpu_costs);
 
 	cpu_costs.start();
 #endif
 
-	BlockingBounds *results = _lp_dflp_bounds(info, locality);
+	LPCacheKey key(LP_CACHE_DFLP, info, locality);
+	key.count_jobs_in_response();
+
+	BlockingBounds *results = _lp_dflp_bounds(key, info, locality, sessions);
 
 #if DEBUG_LP_OVERHEADS >=1
 	cpu_costs.stop();
@@ -8,6 +8,7 @@
 #include "stl-hashmap.h"
 
 #include "cpu_time.h"
+#include "lp_cache.h"
 
 #define NO_WAIT_TIME_BOUND (-1)
 
@@ -145,7 +146,7 @@ static void add_max_wait_time_constraints(
 			if (bounded)
 			{
 				LinearExpression *exp = new LinearExpression();
-				foreach_request_instance(*request, ti, v)
+				foreach_request_instance_var(vars, *request, ti, v)
 				{
 					unsigned int var_id;
 					var_id = vars.lookup(t, q, v, BLOCKING_DIRECT);
@@ -188,7 +189,7 @@ static void add_independent_cluster_constraints(
 			unsigned int q = request->get_resource_id();
 			if (accessed_clusters.count(locality[q]) == 0)
 			{
-				foreach_request_instance(*request, ti, v)
+				foreach_request_instance_var(vars, *request, ti, v)
 				{
 					unsigned int var_id;
 					var_id = vars.lookup(t, q, v, BLOCKING_DIRECT);
@@ -225,7 +226,7 @@ static void add_conflict_set_constraints(
 				// smaller ID <=> higher priority
 				// Priority ceiling is lower than ti's priority,
 				// so it cannot block ti.
-				foreach_request_instance(*request, ti, v)
+				foreach_request_instance_var(vars, *request, ti, v)
 				{
 					unsigned int var_id;
 					var_id = vars.lookup(t, q, v, BLOCKING_DIRECT);
@@ -279,7 +280,7 @@ static void add_atmostonce_lower_prio_constraints(
 
 				exp = constraints[c];
 
-				foreach_request_instance(*request, ti, v)
+				foreach_request_instance_var(vars, *request, ti, v)
 				{
 					unsigned int var_id;
 					var_id = vars.lookup(t, q, v, BLOCKING_DIRECT);
@@ -326,9 +327,10 @@ void add_dpcp_constraints(
 
 #ifdef CONFIG_MERGED_LINPROGS
 
-static BlockingBounds* _lp_dpcp_bounds(const ResourceSharingInfo& info,
-				       const ResourceLocality& locality,
-				       bool use_rta)
+static BlockingBounds* _lp_dpcp_merged_bounds(const ResourceSharingInfo& info,
+					      const ResourceLocality& locality,
+					      bool use_rta,
+					      LinearProgramSession *session)
 {
 	BlockingBounds *results = new BlockingBounds(info);
 	const unsigned int num_tasks = info.get_tasks().size();
@@ -356,7 +358,9 @@ static BlockingBounds* _lp_dpcp_bounds(const ResourceSharingInfo& info,
 	for (unsigned int i = 0; i < num_tasks; i++)
 	{
 		const TaskInfo &ti = info.get_tasks()[i];
-		VarMapper vars = VarMapper(var_idx);
+		VarMapper vars = VarMapper(info, var_idx);
+		if (get_lp_instance_aggregation())
+			vars.aggregate_request_instances();
 
 		set_blocking_objective(vars, info, locality, ti, lp,
 				       local_obj + i, remote_obj + i);
@@ -372,7 +376,7 @@ static BlockingBounds* _lp_dpcp_bounds(const ResourceSharingInfo& info,
 #endif
 
 	// Solve the big, combined LP.
-	Solution *sol = linprog_solve(lp, var_idx);
+	const Solution *sol = linprog_solve(lp, var_idx, session);
 
 	assert(sol != NULL);
 
@@ -404,13 +408,28 @@ static BlockingBounds* _lp_dpcp_bounds(const ResourceSharingInfo& info,
 	std::cout << total_cost << std::endl;
 #endif
 
-	delete sol;
+	if (!session)
+		delete sol;
 	delete[] local_obj;
 	delete[] remote_obj;
 
 	return results;
 }
 
+static BlockingBounds* _lp_dpcp_bounds(const LPCacheKey& key,
+				       const ResourceSharingInfo& info,
+				       const ResourceLocality& locality,
+				       bool use_rta,
+				       LPSessions *sessions)
+{
+	return cached_lp_bounds(key, [&]()
+	{
+		// the merged LP lives in the first session
+		return _lp_dpcp_merged_bounds(info, locality, use_rta,
+					      sessions ? sessions->for_task(0) : NULL);
+	});
+}
+
 #else // per-task LPs
 
 static void apply_dpcp_bounds_for_task(
@@ -419,10 +438,13 @@ static void apply_dpcp_bounds_for_task(
 	const ResourceSharingInfo& info,
 	const ResourceLocality& locality,
 	const PriorityCeilings& prio_ceilings,
-	bool use_rta)
+	bool use_rta,
+	LinearProgramSession *session)
 {
 	LinearProgram lp;
-	VarMapper vars;
+	VarMapper vars(info);
+	if (get_lp_instance_aggregation())
+		vars.aggregate_request_instances();
 	const TaskInfo& ti = info.get_tasks()[i];
 	LinearExpression *local_obj = new LinearExpression();
 
@@ -446,7 +468,7 @@ static void apply_dpcp_bounds_for_task(
 	solver_cost.start();
 #endif
 
-	Solution *sol = linprog_solve(lp, vars.get_num_vars());
+	const Solution *sol = linprog_solve(lp, vars.get_num_vars(), session);
 
 #if DEBUG_LP_OVERHEADS >= 2
 	solver_cost.stop();
@@ -465,21 +487,27 @@ static void apply_dpcp_bounds_for_task(
 	bounds.set_local_blocking(i, local);
 
 	delete local_obj;
-	delete sol;
+	if (!session)
+		delete sol;
 }
 
 
-static BlockingBounds* _lp_dpcp_bounds(const ResourceSharingInfo& info,
+static BlockingBounds* _lp_dpcp_bounds(const LPCacheKey& key,
+				       const ResourceSharingInfo& info,
 				       const ResourceLocality& locality,
-				       bool use_rta)
+				       bool use_rta,
+				       LPSessions *sessions)
 {
 	BlockingBounds* results = new BlockingBounds(info);
 
 	PriorityCeilings prio_ceilings = get_priority_ceilings(info);
 
-	for (unsigned int i = 0; i < info.get_tasks().size(); i++)
+	foreach_uncached_task_in_parallel(key, *results, [&](unsigned int i)
+	{
 		apply_dpcp_bounds_for_task(i, *results, info,
-					   locality, prio_ceilings, use_rta);
+					   locality, prio_ceilings, use_rta,
+					   sessions ? sessions->for_task(i) : NULL);
+	}, sessions ? 1 : get_lp_num_threads());
 
 	return results;
 }
@@ -488,15 +516,25 @@ static BlockingBounds* _lp_dpcp_bounds(const ResourceSharingInfo& info,
 
 BlockingBounds* lp_dpcp_bounds(const ResourceSharingInfo& info,
 			       const ResourceLocality& locality,
-			       bool use_rta)
+			       bool use_rta,
+			       LPSessions *sessions)
 {
+	LPStatsScope stats(__FUNCTION__);
+
 #if DEBUG_LP_OVERHEADS >= 1
 	static DEFINE_CPU_CLOCK(cpu_costs);
 
 	cpu_costs.start();
 #endif
 
-	BlockingBounds *results = _lp_dpcp_bounds(info, locality, use_rta);
+	LPCacheKey key(LP_CACHE_DPCP, info, locality);
+	key.add(use_rta);
+	// the wait-time analysis of use_rta looks at shorter intervals
+	if (!use_rta)
+		key.count_jobs_in_response();
+
+	BlockingBounds *results = _lp_dpcp_bounds(key, info, locality, use_rta,
+						   sessions);
 
 #if DEBUG_LP_OVERHEADS >= 1
 	cpu_costs.stop();
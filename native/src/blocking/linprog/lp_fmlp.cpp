@@ -8,6 +8,7 @@
 #include "stl-hashmap.h"
 
 #include "cpu_time.h"
+#include "lp_cache.h"
 
 typedef hashmap<unsigned int, unsigned int> BlockingLimits;
 
@@ -213,10 +214,11 @@ static void add_fmlp_constraints(
 static void apply_fmlp_bounds_for_task(
 	unsigned int i,
 	BlockingBounds& bounds,
-	const ResourceSharingInfo& info)
+	const ResourceSharingInfo& info,
+	LinearProgramSession *session)
 {
 	LinearProgram lp;
-	VarMapper vars;
+	VarMapper vars(info);
 	const TaskInfo& ti = info.get_tasks()[i];
 	LinearExpression *local_obj = new LinearExpression();
 
@@ -240,7 +242,7 @@ static void apply_fmlp_bounds_for_task(
 	solver_cost.start();
 #endif
 
-	Solution *sol = linprog_solve(lp, vars.get_num_vars());
+	const Solution *sol = linprog_solve(lp, vars.get_num_vars(), session);
 
 #if DEBUG_LP_OVERHEADS >= 2
 	solver_cost.stop();
@@ -259,29 +261,41 @@ static void apply_fmlp_bounds_for_task(
 	bounds.set_local_blocking(i, local);
 
 	delete local_obj;
-	delete sol;
+	if (!session)
+		delete sol;
 }
 
 
-static BlockingBounds* _lp_fmlp_bounds(const ResourceSharingInfo& info)
+static BlockingBounds* _lp_fmlp_bounds(const LPCacheKey& key,
+				       const ResourceSharingInfo& info,
+				       LPSessions *sessions)
 {
 	BlockingBounds* results = new BlockingBounds(info);
 
-	for (unsigned int i = 0; i < info.get_tasks().size(); i++)
-		apply_fmlp_bounds_for_task(i, *results, info);
+	foreach_uncached_task_in_parallel(key, *results, [&](unsigned int i)
+	{
+		apply_fmlp_bounds_for_task(i, *results, info,
+					   sessions ? sessions->for_task(i) : NULL);
+	}, sessions ? 1 : get_lp_num_threads());
 
 	return results;
 }
 
-BlockingBounds* lp_part_fmlp_bounds(const ResourceSharingInfo& info)
+BlockingBounds* lp_part_fmlp_bounds(const ResourceSharingInfo& info,
+				    LPSessions *sessions)
 {
+	LPStatsScope stats(__FUNCTION__);
+
 #if DEBUG_LP_OVERHEADS >= 1
 	static DEFINE_CPU_CLOCK(cpu_costs);
 
 	cpu_costs.start();
 #endif
 
-	BlockingBounds *results = _lp_fmlp_bounds(info);
+	LPCacheKey key(LP_CACHE_PART_FMLP, info);
+	key.count_jobs_in_response();
+
+	BlockingBounds *results = _lp_fmlp_bounds(key, info, sessions);
 
 #if DEBUG_LP_OVERHEADS >= 1
 	cpu_costs.stop();
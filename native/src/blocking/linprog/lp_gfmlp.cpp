@@ -8,6 +8,7 @@
 #include "stl-hashmap.h"
 
 #include "cpu_time.h"
+#include "lp_cache.h"
 
 typedef hashmap<unsigned int, unsigned int> BlockingLimits;
 
@@ -188,7 +189,7 @@ static void apply_gfmlp_bounds_for_task(
 	bool using_edf)
 {
 	LinearProgram lp;
-	VarMapper vars;
+	VarMapper vars(info);
 	const TaskInfo& ti = info.get_tasks()[i];
 	LinearExpression *local_obj = new LinearExpression();
 
@@ -237,14 +238,17 @@ static void apply_gfmlp_bounds_for_task(
 
 
 static BlockingBounds* _lp_gfmlp_bounds(
+	const LPCacheKey& key,
 	const ResourceSharingInfo& info,
 	unsigned int cluster_size,
 	bool using_edf)
 {
 	BlockingBounds* results = new BlockingBounds(info);
 
-	for (unsigned int i = 0; i < info.get_tasks().size(); i++)
+	foreach_uncached_task_in_parallel(key, *results, [&](unsigned int i)
+	{
 		apply_gfmlp_bounds_for_task(i, *results, info, cluster_size, using_edf);
+	});
 
 	return results;
 }
@@ -254,13 +258,19 @@ BlockingBounds* lp_gfmlp_bounds(
 	unsigned int cluster_size,
 	bool using_edf)
 {
+	LPStatsScope stats(__FUNCTION__);
+
 #if DEBUG_LP_OVERHEADS >= 1
 	static DEFINE_CPU_CLOCK(cpu_costs);
 
 	cpu_costs.start();
 #endif
 
-	BlockingBounds *results = _lp_gfmlp_bounds(info, cluster_size, using_edf);
+	LPCacheKey key(LP_CACHE_GFMLP, info);
+	key.add(cluster_size);
+	key.add(using_edf);
+
+	BlockingBounds *results = _lp_gfmlp_bounds(key, info, cluster_size, using_edf);
 
 #if DEBUG_LP_OVERHEADS >= 1
 	cpu_costs.stop();
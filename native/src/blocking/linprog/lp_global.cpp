@@ -19,6 +19,7 @@
 #include "linprog/io.h"
 
 #include "lp_global.h"
+#include "lp_analysis.h"
 
 std::string GlobalVarMapper::key2str(uint64_t key, unsigned int var) const
 {
@@ -74,13 +75,43 @@ std::string GlobalVarMapper::key2str(uint64_t key, unsigned int var) const
 	return buf.str();
 }
 
+GlobalVarMapper::GlobalVarMapper(const ResourceSharingInfo& info)
+	: num_tasks(info.get_tasks().size()),
+	  num_resources(get_resource_id_limit(info))
+{
+	set_num_blocks(NUM_BLOCKING_TYPES * num_tasks * num_resources
+	               + NUM_INTERFERENCE_TYPES);
+}
+
+LPSessions::~LPSessions()
+{
+	reset();
+}
+
+LinearProgramSession *LPSessions::for_task(unsigned int task_index)
+{
+	if (task_index >= sessions.size())
+		sessions.resize(task_index + 1, NULL);
+	if (!sessions[task_index])
+		sessions[task_index] = linprog_session();
+	return sessions[task_index];
+}
+
+void LPSessions::reset()
+{
+	foreach(sessions, s)
+		delete *s;
+	sessions.clear();
+}
+
 const double GlobalSuspensionAwareLP::EPSILON = 1e-6;
 
 GlobalSuspensionAwareLP::GlobalSuspensionAwareLP(
 	const ResourceSharingInfo& info,
 	unsigned int task_index,
 	unsigned int number_of_cpus)
-	: i(task_index),
+	: vars(info),
+	  i(task_index),
 	  ti(info.get_tasks()[i]),
 	  taskset(info.get_tasks()),
 	  m(number_of_cpus),
@@ -167,20 +198,22 @@ unsigned long GlobalSuspensionAwareLP::solve_debug()
 	return (unsigned long) result;
 }
 
-unsigned long GlobalSuspensionAwareLP::solve()
+unsigned long GlobalSuspensionAwareLP::solve(LinearProgramSession *session)
 {
-	Solution *sol;
+	const Solution *sol;
 
 	add_constraints_post_ctor();
 
-	sol = linprog_solve(*this, vars.get_num_vars());
+	sol = linprog_solve(*this, vars.get_num_vars(), session);
 
 	if (sol != NULL) // Do we have a solution to the LP?
 	{
 		double result;
 		//Get the pi-blocking (including pi-blocking caused by higher-priority tasks)
 		result = sol->evaluate(*get_objective());
-		delete sol;
+		// solutions of a session belong to the session
+		if (!session)
+			delete sol;
 
 		assert(ti.get_response() >= ti.get_cost());
 		unsigned long assumed_interference = ti.get_response() - ti.get_cost();
@@ -10,6 +10,7 @@
 #include "cpu_time.h"
 
 #include "mpcp.h"
+#include "lp_cache.h"
 
 #define NO_BOUND (-1)
 
@@ -30,46 +31,56 @@ private:
 	const MPCPCeilings &prio_ceilings;
 
 	long bound_remote_delay(const TaskInfo &tsk,
-			     	unsigned int res_id);
+			     	unsigned int res_id) const;
 
 	void bound_gcs_response_times(void);
 
+	void bound_remote_delays(void);
 
 public:
+	// All bounds are computed up front; afterwards, the object is
+	// only read and can be shared by the per-task LPs.
 	GcsResponseTimes(const ResourceSharingInfo &i,
 			 const MPCPCeilings &pc)
 			 : info(i), prio_ceilings(pc)
 	{
 		bound_gcs_response_times();
+		bound_remote_delays();
 	}
 
 
-	long get_max_remote_delay(const TaskInfo &ti, unsigned int res_id)
+	long get_max_remote_delay(const TaskInfo &ti, unsigned int res_id) const
 	{
-		if (remote_delay.find(ti.get_id()) == remote_delay.end())
-			remote_delay[ti.get_id()] = hashmap<unsigned int, long>();
+		hashmap< unsigned long, hashmap< unsigned int, long> >::const_iterator
+			t = remote_delay.find(ti.get_id());
 
-		hashmap<unsigned int, long> &tmap = remote_delay[ti.get_id()];
-
-		if (tmap.find(res_id) == tmap.end())
-			tmap[res_id] = bound_remote_delay(ti, res_id);
+		if (t != remote_delay.end())
+		{
+			hashmap<unsigned int, long>::const_iterator
+				r = t->second.find(res_id);
+			if (r != t->second.end())
+				return r->second;
+		}
 
-		return tmap[res_id];
+		// resource not accessed by any task
+		return bound_remote_delay(ti, res_id);
 	}
 
-	long get_gcs_response(const TaskInfo &ti, unsigned int res_id)
+	long get_gcs_response(const TaskInfo &ti, unsigned int res_id) const
 	{
 		// look up the task
-		if (gcs_response.find(ti.get_id()) == gcs_response.end())
+		hashmap< unsigned long, hashmap< unsigned int, unsigned long> >::const_iterator
+			t = gcs_response.find(ti.get_id());
+		if (t == gcs_response.end())
 			return NO_BOUND;
 
-		hashmap<unsigned int, unsigned long> &tmap = gcs_response[ti.get_id()];
-
 		// look up the resource
-		if (tmap.find(res_id) == tmap.end())
+		hashmap<unsigned int, unsigned long>::const_iterator
+			r = t->second.find(res_id);
+		if (r == t->second.end())
 			return NO_BOUND;
 
-		return tmap[res_id];
+		return r->second;
 	}
 };
 
@@ -104,9 +115,22 @@ void GcsResponseTimes::bound_gcs_response_times()
 	}
 }
 
+void GcsResponseTimes::bound_remote_delays()
+{
+	std::set<unsigned int> all_resources = get_all_resources(info);
+
+	foreach(info.get_tasks(), ti)
+	{
+		hashmap<unsigned int, long> &tmap = remote_delay[ti->get_id()];
+
+		foreach(all_resources, q)
+			tmap[*q] = bound_remote_delay(*ti, *q);
+	}
+}
+
 // This function computes an upper bound on remote blocking using response-time analysis.
 // This corresponds to Equation (3) in LNR:09.
-long GcsResponseTimes::bound_remote_delay(const TaskInfo &ti, unsigned int res_id)
+long GcsResponseTimes::bound_remote_delay(const TaskInfo &ti, unsigned int res_id) const
 {
 	unsigned long delay_by_lower = 0, delay_by_equal = 0, delay_by_higher = 0;
 
@@ -314,7 +338,7 @@ static PerResourceCounts get_per_resource_counts(const TaskInfo &ti)
 static void add_direct_blocking_constraints(
 	VarMapper& vars,
 	const ResourceSharingInfo& info,
-	GcsResponseTimes &rta,
+	const GcsResponseTimes &rta,
 	const TaskInfo& ti,
 	PerResourceCounts &per_resource_counts,
 	LinearProgram& lp,
@@ -413,7 +437,7 @@ static void add_direct_blocking_constraints(
 static void add_remote_blocking_constraint(
 	VarMapper& vars,
 	const ResourceSharingInfo& info,
-	GcsResponseTimes &rta,
+	const GcsResponseTimes &rta,
 	const TaskInfo& ti,
 	LinearProgram& lp)
 {
@@ -458,7 +482,7 @@ static void add_mpcp_constraints(
 	const ResourceSharingInfo& info,
 	const TaskInfo& ti,
 	const MPCPCeilings& prio_ceilings,
-	GcsResponseTimes &gcs_response,
+	const GcsResponseTimes &gcs_response,
 	LinearProgram& lp)
 {
 	PerResourceCounts counts = get_per_resource_counts(ti);
@@ -487,10 +511,11 @@ static void apply_mpcp_bounds_for_task(
 	BlockingBounds& bounds,
 	const ResourceSharingInfo& info,
 	const MPCPCeilings& prio_ceilings,
-	GcsResponseTimes &gcs_response)
+	const GcsResponseTimes &gcs_response,
+	LinearProgramSession *session)
 {
 	LinearProgram lp;
-	VarMapper vars;
+	VarMapper vars(info);
 	const TaskInfo& ti = info.get_tasks()[i];
 	LinearExpression *local_obj = new LinearExpression();
 	LinearExpression *remote_obj = new LinearExpression();
@@ -518,7 +543,7 @@ static void apply_mpcp_bounds_for_task(
 	solver_cost.start();
 #endif
 
-	Solution *sol = linprog_solve(lp, vars.get_num_vars());
+	const Solution *sol = linprog_solve(lp, vars.get_num_vars(), session);
 
 #if DEBUG_LP_OVERHEADS >= 2
 	solver_cost.stop();
@@ -535,15 +560,17 @@ static void apply_mpcp_bounds_for_task(
 	bounds.set_local_blocking(i, local);
 
 	delete local_obj;
-	delete sol;
+	if (!session)
+		delete sol;
 
 #if DEBUG_LP_OVERHEADS >= 2
 	remote_cost.start();
 #endif
 
-	// compute remote blocking maximum
+	// compute remote blocking maximum; in a session, only the
+	// objective is updated
 	lp.set_objective(remote_obj);
-	sol = linprog_solve(lp, vars.get_num_vars());
+	sol = linprog_solve(lp, vars.get_num_vars(), session);
 
 	assert(sol != NULL);
 
@@ -554,32 +581,43 @@ static void apply_mpcp_bounds_for_task(
 	remote_cost.stop();
 	std::cout << remote_cost << std::endl;
 #endif
-	delete sol;
+	if (!session)
+		delete sol;
 }
 
 
-static BlockingBounds* _lp_mpcp_bounds(const ResourceSharingInfo& info)
+static BlockingBounds* _lp_mpcp_bounds(const LPCacheKey& key,
+				       const ResourceSharingInfo& info,
+				       LPSessions *sessions)
 {
 	BlockingBounds* results = new BlockingBounds(info);
 
 	MPCPCeilings prio_ceilings = get_mpcp_ceilings(info);
 	GcsResponseTimes gcs_response = GcsResponseTimes(info, prio_ceilings);
 
-	for (unsigned int i = 0; i < info.get_tasks().size(); i++)
-		apply_mpcp_bounds_for_task(i, *results, info, prio_ceilings, gcs_response);
+	foreach_uncached_task_in_parallel(key, *results, [&](unsigned int i)
+	{
+		apply_mpcp_bounds_for_task(i, *results, info, prio_ceilings, gcs_response,
+					   sessions ? sessions->for_task(i) : NULL);
+	}, sessions ? 1 : get_lp_num_threads());
 
 	return results;
 }
 
-BlockingBounds* lp_mpcp_bounds(const ResourceSharingInfo& info)
+BlockingBounds* lp_mpcp_bounds(const ResourceSharingInfo& info,
+			       LPSessions *sessions)
 {
+	LPStatsScope stats(__FUNCTION__);
+
 #if DEBUG_LP_OVERHEADS >= 1
 	static DEFINE_CPU_CLOCK(cpu_costs);
 
 	cpu_costs.start();
 #endif
 
-	BlockingBounds *results = _lp_mpcp_bounds(info);
+	LPCacheKey key(LP_CACHE_MPCP, info);
+
+	BlockingBounds *results = _lp_mpcp_bounds(key, info, sessions);
 
 #if DEBUG_LP_OVERHEADS >= 1
 	cpu_costs.stop();
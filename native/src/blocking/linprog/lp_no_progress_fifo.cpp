@@ -19,6 +19,8 @@
 #include "linprog/io.h"
 
 #include "lp_global.h"
+#include "lp_analysis.h"
+#include "lp_cache.h"
 
 class GlobalFIFONoProgressAnalysis
 	: public GlobalNoProgressMechanismLP, public GlobalFIFOQueuesLP
@@ -35,17 +37,32 @@ public:
 	}
 };
 
-BlockingBounds* lp_no_progress_fifo_bounds(
+static BlockingBounds* _lp_no_progress_fifo_bounds(
+	const LPCacheKey& key,
 	const ResourceSharingInfo& info,
-	unsigned int number_of_cpus)
+	unsigned int number_of_cpus,
+	LPSessions *sessions)
 {
 	BlockingBounds* results = new BlockingBounds(info);
 
-	for (unsigned int i = 0; i < info.get_tasks().size(); i++)
+	foreach_uncached_task_in_parallel(key, *results, [&](unsigned int i)
 	{
 		GlobalFIFONoProgressAnalysis lp(info, i, number_of_cpus);
-		(*results)[i] = lp.solve();
-	}
+		(*results)[i] = lp.solve(sessions ? sessions->for_task(i) : NULL);
+	}, sessions ? 1 : get_lp_num_threads());
 
 	return results;
 }
+
+BlockingBounds* lp_no_progress_fifo_bounds(
+	const ResourceSharingInfo& info,
+	unsigned int number_of_cpus,
+	LPSessions *sessions)
+{
+	LPStatsScope stats(__FUNCTION__);
+
+	LPCacheKey key(LP_CACHE_NO_PROGRESS_FIFO, info);
+	key.add(number_of_cpus);
+
+	return _lp_no_progress_fifo_bounds(key, info, number_of_cpus, sessions);
+}
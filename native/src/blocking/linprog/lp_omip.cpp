@@ -8,6 +8,7 @@
 #include "stl-hashmap.h"
 
 #include "cpu_time.h"
+#include "lp_cache.h"
 
 // Per-cluster, per-resource access counts.
 typedef hashmap<unsigned int, unsigned int> AccessCounts;
@@ -32,6 +33,12 @@ static AccessCounts count_accesses(
 	return acount;
 }
 
+static unsigned int get_access_count(const AccessCounts& acount, unsigned int q)
+{
+	AccessCounts::const_iterator it = acount.find(q);
+	return it != acount.end() ? it->second : 0;
+}
+
 static void add_total_constraints(
 	VarMapper& vars,
 	const ResourceSharingInfo& info,
@@ -78,7 +85,7 @@ static void add_remote_cluster_constraints(
 	const ResourceSharingInfo& info,
 	const TaskInfo& ti,
 	LinearProgram& lp,
-	AccessCounts& acount,
+	const AccessCounts& acount,
 	unsigned int num_procs,
 	unsigned int cluster_size)
 {
@@ -117,9 +124,9 @@ static void add_remote_cluster_constraints(
 		foreach(ct->second, it) {
 			unsigned int bound  = ti.get_num_requests(it->first);
 			unsigned int q = it->first;
-			if (acount[q] <= 2 * cluster_size) {
+			if (get_access_count(acount, q) <= 2 * cluster_size) {
 				// FQ-only case
-				bound *= acount[q];
+				bound *= get_access_count(acount, q);
 			} else {
 				// PQ case
 				bound *= (cluster_size + num_procs);
@@ -134,7 +141,7 @@ static void add_local_cluster_constraints(
 	const ResourceSharingInfo& info,
 	const TaskInfo& ti,
 	LinearProgram& lp,
-	AccessCounts& acount,
+	const AccessCounts& acount,
 	unsigned int cluster_size)
 {
 	foreach_local_task_except(info.get_tasks(), ti, tx)
@@ -153,7 +160,7 @@ static void add_local_cluster_constraints(
 				exp->add_var(var_id);
 			}
 			unsigned int bound = ti.get_num_requests(q);
-			if (acount[q] > 2 * cluster_size)
+			if (get_access_count(acount, q) > 2 * cluster_size)
 				bound *= 2; // PQ case
 			lp.add_inequality(exp, bound);
 		}
@@ -166,7 +173,7 @@ static void add_omip_constraints(
 	const ResourceSharingInfo& info,
 	const TaskInfo& ti,
 	LinearProgram& lp,
-	AccessCounts& acounts,
+	const AccessCounts& acounts,
 	unsigned int num_procs,
 	unsigned int cluster_size)
 {
@@ -179,18 +186,15 @@ static void apply_omip_bounds_for_task(
 	unsigned int i,
 	BlockingBounds& bounds,
 	const ResourceSharingInfo& info,
-	PerClusterACounts &pcacounts,
+	const PerClusterACounts &pcacounts,
 	unsigned int num_procs,
 	unsigned int cluster_size)
 {
 	LinearProgram lp;
-	VarMapper vars;
+	VarMapper vars(info);
 	const TaskInfo& ti = info.get_tasks()[i];
 	unsigned int cluster = ti.get_cluster();
 
-	if (pcacounts.find(cluster) == pcacounts.end())
-		pcacounts[cluster] = count_accesses(info, cluster);
-
 #if DEBUG_LP_OVERHEADS >= 2
 	static DEFINE_CPU_CLOCK(model_gen_cost);
 	static DEFINE_CPU_CLOCK(solver_cost);
@@ -204,7 +208,7 @@ static void apply_omip_bounds_for_task(
 	vars.seal();
 
 	add_omip_constraints(vars, info, ti, lp,
-		pcacounts[cluster], num_procs, cluster_size);
+		pcacounts.find(cluster)->second, num_procs, cluster_size);
 
 #if DEBUG_LP_OVERHEADS >= 2
 	model_gen_cost.stop();
@@ -230,6 +234,7 @@ static void apply_omip_bounds_for_task(
 
 
 static BlockingBounds* _lp_omip_bounds(
+	const LPCacheKey& key,
 	const ResourceSharingInfo& info,
 	unsigned int num_procs,
 	unsigned int cluster_size)
@@ -237,8 +242,15 @@ static BlockingBounds* _lp_omip_bounds(
 	PerClusterACounts pcacounts;
 	BlockingBounds* results = new BlockingBounds(info);
 
-	for (unsigned int i = 0; i < info.get_tasks().size(); i++)
+	// computed up front, so that the tasks only read them
+	foreach(info.get_tasks(), tx)
+		if (pcacounts.find(tx->get_cluster()) == pcacounts.end())
+			pcacounts[tx->get_cluster()] = count_accesses(info, tx->get_cluster());
+
+	foreach_uncached_task_in_parallel(key, *results, [&](unsigned int i)
+	{
 		apply_omip_bounds_for_task(i, *results, info, pcacounts, num_procs, cluster_size);
+	});
 
 	return results;
 }
@@ -248,6 +260,8 @@ BlockingBounds* lp_omip_bounds(
 	unsigned int num_procs,
 	unsigned int cluster_size)
 {
+	LPStatsScope stats(__FUNCTION__);
+
 	assert(num_procs >= cluster_size);
 	assert(num_procs % cluster_size == 0);
 
@@ -257,7 +271,12 @@ BlockingBounds* lp_omip_bounds(
 	cpu_costs.start();
 #endif
 
-	BlockingBounds *results = _lp_omip_bounds(info, num_procs, cluster_size);
+	LPCacheKey key(LP_CACHE_OMIP, info);
+	key.add(num_procs);
+	key.add(cluster_size);
+	key.count_jobs_in_response();
+
+	BlockingBounds *results = _lp_omip_bounds(key, info, num_procs, cluster_size);
 
 #if DEBUG_LP_OVERHEADS >= 1
 	cpu_costs.stop();
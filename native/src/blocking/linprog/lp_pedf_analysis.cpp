@@ -24,15 +24,6 @@
 // --------------------[ A N A L Y S I S ]---------------------------
 // ------------------------------------------------------------------
 
-#ifdef __PEDF_BLK_ANALYSIS_ENABLE_TIMEOUT__
-
-#include <signal.h>
-#include <unistd.h>
-
-bool timeout_fired = false;
-const unsigned TIMEOUT = 60; // seconds
-#endif
-
 #ifdef __PEDF_BLK_ANALYSIS_ENABLE_HP_STOP__
 unsigned long gcd(unsigned long a, unsigned long b)
 {
@@ -55,9 +46,30 @@ unsigned long lcm(unsigned long a, unsigned long b)
 }
 #endif
 
+static unsigned int count_tasks_in_cluster(const ResourceSharingInfo& info, unsigned int cluster)
+{
+	unsigned int count = 0;
+	foreach_task_in_cluster(info.get_tasks(), cluster, T_i)
+	count++;
+	return count;
+}
+
 PEDFBlockingAnalysis::PEDFBlockingAnalysis(const ResourceSharingInfo& _info, unsigned int _cluster) :
-	info(_info), cluster(_cluster)
+	info(_info), cluster(_cluster),
+	local_tasks(count_tasks_in_cluster(_info, _cluster))
 {
+	min_exact_dbf_interval = 0;
+
+	foreach_task_in_cluster(info.get_tasks(), cluster, T_i)
+	{
+		local_tasks.add_task(T_i->get_cost(), T_i->get_period(), T_i->get_deadline());
+		// get_pedf_PDC_max_num_local_jobs() wraps around for
+		// intervals shorter than deadline - period; leave those to it
+		if (T_i->get_deadline() > T_i->get_period() &&
+		    T_i->get_deadline() - T_i->get_period() > min_exact_dbf_interval)
+			min_exact_dbf_interval = T_i->get_deadline() - T_i->get_period();
+	}
+
 	max_deadline = 0;
 
 	foreach_task_in_cluster(info.get_tasks(), cluster, T_i)
@@ -72,6 +84,10 @@ PEDFBlockingAnalysis::PEDFBlockingAnalysis(const ResourceSharingInfo& _info, uns
 unsigned long PEDFBlockingAnalysis::DBF(unsigned long interval_length)
 {
 	unsigned long retval = 0;
+	if (interval_length >= min_exact_dbf_interval &&
+	    local_tasks.bound_demand(interval_length, retval))
+		return retval;
+
 	foreach_task_in_cluster(info.get_tasks(), cluster, T_i)
 	retval += T_i->get_pedf_PDC_max_num_local_jobs(interval_length) * T_i->get_cost();
 
@@ -81,20 +97,16 @@ unsigned long PEDFBlockingAnalysis::DBF(unsigned long interval_length)
 unsigned long PEDFBlockingAnalysis::arrival_curve(unsigned long interval_length)
 {
 	unsigned long retval = 0;
+	if (local_tasks.bound_request(interval_length, retval))
+		return retval;
+
 	foreach_task_in_cluster(info.get_tasks(), cluster, T_i)
 	retval += T_i->get_pedf_AC_max_num_local_jobs(interval_length) * T_i->get_cost();
 
 	return retval;
 }
 
-#ifdef __PEDF_BLK_ANALYSIS_ENABLE_TIMEOUT__
-void watchdog_handler(int sig)
-{
-	timeout_fired = true;
-}
-#endif
-
-bool PEDFBlockingAnalysis::is_schedulable()
+sched_result_t PEDFBlockingAnalysis::check(Budget &budget)
 {
 
 	unsigned long lastBW_Len = 1;
@@ -114,19 +126,8 @@ bool PEDFBlockingAnalysis::is_schedulable()
 
 	unsigned long blk_LB_in = 0, blk_LB_out = 0;
 
-#ifdef __PEDF_BLK_ANALYSIS_ENABLE_TIMEOUT__
-
-	timeout_fired = false;
-
-	// Setup for the timeout
-	signal(SIGALRM, watchdog_handler);
-	alarm(TIMEOUT);
-
-	while (!timeout_fired)
-#else
-	while (true)
-#endif
-		// Perform PDC until the first idle-time
+	// Perform PDC until the first idle-time
+	while (budget.charge_iteration())
 	{
 		// Fixed-point iteration step
 		unsigned long newBW_Len = arrival_curve(lastBW_Len) + compute_blocking_AC(lastBW_Len);
@@ -140,32 +141,31 @@ bool PEDFBlockingAnalysis::is_schedulable()
 
 #ifdef __PEDF_BLK_ANALYSIS_ENABLE_HP_STOP__
 		if (newBW_Len > hyper_period)
-			return false;
+			return SCHED_UNSCHEDULABLE;
 #endif
 
 		const unsigned long t_LB = (lastBW_Len > min_deadline) ? lastBW_Len : min_deadline;
 
 		//if (!raw_PDC(t_LB, newBW_Len))
-		if (!QPA(t_LB, newBW_Len, blk_LB_in, blk_LB_out))
-			return false;
+		if (!QPA(budget, t_LB, newBW_Len, blk_LB_in, blk_LB_out))
+			// QPA gives up as well once the budget is exhausted
+			return budget.is_exhausted() ? SCHED_UNKNOWN : SCHED_UNSCHEDULABLE;
 
 		blk_LB_in = blk_LB_out;
 
 		lastBW_Len = newBW_Len;
 	}
 
-#ifdef __PEDF_BLK_ANALYSIS_ENABLE_TIMEOUT__
-	if (timeout_fired)
+	if (budget.is_exhausted())
 	{
 #ifdef __DEBUG_PEDF_BLK_ANALYSIS__
-		std::cout << "[PEDF-BLK] Timeout Fired" << std::endl;
+		std::cout << "[PEDF-BLK] Out of budget" << std::endl;
 #endif
 
-		return false;
+		return SCHED_UNKNOWN;
 	}
-#endif
 
-	return true;
+	return SCHED_SCHEDULABLE;
 }
 
 // Compute the last check-point < interval_length for the PDC
@@ -220,7 +220,7 @@ unsigned long PEDFBlockingAnalysis::last_check_point_before(unsigned long interv
 // -------------------------------------------------------------------------------------
 // Checks the PDC in [t_LB, t_UB)
 //bool PEDFBlockingAnalysis::QPA(unsigned long t_LB, unsigned long t_UB)
-bool PEDFBlockingAnalysis::QPA(unsigned long t_LB, unsigned long t_UB, unsigned long blk_LB_in, unsigned long& blk_LB_out)
+bool PEDFBlockingAnalysis::QPA(Budget &budget, unsigned long t_LB, unsigned long t_UB, unsigned long blk_LB_in, unsigned long& blk_LB_out)
 {
 	unsigned long check_point = last_check_point_before(t_UB);
 
@@ -237,6 +237,9 @@ bool PEDFBlockingAnalysis::QPA(unsigned long t_LB, unsigned long t_UB, unsigned
 		if (check_point < t_LB)
 			break;
 
+		if (!budget.charge_test_point())
+			return false;
+
 #ifdef __DEBUG_PEDF_BLK_ANALYSIS__
 		std::cout << "[QPA] Checking t = " << check_point << std::endl;
 #endif
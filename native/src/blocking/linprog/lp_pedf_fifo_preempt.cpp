@@ -31,10 +31,6 @@ private:
 	void add_max_overall_number_of_preemptions();
 	void add_at_max_one_request_per_processor_spin();
 	void add_per_task_bound_spin_delay();
-	void add_blocking_lower_and_upper_bound(unsigned long blocking_LB,
-	                                        unsigned long blocking_UB);
-
-	bool integer_relaxation;
 
 public:
 	FIFO_Preemptive(const ResourceSharingInfo& info,
@@ -44,10 +40,9 @@ public:
 	                unsigned long blocking_LB,
 	                unsigned long blocking_UB = 0, //Default: no UB
 	                bool relax = true)
-		: PEDFBlockingAnalysisLP_Spinlocks(info, analysis_type, interval_length, cluster)
+		: PEDFBlockingAnalysisLP_Spinlocks(info, analysis_type, interval_length,
+		                                   cluster, relax)
 	{
-		integer_relaxation = relax;
-
 		// Add specific constraints for FIFO Preemptive spin locks
 		add_no_transitive_arrival_blocking();
 		add_max_number_of_cancellations();
@@ -67,7 +62,6 @@ public:
 // Constraint 24: No trnasitive arrival blocking
 void FIFO_Preemptive::add_no_transitive_arrival_blocking()
 {
-	LinearExpression *exp = new LinearExpression();
 	foreach_task_not_in_cluster(info.get_tasks(), cluster, T_x)
 	{
 		foreach(all_resources,q_iter)
@@ -76,10 +70,10 @@ void FIFO_Preemptive::add_no_transitive_arrival_blocking()
 			const unsigned int x = T_x->get_id();
 			var_t X_ARRIVAL = vars.arrival(x, q);
 
-			exp->add_var(X_ARRIVAL);
+			add_inequality_term(1, X_ARRIVAL);
 		}
 	}
-	add_inequality(exp,0);
+	finish_inequality(0);
 }
 
 // Constraint 25: Upper-bound on maximum number of cancellations based on
@@ -87,16 +81,13 @@ void FIFO_Preemptive::add_no_transitive_arrival_blocking()
 //                when a task is not accessing a resource
 void FIFO_Preemptive::add_max_number_of_cancellations()
 {
-
-	LinearExpression *exp_no_canc = new LinearExpression();
+	std::vector<unsigned int> no_canc;
 
 	// For each local task T_i
 	foreach_task_in_cluster(info.get_tasks(), cluster, T_i)
 	{
 		const unsigned int i = T_i->get_id();
 
-		LinearExpression *exp = new LinearExpression();
-
 		foreach(all_resources,q_iter)
 		{
 			const unsigned int q = *q_iter;
@@ -107,11 +98,11 @@ void FIFO_Preemptive::add_max_number_of_cancellations()
 			if (!integer_relaxation)
 				declare_variable_integer(C_iq);
 
-			exp->add_var(C_iq);
+			add_inequality_term(1, C_iq);
 
 			// Collects C_iq for tasks non accessing a resource
 			if (T_i->get_num_requests(q) == 0)
-				exp_no_canc->add_var(C_iq);
+				no_canc.push_back(C_iq);
 		}
 
 		unsigned int RHS = 0;
@@ -132,11 +123,13 @@ void FIFO_Preemptive::add_max_number_of_cancellations()
 			njobs = T_i->get_pedf_AC_max_num_local_jobs(interval_length);
 
 		// Enforce UB
-		add_inequality(exp, RHS * njobs);
+		finish_inequality(RHS * njobs);
 	}
 
 	// Enforce no cancellations when a task is not accessing a resource
-	add_inequality(exp_no_canc,0);
+	foreach(no_canc, C_iq)
+		add_inequality_term(1, *C_iq);
+	finish_inequality(0);
 }
 
 // Constraint 26: Overall number of preemptions bounded by max number of releases
@@ -145,8 +138,6 @@ void FIFO_Preemptive::add_max_overall_number_of_preemptions()
 	// For each local task T_i
 	foreach_task_in_cluster(info.get_tasks(), cluster, T_i)
 	{
-		LinearExpression *exp = new LinearExpression();
-
 		// For each local task T_j having d_j <= d_i
 		foreach_task_in_cluster_having_leq_dline(info.get_tasks(), cluster, T_i->get_deadline(), T_j)
 		{
@@ -157,7 +148,7 @@ void FIFO_Preemptive::add_max_overall_number_of_preemptions()
 				const unsigned int q = *q_iter;
 				var_t C_jq = vars.cancellations(j, q);
 
-				exp->add_var(C_jq);
+				add_inequality_term(1, C_jq);
 			}
 		}
 
@@ -167,7 +158,7 @@ void FIFO_Preemptive::add_max_overall_number_of_preemptions()
 			RHS += divide_with_ceil(interval_length, T_x->get_period());
 		}
 
-		add_inequality(exp,RHS);
+		finish_inequality(RHS);
 	}
 
 }
@@ -183,7 +174,6 @@ void FIFO_Preemptive::add_at_max_one_request_per_processor_spin()
 		{
 			const unsigned int q = *q_iter;
 
-			LinearExpression *exp = new LinearExpression();
 			unsigned long RHS = 0;
 
 			// For each task T_x in processor k
@@ -191,7 +181,7 @@ void FIFO_Preemptive::add_at_max_one_request_per_processor_spin()
 			{
 				const unsigned int x = T_x->get_id();
 				var_t X_SPIN    = vars.spin(x, q);
-				exp->add_var(X_SPIN);
+				add_inequality_term(1, X_SPIN);
 			}
 
 			// For each task T_i in the processor under observation
@@ -208,51 +198,12 @@ void FIFO_Preemptive::add_at_max_one_request_per_processor_spin()
 				RHS += njobs * T_i->get_num_requests(q);
 
 				var_t C_iq = vars.cancellations(i, q);
-				exp->sub_var(C_iq);
+				add_inequality_term(-1, C_iq);
 			}
 
-			add_inequality(exp,RHS);
-		}
-	}
-}
-
-// Extra constraint for speed-up
-void FIFO_Preemptive::add_blocking_lower_and_upper_bound(unsigned long blocking_LB,
-        unsigned long blocking_UB)
-{
-	LinearExpression *obj_minus = new LinearExpression();
-	LinearExpression *obj_plus  = new LinearExpression();
-
-	foreach(taskset, T_x)
-	{
-		const unsigned int x = T_x->get_id();
-
-		foreach(all_resources, q_iter)
-		{
-			const unsigned int q = *q_iter;
-			const double length = T_x->get_request_length(q);
-
-			var_t X_SPIN    = vars.spin(x, q);
-			var_t X_ARRIVAL = vars.arrival(x, q);
-
-			if (length > 0)
-			{
-				obj_minus->sub_term(length, X_SPIN);
-				obj_minus->sub_term(length, X_ARRIVAL);
-
-				obj_plus->add_term(length, X_SPIN);
-				obj_plus->add_term(length, X_ARRIVAL);
-			}
+			finish_inequality(RHS);
 		}
 	}
-
-	const double lb = (double)blocking_LB - 1.0 > 0 ? 0.0 : (double)blocking_LB - 1.0;
-
-	// obj >= LB  ==>  LB <= obj  ==>  LB - obj <= 0  ==> -obj <= -LB
-	add_inequality(obj_minus, -lb);
-
-	if (blocking_UB > 0)
-		add_inequality(obj_plus, blocking_UB);
 }
 
 // ------------------------------------------------------------------
@@ -322,8 +273,13 @@ unsigned long PEDFBlockingAnalysisFIFO_Preemptive::compute_blocking_AC (unsigned
 // --------------------[ E N T R Y    P O I N T ]--------------------
 // ------------------------------------------------------------------
 
-bool lp_pedf_fifo_preempt_is_schedulable(const ResourceSharingInfo& info)
+sched_result_t lp_pedf_fifo_preempt_is_schedulable(const ResourceSharingInfo& info, Budget *budget)
 {
+	LPStatsScope stats(__FUNCTION__);
+
+	Budget unlimited;
+	Budget &b = budget ? *budget : unlimited;
+
 	foreach_cluster(info, k)
 	{
 #ifdef __DEBUG_PEDF_BLK_ANALYSIS__
@@ -332,9 +288,10 @@ bool lp_pedf_fifo_preempt_is_schedulable(const ResourceSharingInfo& info)
 
 		// Perform schedulability analysis for each processor k
 		PEDFBlockingAnalysisFIFO_Preemptive analysis(info, k);
-		if (!analysis.is_schedulable())
-			return false;
+		sched_result_t result = analysis.check(b);
+		if (result != SCHED_SCHEDULABLE)
+			return result;
 	}
 
-	return true;
+	return SCHED_SCHEDULABLE;
 }
\ No newline at end of file
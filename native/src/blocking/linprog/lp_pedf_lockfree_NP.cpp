@@ -68,7 +68,6 @@ public:
 // Arrival blocking can be caused by at most one local commit
 void LockFree_NP::add_arrival_blocking_max_one_local_commit()
 {
-	LinearExpression *exp = new LinearExpression();
 	foreach_task_in_cluster(info.get_tasks(), cluster, T_i)
 	{
 		const unsigned int i = T_i->get_id();
@@ -79,17 +78,15 @@ void LockFree_NP::add_arrival_blocking_max_one_local_commit()
 
 			var_t A_i_q = vars.indicator_arrival(i,q);
 
-			exp->add_var(A_i_q);
+			add_inequality_term(1, A_i_q);
 		}
 	}
-	add_inequality(exp, 1);
+	finish_inequality(1);
 }
 
 // Arrival blocking cannot be caused by commits of tasks having dline <= t
 void LockFree_NP::add_no_arrival_blocking_dline_inside_interval()
 {
-	LinearExpression *exp = new LinearExpression();
-
 	foreach_task_in_cluster_having_leq_dline(taskset, cluster, interval_length, T_i)
 	{
 		const unsigned int i = T_i->get_id();
@@ -100,11 +97,11 @@ void LockFree_NP::add_no_arrival_blocking_dline_inside_interval()
 
 			var_t A_i_q = vars.indicator_arrival(i,q);
 
-			exp->add_var(A_i_q);
+			add_inequality_term(1, A_i_q);
 		}
 	}
 
-	add_inequality(exp, 0);
+	finish_inequality(0);
 }
 
 // Arrival blocking on a resource q cannot be caused by tasks that have
@@ -121,11 +118,10 @@ void LockFree_NP::add_no_commit_no_arrival_blocking()
 
 			var_t A_i_q = vars.indicator_arrival(i,q);
 
-			LinearExpression *exp = new LinearExpression();
-			exp->add_var(A_i_q);
+			add_inequality_term(1, A_i_q);
 
 			// A_{i,q} <= N_{i,q}
-			add_inequality(exp, T_i->get_num_requests(q));
+			finish_inequality(T_i->get_num_requests(q));
 		}
 	}
 }
@@ -162,13 +158,12 @@ void LockFree_NP::add_transitive_arrival_blocking_max_one_local_commit()
 			var_t Y_R_i_q = vars.remote_conflicts (i,q);
 			var_t A_i_q   = vars.indicator_arrival(i,q);
 
-			LinearExpression *exp = new LinearExpression();
-			exp->add_var(Y_R_i_q);
+			add_inequality_term(1, Y_R_i_q);
 
-			exp->sub_term(bigM,A_i_q);
+			add_inequality_term(-(double) bigM, A_i_q);
 
 			// Y_R_i_q <= A_i_q*bigM  ==>  Y_R_i_q - A_i_q*bigM <= 0
-			add_inequality(exp,0);
+			finish_inequality(0);
 		}
 	}
 }
@@ -176,7 +171,6 @@ void LockFree_NP::add_transitive_arrival_blocking_max_one_local_commit()
 // Under Non-Preemptive commit loops, there are no local conflicts
 void LockFree_NP::add_no_local_conflicts()
 {
-	LinearExpression *exp = new LinearExpression();
 	foreach_task_in_cluster(info.get_tasks(), cluster, T_i)
 	{
 		const unsigned int i = T_i->get_id();
@@ -191,12 +185,12 @@ void LockFree_NP::add_no_local_conflicts()
 
 				var_t Y_L_i_j_q = vars.local_conflicts(i,j,q);
 
-				exp->add_var(Y_L_i_j_q);
+				add_inequality_term(1, Y_L_i_j_q);
 			}
 		}
 	}
 
-	add_inequality(exp, 0);
+	finish_inequality(0);
 }
 
 unsigned long LockFree_NP::compute_NP_commit_response_time(taskIterator T_i, const unsigned int q)
@@ -261,10 +255,9 @@ void LockFree_NP::add_rta_based_bound_on_remote_conflicts()
 				       njobs * T_i->get_num_requests(q);
 			}
 
-			LinearExpression *exp = new LinearExpression();
-			exp->add_var(Y_R_i_q);
+			add_inequality_term(1, Y_R_i_q);
 
-			add_inequality(exp, RHS);
+			finish_inequality(RHS);
 		}
 	}
 }
@@ -333,8 +326,13 @@ unsigned long PEDFBlockingAnalysisLockFree_NP::compute_blocking_AC (unsigned lon
 // --------------------[ E N T R Y    P O I N T ]--------------------
 // ------------------------------------------------------------------
 
-bool lp_pedf_lockfree_NP_is_schedulable(const ResourceSharingInfo& info)
+sched_result_t lp_pedf_lockfree_NP_is_schedulable(const ResourceSharingInfo& info, Budget *budget)
 {
+	LPStatsScope stats(__FUNCTION__);
+
+	Budget unlimited;
+	Budget &b = budget ? *budget : unlimited;
+
 	foreach_cluster(info, k)
 	{
 #ifdef __DEBUG_PEDF_BLK_ANALYSIS__
@@ -343,9 +341,10 @@ bool lp_pedf_lockfree_NP_is_schedulable(const ResourceSharingInfo& info)
 
 		// Perform schedulability analysis for each processor k
 		PEDFBlockingAnalysisLockFree_NP analysis(info, k);
-		if (!analysis.is_schedulable())
-			return false;
+		sched_result_t result = analysis.check(b);
+		if (result != SCHED_SCHEDULABLE)
+			return result;
 	}
 
-	return true;
+	return SCHED_SCHEDULABLE;
 }
\ No newline at end of file
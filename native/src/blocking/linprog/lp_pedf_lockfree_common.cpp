@@ -182,9 +182,22 @@ void PEDFBlockingAnalysisLP_LockFree::add_blocking_upper_and_lower_bound(
     unsigned long blocking_LB,
     unsigned long blocking_UB)
 {
-	LinearExpression *obj_minus = new LinearExpression();
-	LinearExpression *obj_plus  = new LinearExpression();
+	const double lb = (double)blocking_LB - 1.0 > 0 ? 0.0 : (double)blocking_LB - 1.0;
+
+	// obj >= LB  ==>  LB <= obj  ==>  LB - obj <= 0  ==> -obj <= -LB
+	add_blocking_objective_terms(-1);
+	finish_inequality(-lb);
 
+	if (blocking_UB > 0)
+	{
+		add_blocking_objective_terms(1);
+		finish_inequality(blocking_UB);
+	}
+}
+
+// Add sign * obj to the inequality under construction.
+void PEDFBlockingAnalysisLP_LockFree::add_blocking_objective_terms(double sign)
+{
 	foreach_task_in_cluster(taskset, cluster, T_i)
 	{
 		const unsigned int i = T_i->get_id();
@@ -197,36 +210,22 @@ void PEDFBlockingAnalysisLP_LockFree::add_blocking_upper_and_lower_bound(
 			var_t Y_R_i_q  = vars.remote_conflicts(i, q);
 			var_t A_i_q    = vars.indicator_arrival(i, q);
 
-			obj_plus->add_term(length, Y_R_i_q);
-			obj_plus->add_term(length, A_i_q);
-
-			obj_minus->sub_term(length, Y_R_i_q);
-			obj_minus->sub_term(length, A_i_q);
+			add_inequality_term(sign * length, Y_R_i_q);
+			add_inequality_term(sign * length, A_i_q);
 
 			foreach_task_in_cluster(taskset, cluster, T_j)
 			{
 				const unsigned int j = T_j->get_id();
 				var_t Y_R_i_j_q  = vars.local_conflicts(i, j, q);
 
-				obj_plus->add_term(length, Y_R_i_j_q);
-				obj_minus->sub_term(length, Y_R_i_j_q);
+				add_inequality_term(sign * length, Y_R_i_j_q);
 			}
 		}
 	}
-
-	const double lb = (double)blocking_LB - 1.0 > 0 ? 0.0 : (double)blocking_LB - 1.0;
-
-	// obj >= LB  ==>  LB <= obj  ==>  LB - obj <= 0  ==> -obj <= -LB
-	add_inequality(obj_minus, -lb);
-
-
-	if (blocking_UB > 0)
-		add_inequality(obj_plus, blocking_UB);
 }
 
 void PEDFBlockingAnalysisLP_LockFree::add_no_retries_for_resources_not_accessed()
 {
-	LinearExpression *exp = new LinearExpression();
 	foreach_task_in_cluster(info.get_tasks(), cluster, T_i)
 	{
 		const unsigned int i = T_i->get_id();
@@ -241,19 +240,19 @@ void PEDFBlockingAnalysisLP_LockFree::add_no_retries_for_resources_not_accessed(
 
 			var_t Y_R_i_q = vars.remote_conflicts(i,q);
 
-			exp->add_var(Y_R_i_q);
+			add_inequality_term(1, Y_R_i_q);
 
 			foreach_task_in_cluster(info.get_tasks(), cluster, T_j)
 			{
 				const unsigned int j = T_j->get_id();
 				var_t Y_L_i_j_q = vars.local_conflicts(i, j, q);
 
-				exp->add_var(Y_L_i_j_q);
+				add_inequality_term(1, Y_L_i_j_q);
 			}
 		}
 	}
 
-	add_inequality(exp, 0);
+	finish_inequality(0);
 }
 
 void PEDFBlockingAnalysisLP_LockFree::add_one_retry_for_at_most_one_remote_commit()
@@ -262,20 +261,18 @@ void PEDFBlockingAnalysisLP_LockFree::add_one_retry_for_at_most_one_remote_commi
 	{
 		const unsigned int q = *q_iter;
 
-		LinearExpression *exp = new LinearExpression();
-
 		foreach_task_in_cluster(info.get_tasks(), cluster, T_i)
 		{
 			const unsigned int i = T_i->get_id();
 			var_t Y_R_i_q = vars.remote_conflicts(i, q);
-			exp->add_var(Y_R_i_q);
+			add_inequality_term(1, Y_R_i_q);
 		}
 
 		unsigned long RHS = 0;
 		foreach_task_not_in_cluster(info.get_tasks(), cluster, T_x)
 		RHS += T_x->get_pedf_max_num_remote_jobs(interval_length) * T_x->get_num_requests(q);
 
-		add_inequality(exp, RHS);
+		finish_inequality(RHS);
 	}
 }
 
@@ -283,7 +280,6 @@ void PEDFBlockingAnalysisLP_LockFree::add_one_retry_for_at_most_one_remote_commi
 // No arrival blocking at all (for AC or preemptive commit loops)
 void PEDFBlockingAnalysisLP_LockFree::add_no_arrival_blocking()
 {
-	LinearExpression *exp = new LinearExpression();
 	foreach_task_in_cluster(info.get_tasks(), cluster, T_i)
 	{
 		const unsigned int i = T_i->get_id();
@@ -294,8 +290,8 @@ void PEDFBlockingAnalysisLP_LockFree::add_no_arrival_blocking()
 
 			var_t A_i_q = vars.indicator_arrival(i, q);
 
-			exp->add_var(A_i_q);
+			add_inequality_term(1, A_i_q);
 		}
 	}
-	add_inequality(exp, 0);
+	finish_inequality(0);
 }
\ No newline at end of file
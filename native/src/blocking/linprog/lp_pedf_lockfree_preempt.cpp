@@ -77,7 +77,6 @@ public:
 // Enforce no retry delay for tasks that have no jobs in a deadline busy-period
 void LockFree_Preemptive::add_no_jobs_no_retry_delay()
 {
-	LinearExpression *exp = new LinearExpression();
 	foreach_task_in_cluster(info.get_tasks(), cluster, T_i)
 	{
 		unsigned long njobs = 0;
@@ -100,25 +99,24 @@ void LockFree_Preemptive::add_no_jobs_no_retry_delay()
 			const unsigned int q = *q_iter;
 
 			var_t Y_R_i_q = vars.remote_conflicts (i,q);
-			exp->add_var(Y_R_i_q);
+			add_inequality_term(1, Y_R_i_q);
 
 			foreach_task_in_cluster(info.get_tasks(), cluster, T_j)
 			{
 				const unsigned int j = T_j->get_id();
 				var_t Y_L_i_j_q = vars.local_conflicts (i,j,q);
-				exp->add_var(Y_L_i_j_q);
+				add_inequality_term(1, Y_L_i_j_q);
 			}
 		}
 	}
 
-	add_inequality(exp,0);
+	finish_inequality(0);
 }
 
 // Tasks that do not have commit loops on a resource cannot cause conflict
 // for such a resource
 void LockFree_Preemptive::add_no_requests_no_cause_local_conflict()
 {
-	LinearExpression *exp = new LinearExpression();
 	foreach_task_in_cluster(info.get_tasks(), cluster, T_i)
 	{
 		const unsigned int i = T_i->get_id();
@@ -137,12 +135,12 @@ void LockFree_Preemptive::add_no_requests_no_cause_local_conflict()
 				// Here N_{j,q}=0
 
 				var_t Y_L_i_j_q = vars.local_conflicts (i,j,q);
-				exp->add_var(Y_L_i_j_q);
+				add_inequality_term(1, Y_L_i_j_q);
 			}
 		}
 	}
 
-	add_inequality(exp,0);
+	finish_inequality(0);
 }
 
 // "One-to-one mapping" between retries in a task and preempting jobs
@@ -157,12 +155,11 @@ void LockFree_Preemptive::add_at_most_one_retry_per_preempting_job()
 			const unsigned int j = T_j->get_id();
 
 			// LHS
-			LinearExpression *exp = new LinearExpression();
 			foreach(all_resources,q_iter)
 			{
 				const unsigned int q = *q_iter;
 				var_t Y_L_i_j_q = vars.local_conflicts (i,j,q);
-				exp->add_var(Y_L_i_j_q);
+				add_inequality_term(1, Y_L_i_j_q);
 			}
 
 			// RHS
@@ -178,7 +175,7 @@ void LockFree_Preemptive::add_at_most_one_retry_per_preempting_job()
 			if (lp_type == AC_MODE)
 				njobs = T_i->get_pedf_AC_max_num_local_jobs(interval_length);
 
-			add_inequality(exp, preempt_UB * njobs);
+			finish_inequality(preempt_UB * njobs);
 		}
 	}
 }
@@ -194,15 +191,14 @@ void LockFree_Preemptive::add_each_job_causes_at_most_one_retry_per_resource()
 		{
 			const unsigned int q = *q_iter;
 
-			LinearExpression *exp = new LinearExpression();
 			foreach_task_in_cluster(info.get_tasks(), cluster, T_i)
 			{
 				const unsigned int i = T_i->get_id();
 				var_t Y_L_i_j_q = vars.local_conflicts (i,j,q);
-				exp->add_var(Y_L_i_j_q);
+				add_inequality_term(1, Y_L_i_j_q);
 			}
 
-			add_inequality(exp, divide_with_ceil(interval_length,T_j->get_period()));
+			finish_inequality(divide_with_ceil(interval_length,T_j->get_period()));
 		}
 	}
 }
@@ -318,10 +314,9 @@ void LockFree_Preemptive::add_rta_based_bound_on_remote_conflicts()
 				       njobs * T_i->get_num_requests(q);
 			}
 
-			LinearExpression *exp = new LinearExpression();
-			exp->add_var(Y_R_i_q);
+			add_inequality_term(1, Y_R_i_q);
 
-			add_inequality(exp, RHS);
+			finish_inequality(RHS);
 		}
 	}
 }
@@ -392,8 +387,13 @@ unsigned long PEDFBlockingAnalysisLockFree_Preemptive::compute_blocking_AC (unsi
 // --------------------[ E N T R Y    P O I N T ]--------------------
 // ------------------------------------------------------------------
 
-bool lp_pedf_lockfree_preempt_is_schedulable(const ResourceSharingInfo& info)
+sched_result_t lp_pedf_lockfree_preempt_is_schedulable(const ResourceSharingInfo& info, Budget *budget)
 {
+	LPStatsScope stats(__FUNCTION__);
+
+	Budget unlimited;
+	Budget &b = budget ? *budget : unlimited;
+
 	foreach_cluster(info, k)
 	{
 #ifdef __DEBUG_PEDF_BLK_ANALYSIS__
@@ -402,9 +402,10 @@ bool lp_pedf_lockfree_preempt_is_schedulable(const ResourceSharingInfo& info)
 
 		// Perform schedulability analysis for each processor k
 		PEDFBlockingAnalysisLockFree_Preemptive analysis(info, k);
-		if (!analysis.is_schedulable())
-			return false;
+		sched_result_t result = analysis.check(b);
+		if (result != SCHED_SCHEDULABLE)
+			return result;
 	}
 
-	return true;
+	return SCHED_SCHEDULABLE;
 }
\ No newline at end of file
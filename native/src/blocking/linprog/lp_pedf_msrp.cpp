@@ -35,14 +35,20 @@ public:
 	MSRP_LP(const ResourceSharingInfo& info,
 	        analysis_type_t analysis_type,
 	        unsigned long interval_length,
-	        unsigned int cluster)
-		: PEDFBlockingAnalysisLP_Spinlocks(info, analysis_type, interval_length, cluster)
+	        unsigned int cluster,
+	        unsigned long blocking_LB = 0,
+	        unsigned long blocking_UB = 0, //Default: no UB
+	        bool relax = false)
+		: PEDFBlockingAnalysisLP_Spinlocks(info, analysis_type, interval_length,
+		                                   cluster, relax)
 	{
 		// Add specific constraints for MSRP
 		add_at_max_one_request_per_processor_spin();
 		add_per_task_bound_spin_delay();
 		add_at_max_one_request_per_processor_arrival();
 
+		add_blocking_lower_and_upper_bound(blocking_LB, blocking_UB);
+
 		vars.seal(); // every possible variable should have been referenced
 	}
 };
@@ -61,7 +67,6 @@ void MSRP_LP::add_at_max_one_request_per_processor_spin()
 		{
 			const unsigned int q = *q_iter;
 
-			LinearExpression *LHS = new LinearExpression();
 			unsigned long RHS = 0;
 
 			// For each task T_x in processor k
@@ -69,7 +74,7 @@ void MSRP_LP::add_at_max_one_request_per_processor_spin()
 			{
 				const unsigned int x = T_x->get_id();
 				var_t X_SPIN    = vars.spin(x, q);
-				LHS->add_var(X_SPIN);
+				add_inequality_term(1, X_SPIN);
 			}
 
 			// For each task T_i in the processor under observation
@@ -85,7 +90,7 @@ void MSRP_LP::add_at_max_one_request_per_processor_spin()
 				RHS += njobs * T_i->get_num_requests(q);
 			}
 
-			add_inequality(LHS,RHS);
+			finish_inequality(RHS);
 		}
 	}
 }
@@ -111,9 +116,8 @@ void MSRP_LP::add_per_task_bound_spin_delay()
 				RHS += nrjobs_T_i * T_i->get_num_requests(q) * nrjobs_T_x;
 			}
 
-			LinearExpression *exp = new LinearExpression();
-			exp->add_var(X_SPIN);
-			add_inequality(exp,RHS);
+			add_inequality_term(1, X_SPIN);
+			finish_inequality(RHS);
 		}
 	}
 }
@@ -128,7 +132,6 @@ void MSRP_LP::add_at_max_one_request_per_processor_arrival()
 		{
 			const unsigned int q = *q_iter;
 
-			LinearExpression *LHS = new LinearExpression();
 			var_t A_q = vars.indicator_arrival(q);
 
 			// For each task T_x in processor k
@@ -137,11 +140,11 @@ void MSRP_LP::add_at_max_one_request_per_processor_arrival()
 				const unsigned int x = T_x->get_id();
 
 				var_t X_ARRIVAL    = vars.arrival(x, q);
-				LHS->add_var(X_ARRIVAL);
+				add_inequality_term(1, X_ARRIVAL);
 			}
 			// LHS <= A_q
-			LHS->sub_var(A_q);
-			add_inequality(LHS,0);
+			add_inequality_term(-1, A_q);
+			finish_inequality(0);
 		}
 	}
 }
@@ -156,6 +159,9 @@ class PEDFBlockingAnalysisMSRP : public PEDFBlockingAnalysis
 private:
 	unsigned long compute_blocking_PDC(unsigned long interval_length);
 	unsigned long compute_blocking_AC (unsigned long interval_length);
+	unsigned long compute_tighter_blocking_PDC(unsigned long interval_length,
+	        unsigned long blk_UB,
+	        unsigned long blk_LB = 0);
 
 public:
 	PEDFBlockingAnalysisMSRP(const ResourceSharingInfo& info,
@@ -164,9 +170,29 @@ public:
 
 };
 
+// Integer relaxation: an LP instead of a MIP, which suffices at most
+// check-points; the QPA falls back to the MIP only if it does not.
 unsigned long PEDFBlockingAnalysisMSRP::compute_blocking_PDC(unsigned long interval_length)
 {
-	MSRP_LP mip(info, PDC_MODE, interval_length, cluster);
+	MSRP_LP lp(info, PDC_MODE, interval_length, cluster, 0, 0, true);
+
+	return lp.solve(false);
+}
+
+// No integer relaxation
+unsigned long PEDFBlockingAnalysisMSRP::compute_tighter_blocking_PDC(
+    unsigned long interval_length,
+    unsigned long blk_UB,
+    unsigned long blk_LB)
+{
+	unsigned long pdc_blocking_LB = blk_LB;
+
+	// EDF arrival blocking is not monotonic before max_deadline
+	if (interval_length <= max_deadline)
+		pdc_blocking_LB = 0;
+
+	// the relaxed bound blk_UB cuts off the MIP's search space
+	MSRP_LP mip(info, PDC_MODE, interval_length, cluster, pdc_blocking_LB, blk_UB);
 
 	return mip.solve(false);
 }
@@ -181,8 +207,13 @@ unsigned long PEDFBlockingAnalysisMSRP::compute_blocking_AC (unsigned long inter
 // --------------------[ E N T R Y    P O I N T ]--------------------
 // ------------------------------------------------------------------
 
-bool lp_pedf_msrp_is_schedulable(const ResourceSharingInfo& info)
+sched_result_t lp_pedf_msrp_is_schedulable(const ResourceSharingInfo& info, Budget *budget)
 {
+	LPStatsScope stats(__FUNCTION__);
+
+	Budget unlimited;
+	Budget &b = budget ? *budget : unlimited;
+
 	foreach_cluster(info, k)
 	{
 #ifdef __DEBUG_PEDF_BLK_ANALYSIS__
@@ -191,9 +222,10 @@ bool lp_pedf_msrp_is_schedulable(const ResourceSharingInfo& info)
 
 		// Perform schedulability analysis for each processor k
 		PEDFBlockingAnalysisMSRP analysis(info, k);
-		if (!analysis.is_schedulable())
-			return false;
+		sched_result_t result = analysis.check(b);
+		if (result != SCHED_SCHEDULABLE)
+			return result;
 	}
 
-	return true;
+	return SCHED_SCHEDULABLE;
 }
\ No newline at end of file
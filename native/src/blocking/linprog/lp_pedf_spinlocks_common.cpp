@@ -60,13 +60,16 @@ PEDFBlockingAnalysisLP_Spinlocks::PEDFBlockingAnalysisLP_Spinlocks(
     const ResourceSharingInfo& _info,
     analysis_type_t atype,
     unsigned long delta,
-    unsigned int _cluster)
-	: taskset(_info.get_tasks()),
+    unsigned int _cluster,
+    bool relax)
+	: vars(_info),
+	  taskset(_info.get_tasks()),
 	  info(_info),
 	  lp_type(atype),
 	  interval_length(delta),
 	  cluster(_cluster),
-	  all_resources(get_all_resources(_info))
+	  all_resources(get_all_resources(_info)),
+	  integer_relaxation(relax)
 {
 	// Add generic constraints
 	add_no_arrival_blocking_dline_inside_interval();
@@ -174,10 +177,9 @@ void PEDFBlockingAnalysisLP_Spinlocks::add_no_arrival_blocking_dline_inside_inte
 			const unsigned int q = request->get_resource_id();
 
 			var_t X_ARRIVAL = vars.arrival(i, q);
-			LinearExpression *exp = new LinearExpression();
-			exp->add_var(X_ARRIVAL);
 			// X_ARRIVAL <= 0
-			add_inequality(exp, 0);
+			add_inequality_term(1, X_ARRIVAL);
+			finish_inequality(0);
 		}
 	}
 }
@@ -185,8 +187,6 @@ void PEDFBlockingAnalysisLP_Spinlocks::add_no_arrival_blocking_dline_inside_inte
 // Constraint 9: No spin delay from local requests
 void PEDFBlockingAnalysisLP_Spinlocks::add_no_spin_delay_local_requests()
 {
-	LinearExpression *exp = new LinearExpression();
-
 	foreach_task_in_cluster(taskset, cluster, T_i)
 	{
 		const unsigned int i = T_i->get_id();
@@ -196,11 +196,11 @@ void PEDFBlockingAnalysisLP_Spinlocks::add_no_spin_delay_local_requests()
 			const unsigned int q = request->get_resource_id();
 
 			var_t X_SPIN = vars.spin(i, q);
-			exp->add_var(X_SPIN);
+			add_inequality_term(1, X_SPIN);
 		}
 	}
 
-	add_inequality(exp, 0);
+	finish_inequality(0);
 }
 
 // Constraint 10: Joint upper-bound for remote requests
@@ -219,11 +219,9 @@ void PEDFBlockingAnalysisLP_Spinlocks::add_joint_upper_bound_remote_requests()
 			var_t X_ARRIVAL = vars.arrival(i, q);
 			var_t X_SPIN    = vars.spin(i, q);
 
-			LinearExpression *exp = new LinearExpression();
-			exp->add_var(X_ARRIVAL);
-			exp->add_var(X_SPIN);
-
-			add_inequality(exp, nrjobs * N_i_q);
+			add_inequality_term(1, X_ARRIVAL);
+			add_inequality_term(1, X_SPIN);
+			finish_inequality(nrjobs * N_i_q);
 		}
 	}
 }
@@ -231,35 +229,35 @@ void PEDFBlockingAnalysisLP_Spinlocks::add_joint_upper_bound_remote_requests()
 // Constraint 11: Only one resource can cause arrival blocking
 void PEDFBlockingAnalysisLP_Spinlocks::add_arrival_blocking_single_resource()
 {
-	LinearExpression *exp = new LinearExpression();
 	foreach(all_resources,q_iter)
 	{
 		const unsigned int q = *q_iter;
 
 		var_t A_q = vars.indicator_arrival(q);
-		declare_variable_binary(A_q);
+		if (!integer_relaxation)
+			declare_variable_binary(A_q);
 
-		exp->add_var(A_q);
+		add_inequality_term(1, A_q);
 	}
 
-	add_inequality(exp, 1);
+	finish_inequality(1);
 }
 
 // Constraint 11-bis: No arrival blocking at all (for AC)
 void PEDFBlockingAnalysisLP_Spinlocks::add_no_arrival_blocking()
 {
-	LinearExpression *exp = new LinearExpression();
 	foreach(all_resources,q_iter)
 	{
 		const unsigned int q = *q_iter;
 
 		var_t A_q = vars.indicator_arrival(q);
-		declare_variable_binary(A_q);
+		if (!integer_relaxation)
+			declare_variable_binary(A_q);
 
-		exp->add_var(A_q);
+		add_inequality_term(1, A_q);
 	}
 
-	add_inequality(exp, 0);
+	finish_inequality(0);
 }
 
 // Constraint 12: Exclude non-conflicting local resources
@@ -285,16 +283,13 @@ void PEDFBlockingAnalysisLP_Spinlocks::add_exclude_non_conflicting_local_resourc
 			non_conflicting_resources.insert(*resource);
 	}
 
-	LinearExpression *exp = new LinearExpression();
 	foreach(non_conflicting_resources, q_iter)
 	{
 		unsigned int var_id = vars.indicator_arrival(*q_iter);
-		exp->add_var(var_id);
+		add_inequality_term(1, var_id);
 	}
-	if (exp->has_terms())
-		add_inequality(exp, 0);
-	else
-		delete exp;
+	// dropped if there are no such resources
+	finish_inequality(0);
 }
 
 
@@ -310,12 +305,12 @@ void PEDFBlockingAnalysisLP_Spinlocks::add_no_requests_no_arrival_blocking()
 		n_reqs += T_i->get_num_requests(q);
 
 		var_t A_q = vars.indicator_arrival(q);
-		declare_variable_binary(A_q);
+		if (!integer_relaxation)
+			declare_variable_binary(A_q);
 
-		LinearExpression *exp = new LinearExpression();
-		exp->add_var(A_q);
 		// A_q <= n_reqs
-		add_inequality(exp, n_reqs);
+		add_inequality_term(1, A_q);
+		finish_inequality(n_reqs);
 	}
 }
 
@@ -326,7 +321,6 @@ void PEDFBlockingAnalysisLP_Spinlocks::add_arrival_blocking_max_one_local_reques
 	{
 		const unsigned int q = *q_iter;
 
-		LinearExpression *exp = new LinearExpression();
 		var_t A_q = vars.indicator_arrival(q);
 
 		foreach_task_in_cluster(info.get_tasks(), cluster, T_i)
@@ -334,11 +328,52 @@ void PEDFBlockingAnalysisLP_Spinlocks::add_arrival_blocking_max_one_local_reques
 			const unsigned int i = T_i->get_id();
 
 			var_t X_ARRIVAL = vars.arrival(i, q);
-			exp->add_var(X_ARRIVAL);
+			add_inequality_term(1, X_ARRIVAL);
 		}
 
 		// expr <= A_q
-		exp->sub_var(A_q);
-		add_inequality(exp, 0);
+		add_inequality_term(-1, A_q);
+		finish_inequality(0);
+	}
+}
+
+// Extra constraint for speed-up
+void PEDFBlockingAnalysisLP_Spinlocks::add_blocking_lower_and_upper_bound(unsigned long blocking_LB,
+        unsigned long blocking_UB)
+{
+	const double lb = (double)blocking_LB - 1.0 > 0 ? 0.0 : (double)blocking_LB - 1.0;
+
+	// obj >= LB  ==>  LB <= obj  ==>  LB - obj <= 0  ==> -obj <= -LB
+	add_blocking_objective_terms(-1);
+	finish_inequality(-lb);
+
+	if (blocking_UB > 0)
+	{
+		add_blocking_objective_terms(1);
+		finish_inequality(blocking_UB);
 	}
-}
\ No newline at end of file
+}
+
+// Add sign * obj to the inequality under construction.
+void PEDFBlockingAnalysisLP_Spinlocks::add_blocking_objective_terms(double sign)
+{
+	foreach(taskset, T_x)
+	{
+		const unsigned int x = T_x->get_id();
+
+		foreach(all_resources, q_iter)
+		{
+			const unsigned int q = *q_iter;
+			const double length = T_x->get_request_length(q);
+
+			var_t X_SPIN    = vars.spin(x, q);
+			var_t X_ARRIVAL = vars.arrival(x, q);
+
+			if (length > 0)
+			{
+				add_inequality_term(sign * length, X_SPIN);
+				add_inequality_term(sign * length, X_ARRIVAL);
+			}
+		}
+	}
+}
@@ -19,6 +19,8 @@
 #include "linprog/io.h"
 
 #include "lp_global.h"
+#include "lp_analysis.h"
+#include "lp_cache.h"
 
 
 class GlobalPPCPAnalysis : public GlobalPrioInheritanceLP, public GlobalPriorityQueuesLP
@@ -426,18 +428,36 @@ void GlobalPPCPAnalysis::add_ppcp_beta_constraints()
 	}
 }
 
-BlockingBounds* lp_ppcp_bounds(
+static BlockingBounds* _lp_ppcp_bounds(
+	const LPCacheKey& key,
 	const ResourceSharingInfo& info,
 	unsigned int number_of_cpus,
-	bool reasonable_priority_assignment)
+	bool reasonable_priority_assignment,
+	LPSessions *sessions)
 {
 	BlockingBounds* results = new BlockingBounds(info);
 
-	for (unsigned int i = 0; i < info.get_tasks().size(); i++)
+	foreach_uncached_task_in_parallel(key, *results, [&](unsigned int i)
 	{
 		GlobalPPCPAnalysis lp(info, i, number_of_cpus, reasonable_priority_assignment);
-		(*results)[i] = lp.solve();
-	}
+		(*results)[i] = lp.solve(sessions ? sessions->for_task(i) : NULL);
+	}, sessions ? 1 : get_lp_num_threads());
 
 	return results;
 }
+
+BlockingBounds* lp_ppcp_bounds(
+	const ResourceSharingInfo& info,
+	unsigned int number_of_cpus,
+	bool reasonable_priority_assignment,
+	LPSessions *sessions)
+{
+	LPStatsScope stats(__FUNCTION__);
+
+	LPCacheKey key(LP_CACHE_PPCP, info);
+	key.add(number_of_cpus);
+	key.add(reasonable_priority_assignment);
+
+	return _lp_ppcp_bounds(key, info, number_of_cpus,
+			       reasonable_priority_assignment, sessions);
+}
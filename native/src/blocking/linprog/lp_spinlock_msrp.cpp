@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <climits>
 #include "cpu_time.h"
+#include "lp_cache.h"
 
 // Constraint 21: Limit the number of preemptions that Ti can incur to
 // the number of releases of local higher-priority jobs while Ti's job
@@ -174,7 +175,7 @@ unsigned long apply_msrp_bounds_for_task(
 	build_model.start();
 #endif
 	LinearProgram lp;
-	VarMapperSpinlocks vars;
+	VarMapperSpinlocks vars(info);
 	const TaskInfo& ti = info.get_tasks()[i];
 
 	if (preemptive)
@@ -228,17 +229,27 @@ unsigned long lp_preemptive_fifo_bounds_single(
 	return blocking_term;
 }
 
-BlockingBounds* lp_pfp_preemptive_fifo_spinlock_bounds(const ResourceSharingInfo& info)
+static BlockingBounds* _lp_pfp_preemptive_fifo_spinlock_bounds(const LPCacheKey& key,
+							       const ResourceSharingInfo& info)
 {
 	BlockingBounds* results = new BlockingBounds(info);
 
-	for (unsigned int i=0; i<info.get_tasks().size(); i++)
+	foreach_uncached_task_in_parallel(key, *results, [&](unsigned int i)
 	{
 		apply_msrp_bounds_for_task(i, *results, info, true);
-	}
+	});
 	return results;
 }
 
+BlockingBounds* lp_pfp_preemptive_fifo_spinlock_bounds(const ResourceSharingInfo& info)
+{
+	LPStatsScope stats(__FUNCTION__);
+
+	LPCacheKey key(LP_CACHE_PFP_PREEMPTIVE_FIFO, info);
+
+	return _lp_pfp_preemptive_fifo_spinlock_bounds(key, info);
+}
+
 unsigned long lp_msrp_bounds_single(
 		const ResourceSharingInfo& info,
 		unsigned int task_index)
@@ -253,7 +264,8 @@ unsigned long lp_msrp_bounds_single(
 	return blocking_term;
 }
 
-BlockingBounds* lp_pfp_msrp_bounds(const ResourceSharingInfo& info)
+static BlockingBounds* _lp_pfp_msrp_bounds(const LPCacheKey& key,
+					   const ResourceSharingInfo& info)
 {
 #if DEBUG_LP_OVERHEADS >= 1
 	static DEFINE_CPU_CLOCK(solve_full_ts);
@@ -263,10 +275,10 @@ BlockingBounds* lp_pfp_msrp_bounds(const ResourceSharingInfo& info)
 	BlockingBounds* results = new BlockingBounds(info);
 	PriorityCeilings prio_ceilings = get_priority_ceilings(info);
 
-	for (unsigned int i=0; i<info.get_tasks().size(); i++)
+	foreach_uncached_task_in_parallel(key, *results, [&](unsigned int i)
 	{
 		apply_msrp_bounds_for_task(i, *results, info, false);
-	}
+	});
 
 #if DEBUG_LP_OVERHEADS >= 1
 	solve_full_ts.stop();
@@ -275,3 +287,12 @@ BlockingBounds* lp_pfp_msrp_bounds(const ResourceSharingInfo& info)
 
 	return results;
 }
+
+BlockingBounds* lp_pfp_msrp_bounds(const ResourceSharingInfo& info)
+{
+	LPStatsScope stats(__FUNCTION__);
+
+	LPCacheKey key(LP_CACHE_PFP_MSRP, info);
+
+	return _lp_pfp_msrp_bounds(key, info);
+}
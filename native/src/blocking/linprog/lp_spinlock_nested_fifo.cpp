@@ -323,7 +323,7 @@ NestedFifoILP::NestedFifoILP(
 
 	add_remote_blocking_constraints();
 
-	assert(vars.get_num_vars() == get_binary_variables().size());
+	assert(vars.get_num_vars() == get_num_binary_variables());
 }
 
 unsigned long NestedFifoILP::solve()
@@ -411,15 +411,14 @@ void NestedFifoILP::add_type_constraints()
 			/* for all instances of *cs while a job of Ti is pending */
 			enumerate_cs_instances(*tx, tx_cs, cs_index, v)
 			{
-				LinearExpression *exp = new LinearExpression();
 				var_t var_d = vars.vertex_direct(x, q, v);
 				var_t var_n = vars.vertex_nested(x, q, v);
 
 				declare_variable_binary(var_d);
 				declare_variable_binary(var_n);
-				exp->add_var(var_d);
-				exp->add_var(var_n);
-				add_inequality(exp, 1);
+				add_inequality_term(1, var_d);
+				add_inequality_term(1, var_n);
+				finish_inequality(1);
 			}
 		}
 	}
@@ -454,17 +453,16 @@ void NestedFifoILP::add_nesting_constraints()
 				enumerate_cs_instances(*tx, tx_cs, cs_index, v)
 				{
 					const unsigned int u = v - delta;
-					LinearExpression *exp = new LinearExpression();
 
 					/* R_{x,q,v} is nested in R_{x,o,u} */
 					var_t var_od = vars.vertex_direct(x, o, u);
 					var_t var_on = vars.vertex_nested(x, o, u);
 					var_t var_n  = vars.vertex_nested(x, q, v);
 
-					exp->add_var(var_n);
-					exp->sub_var(var_od);
-					exp->sub_var(var_on);
-					add_inequality(exp, 0);
+					add_inequality_term(1, var_n);
+					add_inequality_term(-1, var_od);
+					add_inequality_term(-1, var_on);
+					finish_inequality(0);
 				}
 			}
 			else
@@ -475,11 +473,10 @@ void NestedFifoILP::add_nesting_constraints()
 				/* for all instances of *cs while a job of Ti is pending */
 				enumerate_cs_instances(*tx, tx_cs, cs_index, v)
 				{
-					LinearExpression *exp = new LinearExpression();
 					var_t var_n  = vars.vertex_nested(x, q, v);
 
-					exp->add_var(var_n);
-					add_equality(exp, 0);
+					add_equality_term(1, var_n);
+					finish_equality(0);
 				}
 			}
 		}
@@ -546,7 +543,7 @@ void NestedFifoILP::add_remote_blocking_constraints_for_core(unsigned int k)
 void NestedFifoILP::add_remote_blocking_constraints_for_resource(
 	unsigned int k, unsigned int q, const LockSet& serializing)
 {
-	LinearExpression *exp = new LinearExpression();
+	bool found_requests = false;
 
 	/* (1) enumerate LHS of constraint */
 	foreach_task_in_cluster(taskset, k, tx)
@@ -569,7 +566,8 @@ void NestedFifoILP::add_remote_blocking_constraints_for_resource(
 					enumerate_cs_instances(*tx, tx_cs, cs_index, v)
 					{
 						var_t var_d  = vars.vertex_direct(x, q, v);
-						exp->add_var(var_d);
+						add_inequality_term(1, var_d);
+						found_requests = true;
 					}
 				}
 			}
@@ -577,10 +575,9 @@ void NestedFifoILP::add_remote_blocking_constraints_for_resource(
 	}
 
 
-	if (!exp->has_terms())
+	if (!found_requests)
 	{
 		/* didn't find any requests for 'q' on processor 'k' => skip */
-		delete exp;
 		return;
 	}
 
@@ -604,7 +601,7 @@ void NestedFifoILP::add_remote_blocking_constraints_for_resource(
 					enumerate_cs_instances(*tx, tx_cs, cs_index, v)
 					{
 						var_t var_d  = vars.vertex_direct(x, q, v);
-						exp->sub_var(var_d);
+						add_inequality_term(-1, var_d);
 					}
 				}
 			}
@@ -632,7 +629,7 @@ void NestedFifoILP::add_remote_blocking_constraints_for_resource(
 					enumerate_cs_instances(*tx, tx_cs, cs_index, v)
 					{
 						var_t var_n  = vars.vertex_nested(x, q, v);
-						exp->sub_var(var_n);
+						add_inequality_term(-1, var_n);
 					}
 				}
 			}
@@ -640,7 +637,7 @@ void NestedFifoILP::add_remote_blocking_constraints_for_resource(
 	}
 
 
-	add_inequality(exp, 0);
+	finish_inequality(0);
 }
 
 
@@ -768,8 +765,6 @@ void NestedFifoILP::update_guaranteed_lock_set(
 // This implements Constraint 2 in the writeup.
 void NestedFifoILP::add_arrival_blocking_constraints()
 {
-	LinearExpression *exp = new LinearExpression();
-
 	/* for all local tasks of lower priority */
 	foreach_local_lowereq_priority_task_except(taskset, ti, tx)
 	{
@@ -788,19 +783,17 @@ void NestedFifoILP::add_arrival_blocking_constraints()
 			enumerate_cs_instances(*tx, tx_cs, cs_index, v)
 			{
 				var_t vertex_d = vars.vertex_direct(x, q, v);
-				exp->add_var(vertex_d);
+				add_inequality_term(1, vertex_d);
 			}
 		}
 	}
 
-	add_inequality(exp, 1);
+	finish_inequality(1);
 }
 
 // This matches Constraint 1 in the writeup.
 void NestedFifoILP::add_local_resource_constraints()
 {
-	LinearExpression *exp = new LinearExpression();
-
 	/* for all local, lower-priority tasks */
 	foreach_local_lowereq_priority_task_except(taskset, ti, tx)
 	{
@@ -819,25 +812,27 @@ void NestedFifoILP::add_local_resource_constraints()
 				enumerate_cs_instances(*tx, tx_cs, cs_index, v)
 				{
 					var_t vertex_d = vars.vertex_direct(x, q, v);
-					exp->add_var(vertex_d);
+					add_equality_term(1, vertex_d);
 				}
 			}
 		}
 	}
-	add_equality(exp, 0);
+	finish_equality(0);
 }
 
 BlockingBounds* lp_nested_fifo_spinlock_bounds(
 	const ResourceSharingInfo& info,
 	const CriticalSectionsOfTaskset& tsk_cs)
 {
+	LPStatsScope stats(__FUNCTION__);
+
 	BlockingBounds* results = new BlockingBounds(info);
 
-	for (unsigned int i=0; i<info.get_tasks().size(); i++)
+	foreach_task_in_parallel(info, [&](unsigned int i)
 	{
 		NestedFifoILP ilp(info, tsk_cs, i);
 		(*results)[i] = ilp.solve();
-	}
+	});
 
 	return results;
 }
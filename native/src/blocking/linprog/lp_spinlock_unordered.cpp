@@ -1,5 +1,6 @@
 #include "lp_common.h"
 #include "cpu_time.h"
+#include "lp_cache.h"
 #include <set>
 #include <map>
 #include <cmath>
@@ -176,7 +177,7 @@ bool apply_unordered_bounds_for_task(
 #endif
 
 	LinearProgram lp;
-	VarMapperSpinlocks vars;
+	VarMapperSpinlocks vars(info);
 	const TaskInfo& ti = info.get_tasks()[i];
 
 	add_unordered_constraints(vars, info, ti, lp, preemptive);
@@ -199,16 +200,27 @@ bool apply_unordered_bounds_for_task(
 }
 
 
-BlockingBounds* lp_pfp_unordered_spinlock_bounds(const ResourceSharingInfo& info, bool preemptive)
+static BlockingBounds* _lp_pfp_unordered_spinlock_bounds(const LPCacheKey& key,
+							 const ResourceSharingInfo& info, bool preemptive)
 {
 	BlockingBounds* results = new BlockingBounds(info);
 
 	PriorityCeilings prio_ceilings = get_priority_ceilings(info);
 
-	for (unsigned int i=0; i<info.get_tasks().size(); i++)
+	foreach_uncached_task_in_parallel(key, *results, [&](unsigned int i)
 	{
 		apply_unordered_bounds_for_task(i, *results, info, preemptive);
-	}
+	});
 
 	return results;
 }
+
+BlockingBounds* lp_pfp_unordered_spinlock_bounds(const ResourceSharingInfo& info, bool preemptive)
+{
+	LPStatsScope stats(__FUNCTION__);
+
+	LPCacheKey key(LP_CACHE_PFP_UNORDERED, info);
+	key.add(preemptive);
+
+	return _lp_pfp_unordered_spinlock_bounds(key, info, preemptive);
+}
@@ -1,5 +1,6 @@
 #include "lp_common.h"
 #include "math-helper.h"
+#include "lp_cache.h"
 #include <set>
 #include <map>
 #include <cmath>
@@ -143,6 +144,17 @@ std::set<unsigned int> get_all_resources(const ResourceSharingInfo& info)
 	return all_resources;
 }
 
+unsigned int get_resource_id_limit(const ResourceSharingInfo& info)
+{
+	unsigned int limit = 0;
+	foreach(info.get_tasks(), task)
+	{
+		foreach(task->get_requests(), request)
+			limit = std::max(limit, request->get_resource_id() + 1);
+	}
+	return limit;
+}
+
 
 // return all resources accessed by Ti and other local higher-priority tasks.
 std::set<unsigned int> get_localHP_resources(const ResourceSharingInfo& info, const TaskInfo& ti)
@@ -625,7 +637,7 @@ unsigned long apply_baseline_bounds_for_task(
 	bool preemptive)
 {
 	LinearProgram lp;
-	VarMapperSpinlocks vars;
+	VarMapperSpinlocks vars(info);
 	const TaskInfo& ti = info.get_tasks()[i];
 
 	add_common_spinlock_constraints(vars, info, ti, lp);
@@ -656,18 +668,28 @@ unsigned long lp_baseline_bounds_single(
 	return blocking_term;
 }
 
-BlockingBounds* lp_pfp_baseline_spinlock_bounds(const ResourceSharingInfo& info)
+static BlockingBounds* _lp_pfp_baseline_spinlock_bounds(const LPCacheKey& key,
+							const ResourceSharingInfo& info)
 {
 	BlockingBounds* results = new BlockingBounds(info);
 
-	for (unsigned int i=0; i<info.get_tasks().size(); i++)
+	foreach_uncached_task_in_parallel(key, *results, [&](unsigned int i)
 	{
 		apply_baseline_bounds_for_task(i, *results, info, false);
-	}
+	});
 
 	return results;
 }
 
+BlockingBounds* lp_pfp_baseline_spinlock_bounds(const ResourceSharingInfo& info)
+{
+	LPStatsScope stats(__FUNCTION__);
+
+	LPCacheKey key(LP_CACHE_PFP_BASELINE, info);
+
+	return _lp_pfp_baseline_spinlock_bounds(key, info);
+}
+
 BlockingBounds* dummy_bounds(const ResourceSharingInfo& info)
 {
 	BlockingBounds* results = new BlockingBounds(info);
@@ -10,7 +10,9 @@ void CANJob::reset_params()
     allocation = 0;
     seqno = 1;
     cost = task.get_wcet();
+    // keeps the capacity for the next run
     host_faults.clear();
+    next_host_fault = 0;
 }
 
 void CANJob::update_seqno(simtime_t time)
@@ -35,21 +37,18 @@ void run_periodic_simulation(CANBusScheduleSimulation& sim,
                              CANTaskSet& ts,
                              simtime_t end_of_simulation)
 {
-    PeriodicCANJobSequence** jobs;
+    // reserved up front: the simulator keeps pointers to the jobs
+    std::vector<PeriodicCANJobSequence> jobs;
+    jobs.reserve(ts.get_task_count());
 
-    jobs = new PeriodicCANJobSequence*[ts.get_task_count()];
     for (unsigned int i = 0; i < ts.get_task_count(); i++)
     {
-        jobs[i] = new PeriodicCANJobSequence(ts[i]);
-        jobs[i]->set_simulation(&sim);
-        sim.add_release(jobs[i]);
+        jobs.push_back(PeriodicCANJobSequence(ts[i]));
+        jobs[i].set_simulation(&sim);
+        sim.add_release(&jobs[i]);
     }
 
     sim.simulate_until(end_of_simulation);
-
-    for (unsigned int i = 0; i < ts.get_task_count(); i++)
-        delete jobs[i];
-    delete [] jobs;
 }
 
 bool CANJob::gen_host_faults(double rate, int max, int boot_time)
@@ -83,19 +82,21 @@ bool CANJob::is_omission(simtime_t boot_time)
     int  end = release;
     int  start = release - boot_time; 
 
-    while(!host_faults.empty())
+    while (next_host_fault < host_faults.size())
     {
-        if (end < host_faults.front())
+        int fault = host_faults[next_host_fault];
+
+        if (end < fault)
             return false;
         
-        if (start <= host_faults.front() && host_faults.front() <= end)
+        if (start <= fault && fault <= end)
         {
-            // intentionally not erasing here
+            // intentionally not consuming here
             return true;
         }
 
-        // if (host_faults.front() < start)
-        host_faults.erase(host_faults.begin());
+        // if (fault < start)
+        next_host_fault++;
     }
 
     return false;
@@ -103,19 +104,20 @@ bool CANJob::is_omission(simtime_t boot_time)
 
 bool CANJob::is_commission(int start, int end)
 {
-    while(!host_faults.empty())
+    while (next_host_fault < host_faults.size())
     {
-        if (end < host_faults.front())
+        int fault = host_faults[next_host_fault++];
+
+        if (end < fault)
+        {
+            next_host_fault--;
             return false;
+        }
         
-        if (start <= host_faults.front() && host_faults.front() <= end)
-        {
-            host_faults.erase(host_faults.begin());
+        if (start <= fault && fault <= end)
             return true;
-        }
 
-        // if (host_faults.front() < start)
-        host_faults.erase(host_faults.begin());
+        // if (fault < start), the fault is skipped
     }
 
     return false;
@@ -215,12 +217,12 @@ void CANBusScheduler::retransmit(CANJob *job)
 
 void CANBusScheduler::add_ready(CANJob *job)
 {
-    // the object frees itself in DeadlineEvent::fire()
-    DeadlineEvent *handler = new DeadlineEvent(job->get_task(),
-                                               job->get_release(),
-                                               job->get_seqno(),
-                                               job->get_cost(),
-                                               this);
+    // returned to the pool in deadline_event_fired()
+    DeadlineEvent *handler = deadline_events.create(job->get_task(),
+                                                    job->get_release(),
+                                                    job->get_seqno(),
+                                                    job->get_cost(),
+                                                    this);
 
     Timeout<simtime_t> ev(job->get_deadline(), handler);
     events.push(ev);
@@ -262,6 +264,21 @@ void CANBusScheduler::reset_events_and_pending_queues()
 
     while(!pending.empty())
         pending.pop();
+
+    // reclaim the deadline events that never fired
+    deadline_events.clear();
+}
+
+void CANBusScheduler::deadline_event_fired(DeadlineEvent *event)
+{
+    job_deadline_expired(event);
+    deadline_events.destroy(event);
+}
+
+void DeadlineEvent::fire(const simtime_t &time)
+{
+    // this object is destroyed by the call
+    ((CANBusScheduler *)sim)->deadline_event_fired(this);
 }
 
 bool CANBusScheduler::gen_retransmissions(double rate, simtime_t max)
@@ -283,19 +300,20 @@ bool CANBusScheduler::gen_retransmissions(double rate, simtime_t max)
 
 bool CANBusScheduler::is_retransmission(simtime_t start, simtime_t end)
 {
-    while(!retransmissions.empty())
+    while (next_retransmission < retransmissions.size())
     {
-        if (end < retransmissions.front())
+        simtime_t fault = retransmissions[next_retransmission++];
+
+        if (end < fault)
+        {
+            next_retransmission--;
             return false;
+        }
         
-        if (start <= retransmissions.front() && retransmissions.front() <= end)
-        {
-            retransmissions.erase(retransmissions.begin());
+        if (start <= fault && fault <= end)
             return true;
-        }
 
-        // if (retransmissions.front() < start)
-        retransmissions.erase(retransmissions.begin());
+        // if (fault < start), the fault is skipped
     }
 
     return false;
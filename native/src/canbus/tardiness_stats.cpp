@@ -266,12 +266,14 @@ void simulate_for_tardiness_stats(CANTaskSet &ts,
    
     // create a job structure for each task, and add the first job of
     // each task in the pending jobs queue
-    PeriodicCANJobSequence** jobs = new PeriodicCANJobSequence*[ts.get_task_count()];
+    // reserved up front: the simulator keeps pointers to the jobs
+    std::vector<PeriodicCANJobSequence> jobs;
+    jobs.reserve(ts.get_task_count());
     for (unsigned int i = 0; i < ts.get_task_count(); i++)
     {
-        jobs[i] = new PeriodicCANJobSequence(ts[i]);
-        jobs[i]->set_simulation(&sim);
-        sim.add_release(jobs[i]);
+        jobs.push_back(PeriodicCANJobSequence(ts[i]));
+        jobs[i].set_simulation(&sim);
+        sim.add_release(&jobs[i]);
     }
 
     // the objective is to run the simulation for 'iterations' times; 
@@ -297,7 +299,7 @@ void simulate_for_tardiness_stats(CANTaskSet &ts,
             // separately (assuming each task is on separate host)
             if (ts[j].is_critical())
             {
-                bool zero_host_faults = jobs[j]->gen_host_faults(
+                bool zero_host_faults = jobs[j].gen_host_faults(
                                                         host_fault_rate,
                                                         sim_len_bit_time,
                                                         boot_time_bit_time );
@@ -362,8 +364,8 @@ void simulate_for_tardiness_stats(CANTaskSet &ts,
         // for the next iteration 
         for (unsigned int i = 0; i < ts.get_task_count(); i++)
         {
-            jobs[i]->reset_params();
-            sim.add_release(jobs[i]);
+            jobs[i].reset_params();
+            sim.add_release(&jobs[i]);
         }
     }
 
@@ -415,11 +417,6 @@ void simulate_for_tardiness_stats(CANTaskSet &ts,
         prob /= iterations;
     }
 
-    // free memory used for job structres
-    for (unsigned int i = 0; i < ts.get_task_count(); i++)
-        delete jobs[i];
-    delete [] jobs;
-
     // output final stats
     cout << num_replicas << " ";
 
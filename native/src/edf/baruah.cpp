@@ -1,20 +1,22 @@
 #include <algorithm> // for greater
 #include <queue>
 #include <vector>
+#include <atomic>
 
 #include "tasks.h"
+#include "task_columns.h"
 #include "schedulability.h"
 
 #include "edf/baruah.h"
+#include "math-helper.h"
+#include "parallel.h"
 
 #include <iostream>
 #include "task_io.h"
 
-#include "cpu_time.h"
-
 using namespace std;
 
-const double BaruahGedf::MAX_RUNTIME = 5.0; /* seconds */
+const double BaruahGedf::MAX_RUNTIME = 5.0; /* seconds, default budget */
 
 
 static void demand_bound_function(const Task &tsk,
@@ -65,6 +67,17 @@ public:
     {
         cur += pi;
     }
+
+    // advance to the first point of change at or after t
+    void skip_to(const integral_t &t)
+    {
+        if (cur < t)
+        {
+            integral_t steps = t - cur + pi - 1;
+            steps /= pi;
+            cur += steps * pi;
+        }
+    }
 };
 
 class DBFComparator {
@@ -89,12 +102,20 @@ private:
 
 public:
     void init(const TaskSet &ts, int k, integral_t* bound)
+    {
+        init(ts, k, 0, bound);
+    }
+
+    // only the points in [lower, *bound]
+    void init(const TaskSet &ts, int k, const integral_t &lower,
+              integral_t* bound)
     {
         last = -1;
         dbf = new DBFPointsOfChange[ts.get_task_count()];
         for (unsigned int i = 0; i < ts.get_task_count(); i++)
         {
             dbf[i].init(ts[i], ts[k]);
+            dbf[i].skip_to(lower);
             queue.push(dbf + i);
         }
         upper_bound = bound;
@@ -125,13 +146,11 @@ public:
     }
 };
 
+// dbf is demand_bound_function() of ts[i] at ilen + d_k
 static
 void interval1(unsigned int i, unsigned int k, const TaskSet &ts,
-               const integral_t &ilen, integral_t &i1)
+               const integral_t &ilen, const integral_t &dbf, integral_t &i1)
 {
-    integral_t dbf, tmp;
-    tmp = ilen + ts[k].get_deadline();
-    demand_bound_function(ts[i], tmp, dbf);
     if (i == k)
         i1 = min(integral_t(dbf - ts[k].get_wcet()), ilen);
     else
@@ -152,13 +171,11 @@ static void demand_bound_function_prime(const Task &tsk,
     db += min(integral_t(tsk.get_wcet()), integral_t(t % tsk.get_period()));
 }
 
+// dbf is demand_bound_function_prime() of ts[i] at ilen + d_k
 static void interval2(unsigned int i, unsigned int k, const TaskSet &ts,
-                       const integral_t &ilen, integral_t &i2)
+                       const integral_t &ilen, const integral_t &dbf,
+                       integral_t &i2)
 {
-    integral_t dbf, tmp;
-
-    tmp = ilen + ts[k].get_deadline();
-    demand_bound_function_prime(ts[i], tmp, dbf);
     if (i == k)
         i2 = min(integral_t(dbf - ts[k].get_wcet()), ilen);
     else
@@ -167,38 +184,47 @@ static void interval2(unsigned int i, unsigned int k, const TaskSet &ts,
                            (ts[k].get_wcet() - 1)));
 }
 
-class MPZComparator {
-public:
-    bool operator() (integral_t *a, integral_t *b)
-    {
-        return *b < *a;
-    }
-};
-
 bool BaruahGedf::is_task_schedulable(unsigned int k,
                                      const TaskSet &ts,
+                                     const TaskColumns &cols,
                                      const integral_t &ilen,
                                      integral_t &i1,
                                      integral_t &sum,
                                      integral_t *idiff,
-                                     integral_t **ptr)
+                                     integral_t **ptr,
+                                     long *words,
+                                     unsigned long *dbf_fast,
+                                     unsigned long *dbf_prime_fast)
 {
-    integral_t bound;
+    integral_t bound, t, dbf, dbf_prime;
     sum = 0;
 
+    // evaluate all DBFs at once if it can be done exactly in hardware
+    t = ilen + ts[k].get_deadline();
+    bool fast = t.fits_ulong_p() &&
+        cols.demand_per_task(t.get_ui(), dbf_fast) &&
+        cols.carry_in_demand_per_task(t.get_ui(), dbf_prime_fast);
+
     for (unsigned int i = 0; i < ts.get_task_count(); i++)
     {
-        interval1(i, k, ts, ilen, i1);
-        interval2(i, k, ts, ilen, idiff[i]);
+        if (fast)
+        {
+            dbf       = dbf_fast[i];
+            dbf_prime = dbf_prime_fast[i];
+        }
+        else
+        {
+            demand_bound_function(ts[i], t, dbf);
+            demand_bound_function_prime(ts[i], t, dbf_prime);
+        }
+        interval1(i, k, ts, ilen, dbf, i1);
+        interval2(i, k, ts, ilen, dbf_prime, idiff[i]);
         sum      += i1;
         idiff[i] -= i1;
     }
 
-    /* sort pointers to idiff to find largest idiff values */
-    sort(ptr, ptr + ts.get_task_count(), MPZComparator());
-
-    for (unsigned int i = 0; i < m - 1 && i < ts.get_task_count(); i++)
-        sum += *ptr[i];
+    /* add the m-1 largest idiff values */
+    add_largest(sum, m - 1, idiff, ts.get_task_count(), ptr, words);
 
     bound  = ilen + ts[k].get_deadline() - ts[k].get_wcet();
     bound *= m;
@@ -243,6 +269,20 @@ void BaruahGedf::get_max_test_points(const TaskSet &ts,
 
 bool BaruahGedf::is_schedulable(const TaskSet &ts,
                                 bool check_preconditions)
+{
+    return check_default_limits(ts, check_preconditions) == SCHED_SCHEDULABLE;
+}
+
+sched_result_t BaruahGedf::check_default_limits(const TaskSet &ts,
+                                               bool check_preconditions)
+{
+    Budget budget(MAX_RUNTIME);
+    return check(ts, budget, check_preconditions);
+}
+
+sched_result_t BaruahGedf::check(const TaskSet &ts,
+                                 Budget &budget,
+                                 bool check_preconditions)
 {
     if (check_preconditions)
 	{
@@ -250,10 +290,10 @@ bool BaruahGedf::is_schedulable(const TaskSet &ts,
               ts.is_not_overutilized(m) &&
               ts.has_only_constrained_deadlines() &&
               ts.has_no_self_suspending_tasks()))
-            return false;
+            return SCHED_UNSCHEDULABLE;
 
         if (ts.get_task_count() == 0)
-            return true;
+            return SCHED_SCHEDULABLE;
     }
 
     fractional_t m_minus_u;
@@ -265,23 +305,41 @@ bool BaruahGedf::is_schedulable(const TaskSet &ts,
         // Baruah's G-EDF test requires strictly positive slack.
         // In the case of zero slack the testing interval becomes
         // infinite. Therefore, we can't do anything but bail out.
-        return false;
+        return SCHED_UNSCHEDULABLE;
     }
 
-    double start_time = get_cpu_usage();
-
     integral_t i1, sum;
     integral_t *max_test_point, *idiff;
     integral_t** ptr; // indirect access to idiff
+    long *words;      // idiff in machine words, if possible
 
     idiff          = new integral_t[ts.get_task_count()];
     max_test_point = new integral_t[ts.get_task_count()];
     ptr            = new integral_t*[ts.get_task_count()];
     for (unsigned int i = 0; i < ts.get_task_count(); i++)
         ptr[i] = idiff + i;
+    words          = new long[ts.get_task_count()];
+
+    TaskColumns cols(ts);
+    unsigned long *dbf_fast       = new unsigned long[ts.get_task_count()];
+    unsigned long *dbf_prime_fast = new unsigned long[ts.get_task_count()];
 
     get_max_test_points(ts, m_minus_u, max_test_point);
 
+    unsigned int threads = num_threads ? num_threads : default_thread_count();
+    if (threads > 1)
+    {
+        sched_result_t result = check_in_parallel(ts, cols, max_test_point,
+                                                  threads, budget);
+        delete[] max_test_point;
+        delete[] idiff;
+        delete[] ptr;
+        delete[] words;
+        delete[] dbf_fast;
+        delete[] dbf_prime_fast;
+        return result;
+    }
+
     integral_t ilen;
     bool point_in_range = true;
     bool schedulable = true;
@@ -293,24 +351,24 @@ bool BaruahGedf::is_schedulable(const TaskSet &ts,
         all_pts[k].init(ts, k, max_test_point + k);
 
     // for every task for which point <= max_ak
-    unsigned long iter_count = 0;
     while (point_in_range && schedulable)
     {
         point_in_range = false;
-        // check for excessive run time every 10 iterations
-        if (++iter_count % 10 == 0 && get_cpu_usage() > start_time + MAX_RUNTIME)
-        {
+        if (!budget.charge_iteration())
              // This is taking too long. Give up.
-             schedulable = false;
              break;
-        }
         for (unsigned int k = 0; k < ts.get_task_count() && schedulable; k++)
             if (all_pts[k].get_next(ilen))
             {
-                schedulable = is_task_schedulable(k, ts, ilen, i1, sum,
-                                                  idiff, ptr);
+                if (!budget.charge_test_point())
+                    break;
+                schedulable = is_task_schedulable(k, ts, cols, ilen, i1, sum,
+                                                  idiff, ptr, words, dbf_fast,
+                                                  dbf_prime_fast);
                 point_in_range = true;
             }
+        if (budget.is_exhausted())
+            break;
     }
 
 
@@ -318,7 +376,109 @@ bool BaruahGedf::is_schedulable(const TaskSet &ts,
     delete[] max_test_point;
     delete[] idiff;
     delete[] ptr;
+    delete[] words;
+    delete[] dbf_fast;
+    delete[] dbf_prime_fast;
 
-    return schedulable;
+    if (budget.is_exhausted())
+        return SCHED_UNKNOWN;
+    return schedulable ? SCHED_SCHEDULABLE : SCHED_UNSCHEDULABLE;
 }
 
+
+// per-worker state of check_in_parallel()
+struct BaruahWorker
+{
+    std::vector<integral_t> idiff;
+    std::vector<integral_t*> ptr;
+    std::vector<long> words;
+    std::vector<unsigned long> dbf_fast, dbf_prime_fast;
+    integral_t i1, sum;
+    Budget budget;
+    bool active;
+
+    BaruahWorker() : active(false) {}
+};
+
+sched_result_t BaruahGedf::check_in_parallel(const TaskSet &ts,
+                                             const TaskColumns &cols,
+                                             integral_t *max_test_point,
+                                             unsigned int threads,
+                                             Budget &budget)
+{
+    const unsigned int n = ts.get_task_count();
+
+    if (!budget.charge_iteration())
+        return SCHED_UNKNOWN;
+
+    // Split the test interval of each task into one range per thread so
+    // that a single task with many test points can keep all threads busy.
+    const unsigned int ranges = threads;
+    std::vector<integral_t> range_start(n * (ranges + 1));
+    for (unsigned int k = 0; k < n; k++)
+        for (unsigned int r = 0; r <= ranges; r++)
+        {
+            integral_t &start = range_start[k * (ranges + 1) + r];
+            start = max_test_point[k] * r;
+            start /= ranges;
+            if (r == ranges)
+                // the last range includes the max. test point
+                start = max_test_point[k] + 1;
+        }
+
+    const Budget share = budget.remaining();
+    std::vector<BaruahWorker> workers(threads);
+    std::atomic<bool> failed(false);
+
+    parallel_for((unsigned long) n * ranges, threads,
+        [&](unsigned int w, unsigned long item)
+        {
+            BaruahWorker &wk = workers[w];
+            if (!wk.active)
+            {
+                wk.idiff.resize(n);
+                wk.ptr.resize(n);
+                for (unsigned int i = 0; i < n; i++)
+                    wk.ptr[i] = &wk.idiff[i];
+                wk.words.resize(n);
+                wk.dbf_fast.resize(n);
+                wk.dbf_prime_fast.resize(n);
+                // the clock is per thread
+                wk.budget = share;
+                wk.budget.reset();
+                wk.active = true;
+            }
+
+            const unsigned int k = item / ranges;
+            const unsigned int r = item % ranges;
+            const integral_t *bounds = &range_start[k * (ranges + 1) + r];
+            integral_t last = bounds[1] - 1;
+            if (bounds[0] > last)
+                return;
+
+            AllDBFPointsOfChange pts;
+            pts.init(ts, k, bounds[0], &last);
+
+            integral_t ilen;
+            while (!failed && !wk.budget.is_exhausted() && pts.get_next(ilen))
+            {
+                if (!wk.budget.charge_test_point())
+                    break;
+                if (!is_task_schedulable(k, ts, cols, ilen, wk.i1, wk.sum,
+                                         &wk.idiff[0], &wk.ptr[0],
+                                         &wk.words[0],
+                                         &wk.dbf_fast[0],
+                                         &wk.dbf_prime_fast[0]))
+                    failed = true;
+            }
+        });
+
+    for (unsigned int w = 0; w < threads; w++)
+        if (workers[w].active)
+            budget.absorb(workers[w].budget);
+
+    // a violation is a definite answer even if other ranges gave up
+    if (failed)
+        return SCHED_UNSCHEDULABLE;
+    return budget.is_exhausted() ? SCHED_UNKNOWN : SCHED_SCHEDULABLE;
+}
@@ -1,4 +1,5 @@
 #include <algorithm> // for min
+#include <atomic>
 #include <queue>
 #include <vector>
 
@@ -7,6 +8,7 @@
 #include "math-helper.h"
 
 #include "edf/ffdbf.h"
+#include "parallel.h"
 
 #include <iostream>
 #include "task_io.h"
@@ -207,11 +209,411 @@ bool FFDBFGedf::witness_condition(const TaskSet &ts,
     return demand <= bound;
 }
 
+/* Fixed-denominator version of the sweep.
+ *
+ * For a speed sigma = a/b (in lowest terms), every test point is a
+ * multiple of 1/a, and all terms of the witness condition have
+ * denominators that divide a * b. Hence, with times represented as
+ * numerators over a common denominator, the whole sweep runs in integer
+ * arithmetic: 64 bits for times and 128 bits for the demand sums. The
+ * sweep is used whenever the values provably fit (see check_fixed()); it
+ * yields exactly the same results as the rational sweep below.
+ */
+
+typedef __int128 wide_t;
+
+// sigma = a / b
+struct FixedSpeed
+{
+    long a, b;
+
+    FixedSpeed(long num = 1, long den = 1)
+    {
+        long g = num, h = den;
+        while (h)
+        {
+            long tmp = g % h;
+            g = h;
+            h = tmp;
+        }
+        a = num / g;
+        b = den / g;
+    }
+};
+
+// the point in time n / den
+struct FixedTime
+{
+    long n, den;
+};
+
+static bool operator<=(const FixedTime &x, const FixedTime &y)
+{
+    return (wide_t) x.n * y.den <= (wide_t) y.n * x.den;
+}
+
+// time <= bound, for an integral bound
+static bool within(const FixedTime &t, long bound)
+{
+    return t.n <= (wide_t) bound * t.den;
+}
+
+// witness_condition() at time t
+static bool fixed_witness(const TaskSet &ts, unsigned int m,
+                          const FixedTime &t, const FixedSpeed &s)
+{
+    // demand and bound, both scaled by t.den * s.b
+    wide_t demand = 0, bound;
+
+    for (unsigned int i = 0; i < ts.get_task_count(); i++)
+    {
+        const wide_t period = ts[i].get_period();
+        const wide_t wcet   = ts[i].get_wcet();
+        const wide_t dl     = ts[i].get_deadline();
+
+        wide_t q = t.n / (t.den * period);
+        wide_t r = t.n - q * t.den * period; // r_i, scaled by t.den
+
+        demand += q * t.den * wcet * s.b;
+
+        // r_i >= deadline - wcet / sigma?
+        if (r * s.a >= t.den * (dl * s.a - wcet * s.b))
+        {
+            demand += t.den * wcet * s.b;
+            if (r <= dl * t.den)
+                demand -= (dl * t.den - r) * s.a;
+        }
+    }
+
+    bound  = (wide_t) m * s.b - (wide_t) (m - 1) * s.a;
+    bound *= t.n;
+
+    return demand <= bound;
+}
+
+// the test points of one task in units of 1/a, cf. TestPoints
+class FixedTestPoints
+{
+private:
+    long time;
+    long with_offset;
+    long step;
+    bool first_point;
+
+public:
+    void init(const Task& t_i, const FixedSpeed &s, const FixedTime &min_time)
+    {
+        step = s.a * t_i.get_period();
+
+        long offset = std::min((wide_t) t_i.get_wcet() * s.b,
+                               (wide_t) t_i.get_deadline() * s.a);
+
+        long k = min_time.n / ((wide_t) min_time.den * t_i.get_period());
+        time = (k * t_i.get_period() + t_i.get_deadline()) * s.a;
+        with_offset = time - offset;
+        first_point = true;
+
+        FixedTime cur = {get_cur(), s.a};
+        while (cur <= min_time)
+        {
+            next();
+            cur.n = get_cur();
+        }
+    }
+
+    long get_cur() const
+    {
+        return first_point ? with_offset : time;
+    }
+
+    void next()
+    {
+        if (first_point)
+            first_point = false;
+        else
+        {
+            time        += step;
+            with_offset += step;
+            first_point  = true;
+        }
+    }
+};
+
+class FixedTimeComparator {
+public:
+    bool operator() (FixedTestPoints *a, FixedTestPoints *b)
+    {
+        return b->get_cur() < a->get_cur();
+    }
+};
+
+// all test points of a task set in units of 1/a, cf. AllTestPoints
+class AllFixedTestPoints
+{
+private:
+    std::vector<FixedTestPoints> pts;
+    priority_queue<FixedTestPoints*,
+                   vector<FixedTestPoints*>,
+                   FixedTimeComparator> queue;
+    long last;
+
+public:
+    void init(const TaskSet &ts, const FixedSpeed &s,
+              const FixedTime &min_time)
+    {
+        pts.resize(ts.get_task_count());
+        last = -1;
+        while (!queue.empty())
+            queue.pop();
+        for (unsigned int i = 0; i < ts.get_task_count(); i++)
+        {
+            pts[i].init(ts[i], s, min_time);
+            queue.push(&pts[i]);
+        }
+    }
+
+    long get_next()
+    {
+        long t;
+        FixedTestPoints* pt;
+        do // avoid duplicates
+        {
+            pt = queue.top();
+            queue.pop();
+            t = pt->get_cur();
+            pt->next();
+            queue.push(pt);
+        } while (t == last);
+        last = t;
+        return t;
+    }
+};
+
+/* Checks the test points after t at speed s, in order, up to the time
+ * bound. Returns true if all of them pass; otherwise, t is the first point
+ * that fails (unless the budget ran out).
+ */
+bool FFDBFGedf::scan_fixed(const TaskSet &ts, const FixedSpeed &s,
+                           long time_bound, FixedTime &t, Budget &budget)
+{
+    unsigned int threads = num_threads ? num_threads : default_thread_count();
+    if (threads > 1)
+        return scan_fixed_in_parallel(ts, s, time_bound, t, threads, budget);
+
+    AllFixedTestPoints points;
+    points.init(ts, s, t);
+    for (;;)
+    {
+        t.n = points.get_next();
+        t.den = s.a;
+        if (!within(t, time_bound))
+            // exceeded testing interval
+            return true;
+        if (!budget.charge_test_point())
+            return false;
+        if (!fixed_witness(ts, m, t, s))
+            return false;
+    }
+}
+
+/* Same as above, but the testing interval is cut into windows, which are
+ * scanned concurrently in rounds of one window per thread. A failure in
+ * one window cancels the windows after it, but not those before it, so
+ * that the first failing point is found as in the sequential scan.
+ */
+bool FFDBFGedf::scan_fixed_in_parallel(const TaskSet &ts,
+                                       const FixedSpeed &s,
+                                       long time_bound, FixedTime &t,
+                                       unsigned int threads, Budget &budget)
+{
+    // aim for a few thousand test points per window (two per period)
+    enum { POINTS_PER_WINDOW = 4096 };
+    double rate = 0;
+    for (unsigned int i = 0; i < ts.get_task_count(); i++)
+        rate += 2.0 / ts[i].get_period();
+
+    // all times in units of 1/a
+    const long start = (wide_t) t.n * s.a / t.den;
+    const long end = time_bound * s.a;
+
+    // one round suffices for short intervals
+    long window = (end - start) / threads + 1;
+    if (POINTS_PER_WINDOW / rate * s.a < window)
+        window = std::max(1.0, POINTS_PER_WINDOW / rate * s.a);
+
+    const unsigned long num_windows = threads;
+    const FixedTime first = t;
+    std::vector<Budget> budgets(threads);
+    std::vector<char> active(threads);
+    std::vector<AllFixedTestPoints> points(threads);
+    std::vector<long> failure(num_windows);
+
+    for (long round_start = start; round_start <= end; )
+    {
+        const Budget share = budget.remaining();
+        std::atomic<unsigned long> first_failed(num_windows);
+        std::fill(active.begin(), active.end(), false);
+
+        parallel_for(num_windows, threads,
+            [&](unsigned int w, unsigned long item)
+            {
+                if (!active[w])
+                {
+                    // the clock is per thread
+                    budgets[w] = share;
+                    budgets[w].reset();
+                    active[w] = true;
+                }
+
+                // the window (lo, hi]; the first one starts after t
+                long lo = round_start + (long) item * window;
+                long hi = std::min(lo + window, end);
+                if (lo > end)
+                    return;
+                FixedTime from = {lo, s.a};
+                if (lo == start)
+                    from = first;
+
+                points[w].init(ts, s, from);
+                for (;;)
+                {
+                    FixedTime cur = {points[w].get_next(), s.a};
+                    if (cur.n > hi || item > first_failed)
+                        break;
+                    if (!budgets[w].charge_test_point())
+                        break;
+                    if (!fixed_witness(ts, m, cur, s))
+                    {
+                        failure[item] = cur.n;
+                        // keep the earliest failing window
+                        unsigned long prev = first_failed;
+                        while (item < prev &&
+                               !first_failed.compare_exchange_weak(prev, item))
+                            ;
+                        break;
+                    }
+                }
+            });
+
+        for (unsigned int w = 0; w < threads; w++)
+            if (active[w])
+                budget.absorb(budgets[w]);
+
+        if (budget.is_exhausted())
+            return false;
+
+        if (first_failed < num_windows)
+        {
+            t.n = failure[first_failed];
+            t.den = s.a;
+            return false;
+        }
+
+        round_start += (long) num_windows * window;
+    }
+
+    // no failure up to the end of the testing interval
+    return true;
+}
+
+/* The sweep below in integer arithmetic. Returns false if the values
+ * involved might not fit.
+ */
+bool FFDBFGedf::check_fixed(const TaskSet &ts, Budget &budget,
+                            sched_result_t &result)
+{
+    const long LIMIT = 1L << 31;
+
+    fractional_t max_density;
+    ts.get_max_density(max_density);
+    integral_t num = max_density.get_num(), den = max_density.get_den();
+    if (!num.fits_slong_p() || !den.fits_slong_p() ||
+        num.get_si() >= LIMIT || den.get_si() >= LIMIT ||
+        sigma_granularity >= (unsigned long) LIMIT ||
+        m >= (unsigned int) LIMIT)
+        return false;
+
+    // time_bound = sum of WCETs / epsilon; at least one test point beyond
+    // it must fit as well
+    wide_t time_bound = 0, horizon = 0;
+    for (unsigned int i = 0; i < ts.get_task_count(); i++)
+    {
+        time_bound += ts[i].get_wcet();
+        horizon = std::max(horizon,
+                           (wide_t) ts[i].get_period() + ts[i].get_deadline());
+    }
+    time_bound *= epsilon_denom;
+    horizon += time_bound;
+    if (horizon * std::max((long) sigma_granularity, num.get_si())
+        >= ((wide_t) 1) << 62)
+        return false;
+
+    fractional_t sigma_bound;
+    fractional_t tmp(1, epsilon_denom);
+
+    // compute sigma bound
+    ts.get_utilization(sigma_bound);
+    sigma_bound -= m;
+    sigma_bound /= - ((int) (m - 1)); // neg. to flip sign
+    sigma_bound -= tmp; // epsilon
+    sigma_bound = min(sigma_bound, fractional_t(1));
+
+    FixedTime t_cur = {0, 1};
+    bool schedulable = false;
+
+    // Start with minimum possible sigma value, then try
+    // multiples of sigma_step.
+    fractional_t sigma_cur = max_density;
+    FixedSpeed speed(num.get_si(), den.get_si());
+
+    // setup brute force sigma value range
+    fractional_t sigma_nxt = sigma_cur / sigma_step;
+    truncate_fraction(sigma_nxt);
+    sigma_nxt += 1;
+    long k_nxt = integral_t(sigma_nxt.get_num() / sigma_nxt.get_den()).get_si();
+    sigma_nxt *= sigma_step;
+
+    while (!schedulable &&
+           sigma_cur <= sigma_bound &&
+           within(t_cur, time_bound) &&
+           budget.charge_iteration())
+    {
+        schedulable = scan_fixed(ts, speed, time_bound, t_cur, budget);
+
+        if (!schedulable && within(t_cur, time_bound)
+            && !budget.is_exhausted())
+        {
+            // find next sigma variable
+            do
+            {
+                sigma_cur = sigma_nxt;
+                speed = FixedSpeed(k_nxt++, sigma_granularity);
+                sigma_nxt += sigma_step;
+            } while (sigma_cur <= sigma_bound &&
+                     !fixed_witness(ts, m, t_cur, speed));
+        }
+    }
+
+    if (budget.is_exhausted())
+        result = SCHED_UNKNOWN;
+    else
+        result = schedulable ? SCHED_SCHEDULABLE : SCHED_UNSCHEDULABLE;
+    return true;
+}
+
 bool FFDBFGedf::is_schedulable(const TaskSet &ts,
                                bool check_preconditions)
+{
+    Budget unlimited;
+    return check(ts, unlimited, check_preconditions) == SCHED_SCHEDULABLE;
+}
+
+sched_result_t FFDBFGedf::check(const TaskSet &ts,
+                                Budget &budget,
+                                bool check_preconditions)
 {
     if (m < 2)
-        return false;
+        return SCHED_UNSCHEDULABLE;
 
     if (check_preconditions)
 	{
@@ -219,9 +621,13 @@ bool FFDBFGedf::is_schedulable(const TaskSet &ts,
               ts.is_not_overutilized(m) &&
               ts.has_only_constrained_deadlines() &&
               ts.has_no_self_suspending_tasks()))
-            return false;
+            return SCHED_UNSCHEDULABLE;
     }
 
+    sched_result_t result;
+    if (check_fixed(ts, budget, result))
+        return result;
+
     // allocate helpers
     AllTestPoints testing_set(ts);
     integral_t *q = new integral_t[ts.get_task_count()];
@@ -265,22 +671,25 @@ bool FFDBFGedf::is_schedulable(const TaskSet &ts,
 
     while (!schedulable &&
            sigma_cur <= sigma_bound &&
-           t_cur <= time_bound)
+           t_cur <= time_bound &&
+           budget.charge_iteration())
     {
         testing_set.init(sigma_cur, t_cur);
         do {
             testing_set.get_next(t_cur);
-            if (t_cur <= time_bound)
+            if (t_cur > time_bound)
+                // exceeded testing interval
+                schedulable = true;
+            else if (!budget.charge_test_point())
+                break;
+            else
             {
                 compute_q_r(ts, t_cur, q, r);
                 schedulable = witness_condition(ts, q, r, t_cur, sigma_cur);
             }
-            else
-                // exceeded testing interval
-                schedulable = true;
         } while (t_cur <= time_bound && schedulable);
 
-        if (!schedulable && t_cur <= time_bound)
+        if (!schedulable && t_cur <= time_bound && !budget.is_exhausted())
         {
             // find next sigma variable
             do
@@ -295,5 +704,7 @@ bool FFDBFGedf::is_schedulable(const TaskSet &ts,
     delete [] q;
     delete [] r;
 
-    return schedulable;
+    if (budget.is_exhausted())
+        return SCHED_UNKNOWN;
+    return schedulable ? SCHED_SCHEDULABLE : SCHED_UNSCHEDULABLE;
 }
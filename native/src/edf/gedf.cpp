@@ -1,5 +1,9 @@
+#include <algorithm>
+#include <mutex>
+
 #include "tasks.h"
 #include "schedulability.h"
+#include "cpu_time.h"
 
 #include "edf/baker.h"
 #include "edf/baruah.h"
@@ -12,20 +16,197 @@
 #include "edf/la.h"
 #include "edf/gedf.h"
 
+// With a budget, all tests draw on it; without one, each test applies its
+// own default limits. Remembers whether the test gave up.
+template <typename Test>
+static bool passes(Test test, const TaskSet &ts, Budget *budget,
+                   bool &unknown)
+{
+    sched_result_t result = budget ? test.check(ts, *budget, false)
+        : test.check_default_limits(ts, false);
+    if (result == SCHED_UNKNOWN)
+        unknown = true;
+    return result == SCHED_SCHEDULABLE;
+}
+
+/* What GlobalEDF has learned about its sub-tests in adaptive mode, per
+ * class of task sets.
+ */
+class GEDFLearnedOrder
+{
+  public:
+    struct Record
+    {
+        unsigned long calls;
+        unsigned long accepts;
+        double time;
+    };
+
+  private:
+    enum {
+        COUNT_CLASSES = 6,  // fewer than 4, 8, ..., 64 tasks, or more
+        UTIL_CLASSES  = 10, // tenths of the utilization per processor
+    };
+
+    mutable std::mutex lock;
+    Record records[COUNT_CLASSES * UTIL_CLASSES][GEDF_NUM_SUBTESTS];
+
+    // Until a sub-test has been observed, assume costs (in seconds) that
+    // yield the default order.
+    static const double PRIOR_COST[GEDF_NUM_SUBTESTS];
+
+  public:
+    GEDFLearnedOrder()
+    {
+        for (unsigned int c = 0; c < COUNT_CLASSES * UTIL_CLASSES; c++)
+            for (unsigned int t = 0; t < GEDF_NUM_SUBTESTS; t++)
+            {
+                records[c][t].calls = records[c][t].accepts = 0;
+                records[c][t].time = 0;
+            }
+    }
+
+    static unsigned int classify(const TaskSet &ts, unsigned int m)
+    {
+        unsigned int by_count = 0;
+        while (by_count + 1 < COUNT_CLASSES
+               && ts.get_task_count() >= (4u << by_count))
+            by_count++;
+
+        fractional_t util;
+        ts.get_utilization(util);
+        unsigned int by_util = util.get_d() / m * UTIL_CLASSES;
+        by_util = std::min(by_util, (unsigned int) UTIL_CLASSES - 1);
+
+        return by_count * UTIL_CLASSES + by_util;
+    }
+
+    // Sort the given sub-tests by their expected time per acceptance,
+    // with add-one smoothing of the cost and of the acceptance rate.
+    void order(unsigned int cls, gedf_subtest_t *tests, unsigned int n) const
+    {
+        double score[GEDF_NUM_SUBTESTS];
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            for (unsigned int i = 0; i < n; i++)
+            {
+                const Record &r = records[cls][tests[i]];
+                double cost = (r.time + PRIOR_COST[tests[i]]) / (r.calls + 1);
+                double rate = (r.accepts + 1.0) / (r.calls + 2.0);
+                score[tests[i]] = cost / rate;
+            }
+        }
+        std::stable_sort(tests, tests + n,
+                         [&](gedf_subtest_t a, gedf_subtest_t b)
+                         { return score[a] < score[b]; });
+    }
+
+    void record(unsigned int cls, gedf_subtest_t test, bool accepted,
+                double time)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        Record &r = records[cls][test];
+        r.calls++;
+        if (accepted)
+            r.accepts++;
+        r.time += time;
+    }
+
+    Record total(gedf_subtest_t test) const
+    {
+        Record sum = {0, 0, 0};
+        std::lock_guard<std::mutex> guard(lock);
+        for (unsigned int c = 0; c < COUNT_CLASSES * UTIL_CLASSES; c++)
+        {
+            sum.calls   += records[c][test].calls;
+            sum.accepts += records[c][test].accepts;
+            sum.time    += records[c][test].time;
+        }
+        return sum;
+    }
+};
+
+const double GEDFLearnedOrder::PRIOR_COST[GEDF_NUM_SUBTESTS] = {
+    1E-6, // Baker
+    2E-6, // GFB
+    1E-5, // RTA
+    1E-4, // Baruah
+    1E-3, // FF-DBF
+    2E-3, // LA
+    4E-3, // Load
+};
+
+GlobalEDF::~GlobalEDF()
+{
+    delete learned;
+}
+
+void GlobalEDF::set_adaptive(bool adaptive)
+{
+    delete learned;
+    learned = adaptive ? new GEDFLearnedOrder() : NULL;
+}
+
+bool GlobalEDF::is_adaptive() const
+{
+    return learned != NULL;
+}
+
+unsigned long GlobalEDF::get_subtest_calls(gedf_subtest_t test) const
+{
+    return learned ? learned->total(test).calls : 0;
+}
+
+unsigned long GlobalEDF::get_subtest_accepts(gedf_subtest_t test) const
+{
+    return learned ? learned->total(test).accepts : 0;
+}
+
+double GlobalEDF::get_subtest_time(gedf_subtest_t test) const
+{
+    return learned ? learned->total(test).time : 0;
+}
+
 bool GlobalEDF::is_schedulable(const TaskSet &ts,
                                bool check)
 {
+    return apply_tests(ts, NULL, check) == SCHED_SCHEDULABLE;
+}
+
+sched_result_t GlobalEDF::check(const TaskSet &ts,
+                                Budget &budget,
+                                bool check_preconditions)
+{
+    return apply_tests(ts, &budget, check_preconditions);
+}
+
+sched_result_t GlobalEDF::check_default_limits(const TaskSet &ts,
+                                               bool check_preconditions)
+{
+    return apply_tests(ts, NULL, check_preconditions);
+}
+
+sched_result_t GlobalEDF::apply_tests(const TaskSet &ts,
+                                      Budget *budget,
+                                      bool check)
+{
+    bool unknown = false;
+
     if (check)
 	{
         if (!(ts.has_only_feasible_tasks() && ts.is_not_overutilized(m)))
-            return false;
+            return SCHED_UNSCHEDULABLE;
 
         if (ts.get_task_count() == 0)
-            return true;
+            return SCHED_SCHEDULABLE;
     }
 
     if (!ts.has_no_self_suspending_tasks())
-        return want_la && LAGedf(m).is_schedulable(ts, false);
+    {
+        if (want_la && passes(LAGedf(m), ts, budget, unknown))
+            return SCHED_SCHEDULABLE;
+        return unknown ? SCHED_UNKNOWN : SCHED_UNSCHEDULABLE;
+    }
 
     // density bound on a uniprocessor.
     if (m == 1)
@@ -33,30 +214,81 @@ bool GlobalEDF::is_schedulable(const TaskSet &ts,
         fractional_t density;
         ts.get_density(density);
         if (density <= 1)
-            return true;
+            return SCHED_SCHEDULABLE;
     }
 
+    gedf_subtest_t tests[GEDF_NUM_SUBTESTS];
+    unsigned int num_tests = 0;
+
     // Baker's test can deal with arbitrary deadlines.
     // It's cheap, so do it first.
-    if (BakerGedf(m).is_schedulable(ts, false))
-        return true;
+    tests[num_tests++] = GEDF_BAKER;
 
     // Baruah's test and the BCL and GFB tests assume constrained deadlines.
     if (ts.has_only_constrained_deadlines())
-	    if (GFBGedf(m).is_schedulable(ts, false)
-            || (want_rta && RTAGedf(m, rta_step).is_schedulable(ts, false))
-               // The RTA test generalizes the BCL and BCLIterative tests.
-            || (want_baruah && BaruahGedf(m).is_schedulable(ts, false))
-            || (want_ffdbf && FFDBFGedf(m).is_schedulable(ts, false)))
-            return true;
+    {
+        tests[num_tests++] = GEDF_GFB;
+        // The RTA test generalizes the BCL and BCLIterative tests.
+        if (want_rta)
+            tests[num_tests++] = GEDF_RTA;
+        if (want_baruah)
+            tests[num_tests++] = GEDF_BARUAH;
+        if (want_ffdbf)
+            tests[num_tests++] = GEDF_FFDBF;
+    }
 
     // LA test can handle arbitrary deadlines
-    if (want_la && LAGedf(m).is_schedulable(ts, false))
-        return true;
+    if (want_la)
+        tests[num_tests++] = GEDF_LA;
 
     // Load-based test can handle arbitrary deadlines.
-    if (want_load && LoadGedf(m).is_schedulable(ts, false))
-        return true;
+    if (want_load)
+        tests[num_tests++] = GEDF_LOAD;
 
-    return false;
+    if (!learned)
+    {
+        for (unsigned int i = 0; i < num_tests; i++)
+            if (run_subtest(tests[i], ts, budget, unknown))
+                return SCHED_SCHEDULABLE;
+    }
+    else
+    {
+        unsigned int cls = GEDFLearnedOrder::classify(ts, m);
+        learned->order(cls, tests, num_tests);
+        for (unsigned int i = 0; i < num_tests; i++)
+        {
+            double start = get_cpu_usage();
+            bool ok = run_subtest(tests[i], ts, budget, unknown);
+            learned->record(cls, tests[i], ok, get_cpu_usage() - start);
+            if (ok)
+                return SCHED_SCHEDULABLE;
+        }
+    }
+
+    // a test that gave up might have succeeded
+    return unknown ? SCHED_UNKNOWN : SCHED_UNSCHEDULABLE;
+}
+
+bool GlobalEDF::run_subtest(gedf_subtest_t test, const TaskSet &ts,
+                            Budget *budget, bool &unknown)
+{
+    switch (test)
+    {
+    case GEDF_BAKER:
+        return BakerGedf(m).is_schedulable(ts, false);
+    case GEDF_GFB:
+        return GFBGedf(m).is_schedulable(ts, false);
+    case GEDF_RTA:
+        return RTAGedf(m, rta_step).is_schedulable(ts, false);
+    case GEDF_BARUAH:
+        return passes(BaruahGedf(m), ts, budget, unknown);
+    case GEDF_FFDBF:
+        return passes(FFDBFGedf(m), ts, budget, unknown);
+    case GEDF_LA:
+        return passes(LAGedf(m), ts, budget, unknown);
+    case GEDF_LOAD:
+        return LoadGedf(m).is_schedulable(ts, false);
+    default:
+        return false;
+    }
 }
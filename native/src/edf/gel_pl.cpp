@@ -1,4 +1,5 @@
 #include "tasks.h"
+#include "math-helper.h"
 
 #include "edf/gel_pl.h"
 
@@ -20,11 +21,7 @@ GELPl::GELPl(unsigned int num_processors, const TaskSet& ts,
     fractional_t sys_utilization;
     tasks.get_utilization(sys_utilization);
     // Compute ceiling
-    integral_t util_ceil_pre = sys_utilization.get_num();
-    mpz_cdiv_q(util_ceil_pre.get_mpz_t(),
-               sys_utilization.get_num().get_mpz_t(),
-               sys_utilization.get_den().get_mpz_t());
-    util_ceil = util_ceil_pre.get_ui();
+    util_ceil = round_up(sys_utilization).get_ui();
     std::vector<unsigned long> prio_pts;
     fractional_t S = 0;
     std::vector<fractional_t> Y_ints;
@@ -95,10 +92,7 @@ GELPl::GELPl(unsigned int num_processors, const TaskSet& ts,
         x_comp /= no_cpus;
         x_i -= x_comp;
         // Compute ceiling
-        integral_t xi_ceil = x_i.get_num();
-        mpz_cdiv_q(xi_ceil.get_mpz_t(),
-                   x_i.get_num().get_mpz_t(),
-                   x_i.get_den().get_mpz_t());
+        integral_t xi_ceil = round_up(x_i);
         bounds.push_back(prio_pts[i]
                          + tasks[i].get_wcet()
                          + xi_ceil.get_ui());
@@ -9,6 +9,7 @@
 
 #include "math-helper.h"
 #include "tasks.h"
+#include "task_columns.h"
 #include "schedulability.h"
 
 #include "edf/la.h"
@@ -16,11 +17,9 @@
 #include <iostream>
 #include "task_io.h"
 
-#include "cpu_time.h"
-
 using namespace std;
 
-const double LAGedf::MAX_RUNTIME = 1.0; /* second per task per suspension length */
+const double LAGedf::MAX_RUNTIME = 1.0; /* second per task per suspension length, default budget */
 
 /* To be similar to the BaruahGedf implementation, `interval' is A_k (in Bar:07),
  * which is equivalent to xi_l - d_l in LA:13 */
@@ -120,18 +119,19 @@ namespace LA {
 
 }
 
+/* dbf is the DBF of ts[i] at ilen + d_l */
 static void work_no_carry(
     unsigned int i,
     unsigned int l,
     const TaskSet &ts,
     const integral_t &ilen,
+    const integral_t &dbf,
     integral_t &wnc,
     unsigned long susp
 )
 {
-    integral_t dbf, tmp;
+    integral_t tmp;
     tmp = ilen + ts[l].get_deadline(); /* tmp = xi_l - lambda_l */
-    dbf = ts[i].dbf(tmp);
     if (i == l)
         wnc = min(integral_t(dbf - ts[l].get_wcet()),
                  max(integral_t(tmp - ts[l].get_deadline()),
@@ -162,40 +162,32 @@ static integral_t delta(
     return db;
 }
 
+/* dbf is delta() of ts[i] at ilen + d_l + tardiness threshold of ts[i] */
 static void work_carry_in(
     unsigned int i,
     unsigned int l,
     const TaskSet &ts,
     const integral_t &ilen,
+    const integral_t &dbf,
     integral_t &wc,
     unsigned long susp)
 {
-    integral_t dbf, tmp;
+    integral_t tmp;
 
     tmp = ilen + ts[l].get_deadline(); /* tmp = xi_l - lambda_l */
 
     if (i == l) {
-        dbf = delta(ts[l], tmp + ts[l].get_tardiness_threshold());
         wc = min(integral_t(dbf - ts[l].get_wcet()),
                  max(integral_t(tmp - ts[l].get_deadline()),
                      integral_t((tmp + ts[l].get_tardiness_threshold())
                                 - ts[l].get_period())));
     } else {
-        dbf = delta(ts[i], tmp + ts[i].get_tardiness_threshold());
         wc = min(dbf,
                  integral_t(((tmp + ts[l].get_tardiness_threshold()) -
                              ts[l].get_wcet()) - susp + 1));
     }
 }
 
-class MPZComparator {
-public:
-    bool operator() (integral_t *a, integral_t *b)
-    {
-        return *b < *a;
-    }
-};
-
 bool LAGedf::is_task_schedulable_for_interval(
     const TaskSet &ts,
 	unsigned int l,
@@ -204,15 +196,39 @@ bool LAGedf::is_task_schedulable_for_interval(
 	integral_t &i1,
 	integral_t &sum,
 	integral_t *idiff,
-	integral_t **ptr)
+	integral_t **ptr,
+	long *words,
+	const TaskColumns &cols,
+	bool no_tardiness,
+	unsigned long *dbf_fast,
+	unsigned long *delta_fast)
 {
-    integral_t bound;
+    integral_t bound, t, dbf, dlt;
     sum = 0;
 
+    /* Evaluate all DBFs at once if it can be done exactly in hardware.
+     * delta() coincides with the carry-in demand computed by the columns,
+     * but is evaluated at a task-specific offset unless all tardiness
+     * thresholds are zero. */
+    t = ilen + ts[l].get_deadline();
+    bool fast_dbf = t.fits_ulong_p() &&
+        cols.demand_per_task(t.get_ui(), dbf_fast);
+    bool fast_delta = fast_dbf && no_tardiness &&
+        cols.carry_in_demand_per_task(t.get_ui(), delta_fast);
+
     for (unsigned int i = 0; i < ts.get_task_count(); i++)
     {
-        work_no_carry(i, l, ts, ilen, i1, suspend);
-        work_carry_in(i, l, ts, ilen, idiff[i], suspend);
+        if (fast_dbf)
+            dbf = dbf_fast[i];
+        else
+            dbf = ts[i].dbf(t);
+        if (fast_delta)
+            dlt = delta_fast[i];
+        else
+            dlt = delta(ts[i], t + ts[i].get_tardiness_threshold());
+
+        work_no_carry(i, l, ts, ilen, dbf, i1, suspend);
+        work_carry_in(i, l, ts, ilen, dlt, idiff[i], suspend);
 
         if (ts[i].is_self_suspending())
         {
@@ -226,13 +242,9 @@ bool LAGedf::is_task_schedulable_for_interval(
         }
     }
 
-    /* sort pointers to idiff to find largest idiff values */
-    sort(ptr, ptr + ts.get_task_count(), MPZComparator());
-
-    /* Get m-1 largest idiff values for compute tasks
+    /* Add m-1 largest idiff values for compute tasks
      * (self-suspending tasks have zero idiff). */
-    for (unsigned int i = 0; i < m - 1 && i < ts.get_task_count(); i++)
-        sum += *ptr[i];
+    add_largest(sum, m - 1, idiff, ts.get_task_count(), ptr, words);
 
     bound  = ilen + ts[l].get_deadline() + ts[l].get_tardiness_threshold()
                   - ts[l].get_wcet() - suspend;
@@ -276,53 +288,81 @@ bool LAGedf::is_task_schedulable_for_suspension_length(
 	unsigned long suspend,
 	const fractional_t &m_minus_u,
 	const fractional_t &test_point_sum,
-	const fractional_t &usum)
+	const fractional_t &usum,
+	const TaskColumns &cols,
+	bool no_tardiness,
+	Budget &budget)
 {
     bool schedulable = true;
 
     integral_t *idiff, i1, sum;
     integral_t** ptr; // indirect access to idiff
+    long *words;      // idiff in machine words, if possible
+    unsigned long *dbf_fast, *delta_fast;
 
     idiff          = new integral_t[ts.get_task_count()];
     ptr            = new integral_t*[ts.get_task_count()];
     for (unsigned int i = 0; i < ts.get_task_count(); i++)
         ptr[i] = idiff + i;
+    words          = new long[ts.get_task_count()];
+    dbf_fast       = new unsigned long[ts.get_task_count()];
+    delta_fast     = new unsigned long[ts.get_task_count()];
 
     LA::AllTestPoints all_pts(ts, l,
         get_max_test_point(ts, l, m_minus_u, test_point_sum, usum, suspend));
 
 //    cout << "    up to " << get_max_test_point(ts, l, m_minus_u, test_point_sum, usum, suspend) << endl;
 
-    unsigned long iter_count = 0;
-    double start_time = get_cpu_usage();
-
     for (integral_t ilen = 0; schedulable && all_pts.get_next(ilen); )
     {
-        // check for excessive run time every 10 iterations
-        if (++iter_count % 10 == 0 && get_cpu_usage() > start_time + MAX_RUNTIME)
+        if (!budget.charge_test_point())
              // This is taking too long. Give up.
             schedulable = false;
         else
             schedulable = is_task_schedulable_for_interval(
-                                ts, l, suspend, ilen, i1, sum, idiff, ptr);
+                                ts, l, suspend, ilen, i1, sum, idiff, ptr,
+                                words, cols, no_tardiness, dbf_fast, delta_fast);
     }
 
     delete [] idiff;
     delete [] ptr;
+    delete [] words;
+    delete [] dbf_fast;
+    delete [] delta_fast;
     return schedulable;
 }
 
 bool LAGedf::is_schedulable(const TaskSet &ts,
                                 bool check_preconditions)
+{
+    return check_all(ts, NULL, check_preconditions) == SCHED_SCHEDULABLE;
+}
+
+sched_result_t LAGedf::check(const TaskSet &ts,
+                             Budget &budget,
+                             bool check_preconditions)
+{
+    return check_all(ts, &budget, check_preconditions);
+}
+
+sched_result_t LAGedf::check_default_limits(const TaskSet &ts,
+                                            bool check_preconditions)
+{
+    return check_all(ts, NULL, check_preconditions);
+}
+
+sched_result_t LAGedf::check_all(const TaskSet &ts,
+                                 Budget *budget,
+                                 bool check_preconditions)
 {
     if (check_preconditions)
 	{
         if (!(ts.has_only_feasible_tasks() &&
               ts.is_not_overutilized(m)))
-            return false;
+            return SCHED_UNSCHEDULABLE;
 
         if (ts.get_task_count() == 0)
-            return true;
+            return SCHED_SCHEDULABLE;
     }
 
     fractional_t m_minus_u, usum;
@@ -333,35 +373,47 @@ bool LAGedf::is_schedulable(const TaskSet &ts,
         // Liu & Anderson's test requires strictly positive slack.
         // In the case of zero slack the testing interval becomes
         // infinite. Therefore, we can't do anything but bail out.
-        return false;
+        return SCHED_UNSCHEDULABLE;
     }
 
     // pre-compute static part of max test point calculation
     fractional_t test_point_sum = 0;
     fractional_t u;
+    bool no_tardiness = true;
     for (unsigned int i = 0; i < ts.get_task_count(); i++)
     {
         test_point_sum += ts[i].get_wcet();
         ts[i].get_utilization(u);
         test_point_sum += u * ts[i].get_tardiness_threshold();
+        if (ts[i].get_tardiness_threshold())
+            no_tardiness = false;
     }
 
+    TaskColumns cols(ts);
 
-    bool schedulable = true;
+
+    bool schedulable = true, gave_up = false;
     for (unsigned int l = 0; l < ts.get_task_count() && schedulable; l++)
     {
         for (unsigned long suspension = 0;
              suspension <= ts[l].get_self_suspension() && schedulable;
              suspension++)
         {
+            // without a caller's budget, each check gets MAX_RUNTIME
+            Budget per_check(MAX_RUNTIME);
+            Budget &b = budget ? *budget : per_check;
 //            cout << "Testing " << ts[l] << " susp = " << suspension << endl;
             if (!is_task_schedulable_for_suspension_length(ts, l, suspension,
-                    m_minus_u, test_point_sum, usum))
+                    m_minus_u, test_point_sum, usum, cols, no_tardiness,
+                    b))
                 schedulable = false;
-
+            if (b.is_exhausted())
+                gave_up = true;
         }
     }
 
-    return schedulable;
+    if (gave_up)
+        return SCHED_UNKNOWN;
+    return schedulable ? SCHED_SCHEDULABLE : SCHED_UNSCHEDULABLE;
 }
 
@@ -1,4 +1,5 @@
 #include "tasks.h"
+#include "math-helper.h"
 #include "schedulability.h"
 
 #include "edf/load.h"
@@ -34,11 +35,8 @@ bool LoadGedf::is_schedulable(const TaskSet &ts, bool check_preconditions)
 
     mu = m - (m - 1) * max_density;
 
-    mu_ceil = mu.get_num();
     // divide with ceiling
-    mpz_cdiv_q(mu_ceil.get_mpz_t(),
-               mu.get_num().get_mpz_t(),
-               mu.get_den().get_mpz_t());
+    mu_ceil = round_up(mu);
 
     cond1 = mu - (mu_ceil - 1) * max_density;
     cond2 = (mu_ceil - 1) - (mu_ceil - 2) * max_density;
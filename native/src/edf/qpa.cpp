@@ -8,6 +8,7 @@
 #include <limits.h>
 
 #include "tasks.h"
+#include "task_columns.h"
 #include "math-helper.h"
 #include "stl-helper.h"
 #include "schedulability.h"
@@ -26,30 +27,68 @@ QPATest::QPATest(unsigned int num_processors)
 	}
 }
 
-static integral_t edf_busy_interval(const TaskSet &ts)
+// sum of all DBFs; cols must describe ts
+static void bound_demand(const TaskSet &ts, const TaskColumns &cols,
+                         const integral_t &interval, integral_t &demand)
 {
-	integral_t interval = 0;
-	integral_t total_cost = 0;
+	unsigned long fast;
 
-	// initial guess: sum of all costs.
-	for (unsigned int i = 0; i < ts.get_task_count(); i++)
-	interval += ts[i].get_wcet();
+	if (interval.fits_ulong_p()
+	    && cols.bound_demand(interval.get_ui(), fast))
+		demand = fast;
+	else
+		ts.bound_demand(interval, demand);
+}
 
-	total_cost = interval;
-	do {
-		interval = total_cost;
-		total_cost = 0;
+// sum of all RBFs; cols must describe ts
+static void bound_request(const TaskSet &ts, const TaskColumns &cols,
+                          const integral_t &interval, integral_t &request)
+{
+	unsigned long fast;
+
+	if (interval.fits_ulong_p()
+	    && cols.bound_request(interval.get_ui(), fast))
+		request = fast;
+	else
+	{
+		request = 0;
 		for (unsigned int i = 0; i < ts.get_task_count(); i++)
 		{
 			integral_t jobs;
 			jobs = divide_with_ceil(interval, ts[i].get_period());
-			total_cost += jobs * ts[i].get_wcet();
+			request += jobs * ts[i].get_wcet();
 		}
+	}
+}
+
+// start must not exceed the length of the busy interval
+static integral_t edf_busy_interval(const TaskSet &ts,
+                                    const TaskColumns &cols,
+                                    const integral_t &start)
+{
+	integral_t interval = 0;
+	integral_t total_cost = start;
+
+	do {
+		interval = total_cost;
+		bound_request(ts, cols, interval, total_cost);
 	} while (interval != total_cost);
 
 	return interval;
 }
 
+static integral_t edf_busy_interval(const TaskSet &ts,
+                                    const TaskColumns &cols)
+{
+	integral_t total_cost = 0;
+
+	// initial guess: sum of all costs.
+	for (unsigned int i = 0; i < ts.get_task_count(); i++)
+	total_cost += ts[i].get_wcet();
+
+	return edf_busy_interval(ts, cols, total_cost);
+}
+
 static integral_t zhang_burns_interval(const TaskSet &ts)
 {
 	integral_t interval = 0;
@@ -78,6 +117,17 @@ static integral_t zhang_burns_interval(const TaskSet &ts)
 	return interval;
 }
 
+// same as above, from precomputed sums
+static integral_t zhang_burns_interval(const integral_t &max_delta,
+                                       const fractional_t &scaled_delta,
+                                       const fractional_t &total_util)
+{
+	fractional_t total_scaled_delta = scaled_delta;
+	total_scaled_delta /= (1 - total_util);
+
+	return std::max(max_delta, round_up(total_scaled_delta));
+}
+
 std::set<unsigned long> get_testpoints(const TaskSet &ts,
                                               const integral_t &max_time)
 {
@@ -139,16 +189,19 @@ static integral_t get_largest_testpoint(const TaskSet &ts,
 	return point;
 }
 
-integral_t QPATest::get_demand(integral_t interval, const TaskSet &ts)
+integral_t QPATest::get_demand(integral_t interval, const TaskSet &ts,
+                               const TaskColumns &cols)
 {
 	integral_t demand;
-	ts.bound_demand(interval, demand);
+	bound_demand(ts, cols, interval, demand);
 	return demand;
 }
 
-integral_t QPATest::get_max_interval(const TaskSet &ts, const fractional_t& util)
+integral_t QPATest::get_max_interval(const TaskSet &ts,
+                                     const TaskColumns &cols,
+                                     const fractional_t& util)
 {
-	integral_t max_interval = edf_busy_interval(ts);
+	integral_t max_interval = edf_busy_interval(ts, cols);
 
 	if (util < 1)
 		max_interval = std::min(max_interval, zhang_burns_interval(ts));
@@ -171,9 +224,12 @@ bool QPATest::is_schedulable(const TaskSet &ts, bool check_preconditions)
 	if (util > 1)
 		return false;
 
+	// vectorized demand evaluation for get_demand()/get_max_interval()
+	TaskColumns cols(ts);
+
 	unsigned long min_interval = min_relative_deadline(ts);
 
-	integral_t max_interval = get_max_interval(ts, util);
+	integral_t max_interval = get_max_interval(ts, cols, util);
 
 	integral_t next = get_largest_testpoint(ts, max_interval);
 	integral_t demand;
@@ -184,7 +240,7 @@ bool QPATest::is_schedulable(const TaskSet &ts, bool check_preconditions)
 		interval = next;
 
 
-		demand = get_demand(interval,ts);
+		demand = get_demand(interval, ts, cols);
 
 		if (demand < interval)
 			next = demand;
@@ -196,6 +252,170 @@ bool QPATest::is_schedulable(const TaskSet &ts, bool check_preconditions)
 	return demand <= min_interval;
 }
 
+IncrementalQPA::IncrementalQPA()
+	: cols(new TaskColumns(0u)),
+	  util(0), density(0), scaled_delta(0),
+	  num_infeasible(0), busy_interval_valid(false),
+	  state(SCHEDULABLE)
+{
+}
+
+IncrementalQPA::~IncrementalQPA()
+{
+	delete cols;
+}
+
+void IncrementalQPA::update_sums(const Task &tsk, int sign)
+{
+	fractional_t u, d;
+	tsk.get_utilization(u);
+	d = tsk.get_wcet();
+	d /= std::min(tsk.get_deadline(), tsk.get_period());
+
+	integral_t per = tsk.get_period();
+	integral_t dl  = tsk.get_deadline();
+
+	if (sign > 0)
+	{
+		util         += u;
+		density      += d;
+		scaled_delta += (per - dl) * u;
+	}
+	else
+	{
+		util         -= u;
+		density      -= d;
+		scaled_delta -= (per - dl) * u;
+	}
+
+	if (!tsk.is_feasible() || tsk.is_self_suspending())
+		num_infeasible += sign;
+}
+
+void IncrementalQPA::add_task(unsigned long wcet, unsigned long period,
+                              unsigned long deadline)
+{
+	tasks.add_task(wcet, period, deadline);
+
+	const Task &tsk = tasks[tasks.get_task_count() - 1];
+	cols->add_task(tsk.get_wcet(), tsk.get_period(), tsk.get_deadline());
+	update_sums(tsk, 1);
+
+	// busy_interval remains a valid starting point for the fixpoint search
+	state = UNKNOWN;
+}
+
+void IncrementalQPA::remove_task(unsigned int idx)
+{
+	update_sums(tasks[idx], -1);
+	tasks.remove_task(idx);
+	cols->remove_task(idx);
+
+	busy_interval_valid = false;
+	// removing demand cannot make a schedulable task set unschedulable
+	if (state != SCHEDULABLE)
+		state = UNKNOWN;
+}
+
+bool IncrementalQPA::is_schedulable()
+{
+	if (state == UNKNOWN)
+		state = check(0) ? SCHEDULABLE : UNSCHEDULABLE;
+	return state == SCHEDULABLE;
+}
+
+bool IncrementalQPA::add_task_if_schedulable(unsigned long wcet,
+                                             unsigned long period,
+                                             unsigned long deadline)
+{
+	bool was_schedulable = is_schedulable();
+	integral_t old_busy_interval = busy_interval;
+	bool old_busy_interval_valid = busy_interval_valid;
+
+	add_task(wcet, period, deadline);
+
+	// If the other tasks are schedulable, then the demand at any point
+	// before the new task's deadline is unchanged and known to be fine.
+	unsigned long known_ok_below = 0;
+	if (was_schedulable)
+		known_ok_below = tasks[tasks.get_task_count() - 1].get_deadline();
+
+	if (check(known_ok_below))
+	{
+		state = SCHEDULABLE;
+		return true;
+	}
+	else
+	{
+		// roll back
+		unsigned int idx = tasks.get_task_count() - 1;
+		update_sums(tasks[idx], -1);
+		tasks.remove_task(idx);
+		cols->remove_task(idx);
+		busy_interval = old_busy_interval;
+		busy_interval_valid = old_busy_interval_valid;
+		state = was_schedulable ? SCHEDULABLE : UNSCHEDULABLE;
+		return false;
+	}
+}
+
+bool IncrementalQPA::check(unsigned long known_ok_below)
+{
+	if (num_infeasible || util > 1)
+		return false;
+
+	if (!tasks.get_task_count() || density <= 1)
+		// density test is sufficient
+		return true;
+
+	// The busy interval only grows as tasks are added, so the last one
+	// is a lower bound from which the fixpoint search can continue.
+	if (busy_interval_valid)
+		busy_interval = edf_busy_interval(tasks, *cols, busy_interval);
+	else
+		busy_interval = edf_busy_interval(tasks, *cols);
+	busy_interval_valid = true;
+
+	integral_t max_interval = busy_interval;
+	if (util < 1)
+	{
+		integral_t max_delta = 0;
+		for (unsigned int i = 0; i < tasks.get_task_count(); i++)
+		{
+			integral_t delta = tasks[i].get_deadline();
+			delta -= tasks[i].get_period();
+			max_delta = std::max(max_delta, delta);
+		}
+		max_interval = std::min(max_interval,
+			zhang_burns_interval(max_delta, scaled_delta, util));
+	}
+
+	unsigned long min_interval = min_relative_deadline(tasks);
+
+	integral_t next = get_largest_testpoint(tasks, max_interval);
+	integral_t demand;
+	integral_t interval;
+
+	while (true)
+	{
+		interval = next;
+
+		if (interval < known_ok_below)
+			return true;
+
+		bound_demand(tasks, *cols, interval, demand);
+
+		if (demand > interval)
+			return false;
+		if (demand <= min_interval)
+			return true;
+
+		if (demand < interval)
+			next = demand;
+		else
+			next = get_largest_testpoint(tasks, interval);
+	}
+}
 
 static void find_feasible_cost_fixpoint(
 	const integral_t &interval,
@@ -260,10 +480,13 @@ unsigned long qpa_get_max_C_equal_D_cost(
 
 	const unsigned int s = ts_with_split.get_task_count() - 1;
 
+	TaskColumns cols_of_others(ts);
+
 	bool schedulable = false;
 	while (!schedulable && max_wcet > 0)
 	{
-		integral_t max_interval = edf_busy_interval(ts_with_split);
+		TaskColumns cols(ts_with_split);
+		integral_t max_interval = edf_busy_interval(ts_with_split, cols);
 		unsigned long min_interval = min_relative_deadline(ts_with_split);
 
 		ts_with_split.get_utilization(util);
@@ -277,7 +500,7 @@ unsigned long qpa_get_max_C_equal_D_cost(
 		do
 		{
 			interval = next;
-			ts_with_split.bound_demand(interval, demand);
+			bound_demand(ts_with_split, cols, interval, demand);
 			if (demand < interval)
 				next = demand;
 			else
@@ -290,7 +513,8 @@ unsigned long qpa_get_max_C_equal_D_cost(
 		if (!schedulable)
 		{
 			// compute largest budget that would have fit and adjust task Ts
-			ts.bound_demand(interval, demand); // demand of others without Ts
+			// demand of others without Ts
+			bound_demand(ts, cols_of_others, interval, demand);
 			find_feasible_cost_fixpoint(interval, demand, period, max_wcet);
 			// update task parameters and check again
 			ts_with_split[s].set_wcet(max_wcet.get_ui());
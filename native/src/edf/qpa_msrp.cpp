@@ -25,9 +25,10 @@ QPA_MSRPTest::QPA_MSRPTest(unsigned int num_processors, const ResourceSharingInf
 {}
 
 
-integral_t QPA_MSRPTest::get_demand(integral_t interval, const TaskSet &ts)
+integral_t QPA_MSRPTest::get_demand(integral_t interval, const TaskSet &ts,
+                                    const TaskColumns &cols)
 {
-	integral_t demand = QPATest::get_demand(interval,ts);
+	integral_t demand = QPATest::get_demand(interval, ts, cols);
 
 	if (interval <= max_relative_deadline)
 		demand += get_EDF_arrival_blocking(info, num_cpus, interval.get_ui(), cpu_id);
@@ -35,9 +36,11 @@ integral_t QPA_MSRPTest::get_demand(integral_t interval, const TaskSet &ts)
 	return demand;
 }
 
-integral_t QPA_MSRPTest::get_max_interval(const TaskSet &ts, const fractional_t& util)
+integral_t QPA_MSRPTest::get_max_interval(const TaskSet &ts,
+                                          const TaskColumns &cols,
+                                          const fractional_t& util)
 {
-	integral_t max_interval = QPATest::get_max_interval(ts, util);
+	integral_t max_interval = QPATest::get_max_interval(ts, cols, util);
 
 	// Follows Baruah RTSS'06 - "Resource sharing in EDF-scheduled systems: a closer look"
 	max_interval = std::max(max_interval.get_ui(), max_relative_deadline);
@@ -85,3 +88,66 @@ bool pedf_msrp_classic_is_schedulable(const ResourceSharingInfo& info, unsigned
 
 	return esit;
 }
+
+void MSRPPartitionFit::reset(const TaskSet& ts, unsigned int num_bins)
+{
+	tasks = &ts;
+	num_cpus = num_bins;
+	cluster.assign(ts.get_task_count(), -1);
+	assigned.assign(num_bins, std::vector<unsigned int>());
+}
+
+bool MSRPPartitionFit::is_schedulable() const
+{
+	unsigned int count = 0;
+	for (unsigned int i = 0; i < cluster.size(); i++)
+		if (cluster[i] >= 0)
+			count++;
+
+	ResourceSharingInfo placed(count);
+
+	for (unsigned int i = 0; i < cluster.size(); i++)
+	{
+		if (cluster[i] < 0)
+			continue;
+
+		const Task& tsk = (*tasks)[i];
+		const TaskInfo& ti = info.get_tasks()[i];
+
+		placed.add_task(tsk.get_period(), ti.get_response(), cluster[i],
+		                ti.get_priority(), tsk.get_wcet(),
+		                tsk.get_deadline());
+		foreach(ti.get_requests(), req)
+			placed.add_request_rw(req->get_resource_id(),
+			                      req->get_num_requests(),
+			                      req->get_request_length(),
+			                      req->get_request_type(),
+			                      req->get_request_priority());
+	}
+
+	return pedf_msrp_classic_is_schedulable(placed, num_cpus);
+}
+
+bool MSRPPartitionFit::try_assign(unsigned int task, unsigned int bin)
+{
+	cluster[task] = bin;
+	if (!is_schedulable())
+	{
+		cluster[task] = -1;
+		return false;
+	}
+
+	assigned[bin].push_back(task);
+	return true;
+}
+
+void MSRPPartitionFit::unassign_last(unsigned int bin)
+{
+	cluster[assigned[bin].back()] = -1;
+	assigned[bin].pop_back();
+}
+
+void MSRPPartitionFit::get_size(unsigned int task, fractional_t& size) const
+{
+	(*tasks)[task].get_utilization(size);
+}
@@ -2,8 +2,10 @@
 #include "edf/sim.h"
 
 #include "schedule_sim.h"
+#include "parallel.h"
 
 #include <algorithm>
+#include <random>
 
 typedef GlobalScheduler<EarliestDeadlineFirst> GedfSim;
 
@@ -104,3 +106,164 @@ Stats edf_observe_tardiness(unsigned int num_procs,
     return sim.stats;
 }
 
+
+// per-thread partial results of EDFTardinessMonteCarlo
+struct TardinessCounts
+{
+    std::vector<Stats> task_stats;
+    std::vector<unsigned long> histogram;
+};
+
+static void merge_stats(Stats &into, const Stats &from)
+{
+    into.num_tardy_jobs  += from.num_tardy_jobs;
+    into.num_ok_jobs     += from.num_ok_jobs;
+    into.total_tardiness += from.total_tardiness;
+    into.max_tardiness    = std::max(into.max_tardiness, from.max_tardiness);
+    if (from.first_miss && (!into.first_miss || from.first_miss < into.first_miss))
+        into.first_miss = from.first_miss;
+}
+
+class TaskTardiness : public GedfSim
+{
+  private:
+    const Task *first_task;
+    TardinessCounts &counts;
+    unsigned long bucket_width;
+    unsigned int num_buckets;
+
+  public:
+    TaskTardiness(int m, bool preemptive, const TaskSet &ts,
+                  TardinessCounts &counts,
+                  unsigned long bucket_width, unsigned int num_buckets)
+        : GedfSim(m, preemptive),
+          // no job completes if there are no tasks
+          first_task(ts.get_task_count() ? &ts[0] : NULL), counts(counts),
+          bucket_width(bucket_width), num_buckets(num_buckets)
+    {}
+
+    virtual void job_completed(int proc, Job *job)
+    {
+        unsigned int task = &job->get_task() - first_task;
+        Stats &stats = counts.task_stats[task];
+        simtime_t tardiness = 0;
+
+        if (this->get_current_time() > job->get_deadline())
+        {
+            tardiness = this->get_current_time() - job->get_deadline();
+            stats.num_tardy_jobs++;
+            stats.total_tardiness += tardiness;
+            stats.max_tardiness = std::max(tardiness, stats.max_tardiness);
+            // stats accumulate over the scenarios run by this thread
+            if (!stats.first_miss || job->get_deadline() < stats.first_miss)
+                stats.first_miss = job->get_deadline();
+        }
+        else
+            stats.num_ok_jobs++;
+
+        if (num_buckets)
+        {
+            unsigned long bucket = bucket_width ? tardiness / bucket_width : 0;
+            bucket = std::min(bucket, (unsigned long) num_buckets - 1);
+            counts.histogram[task * num_buckets + bucket]++;
+        }
+    };
+};
+
+// sporadic job sequence with random jitter and execution times
+class RandomJobSequence : public SimJob
+{
+  private:
+    std::mt19937_64 &rng;
+    std::uniform_int_distribution<unsigned long> cost_dist;
+    std::uniform_int_distribution<unsigned long> jitter_dist;
+
+  public:
+    RandomJobSequence(Task &tsk, std::mt19937_64 &rng,
+                      unsigned long min_cost, unsigned long max_jitter,
+                      unsigned long offset)
+        : SimJob(tsk), rng(rng),
+          cost_dist(min_cost, tsk.get_wcet()), jitter_dist(0, max_jitter)
+    {
+        set_release(offset);
+        cost = cost_dist(rng);
+    }
+
+    virtual ~RandomJobSequence() {}
+
+    virtual void completed(simtime_t when, int proc)
+    {
+        simtime_t next_cost = cost_dist(rng);
+        init_next(next_cost, jitter_dist(rng));
+        get_sim()->add_release(this);
+    }
+};
+
+EDFTardinessMonteCarlo::EDFTardinessMonteCarlo(unsigned int num_procs,
+                                               const TaskSet &ts,
+                                               unsigned long end_of_simulation,
+                                               bool preemptive)
+    : num_procs(num_procs), tasks(ts), end_of_simulation(end_of_simulation),
+      preemptive(preemptive), max_offset(0), max_jitter(0),
+      min_cost_ratio(1.0), bucket_width(1), num_buckets(0), num_scenarios(0)
+{
+}
+
+void EDFTardinessMonteCarlo::run(unsigned int scenarios, unsigned long seed,
+                                 unsigned int num_threads)
+{
+    const unsigned int n = tasks.get_task_count();
+
+    unsigned int threads = num_threads ? num_threads : default_thread_count();
+    std::vector<TardinessCounts> counts(threads);
+    for (unsigned int w = 0; w < threads; w++)
+    {
+        counts[w].task_stats.assign(n, Stats());
+        counts[w].histogram.assign(n * num_buckets, 0);
+    }
+
+    parallel_for(scenarios, threads,
+        [&](unsigned int worker, unsigned long idx)
+        {
+            std::mt19937_64 rng(mix_seed(seed, idx));
+            std::uniform_int_distribution<unsigned long> offset_dist(0, max_offset);
+
+            TaskSet &ts = tasks;
+            TaskTardiness sim(num_procs, preemptive, ts, counts[worker],
+                              bucket_width, num_buckets);
+
+            // reserved up front: the simulator keeps pointers to the jobs
+            std::vector<RandomJobSequence> jobs;
+            jobs.reserve(n);
+            for (unsigned int i = 0; i < n; i++)
+            {
+                unsigned long min_cost = ts[i].get_wcet() * min_cost_ratio;
+                min_cost = std::max(1UL, std::min(min_cost, ts[i].get_wcet()));
+                jobs.push_back(RandomJobSequence(ts[i], rng, min_cost,
+                                                 max_jitter, offset_dist(rng)));
+                jobs[i].set_simulation(&sim);
+                sim.add_release(&jobs[i]);
+            }
+
+            sim.simulate_until(end_of_simulation);
+        });
+
+    num_scenarios = scenarios;
+    task_stats.assign(n, Stats());
+    histogram.assign(n * num_buckets, 0);
+    for (unsigned int w = 0; w < threads; w++)
+    {
+        for (unsigned int i = 0; i < n; i++)
+            merge_stats(task_stats[i], counts[w].task_stats[i]);
+        for (unsigned int k = 0; k < histogram.size(); k++)
+            histogram[k] += counts[w].histogram[k];
+    }
+}
+
+Stats EDFTardinessMonteCarlo::get_stats() const
+{
+    Stats total = Stats();
+    for (unsigned int i = 0; i < task_stats.size(); i++)
+        merge_stats(total, task_stats[i]);
+    return total;
+}
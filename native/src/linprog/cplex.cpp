@@ -27,9 +27,10 @@ private:
 	IloObjective make_objective(const IloNumVarArray& vars);
         IloRangeArray make_constraints(const IloNumVarArray& vars);
 
-	IloRange make_constraint(const IloNumVarArray &vars,
-				 const LinearExpression *exp, double bound,
-				 bool is_exact_bound);
+	void add_constraints(IloRangeArray &constraints,
+			     const IloNumVarArray &vars,
+			     const ConstraintMatrix &rows,
+			     bool is_exact_bound);
 
 public:
 	CPLEXSolution(const LinearProgram &lp, unsigned int max_num_vars,
@@ -167,28 +168,30 @@ IloRangeArray CPLEXSolution::make_constraints(const IloNumVarArray &vars)
 {
 	IloRangeArray constraints(get_env());
 
-	foreach (linprog.get_equalities(), exp)
-		constraints.add(make_constraint(vars, exp->first, exp->second, true));
-
-	foreach (linprog.get_inequalities(), exp)
-		constraints.add(make_constraint(vars, exp->first, exp->second, false));
+	add_constraints(constraints, vars, linprog.get_equalities(), true);
+	add_constraints(constraints, vars, linprog.get_inequalities(), false);
 
 	return constraints;
 }
 
-IloRange CPLEXSolution::make_constraint(const IloNumVarArray &vars,
-					const LinearExpression *exp, double bound,
-					bool is_exact_bound)
+void CPLEXSolution::add_constraints(IloRangeArray &constraints,
+				    const IloNumVarArray &vars,
+				    const ConstraintMatrix &rows,
+				    bool is_exact_bound)
 {
-	IloRange r = IloRange(get_env(), -IloInfinity, bound);
+	for (unsigned int i = 0; i < rows.size(); i++)
+	{
+		const double bound = rows.get_bound(i);
+		IloRange r = IloRange(get_env(), -IloInfinity, bound);
 
-	if (is_exact_bound)
-		r.setLB(bound);
+		if (is_exact_bound)
+			r.setLB(bound);
 
-	foreach (exp->get_terms(), term)
-		r.setLinearCoef(vars[term->second], term->first);
+		for (const Term *term = rows.row_begin(i); term != rows.row_end(i); term++)
+			r.setLinearCoef(vars[term->second], term->first);
 
-	return r;
+		constraints.add(r);
+	}
 }
 
 CPLEXSolution::~CPLEXSolution()
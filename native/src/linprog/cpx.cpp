@@ -1,11 +1,13 @@
 #define IL_STD // required by CPLEX when using STL classes.
 
 #include <assert.h>
+#include <algorithm>
 #include <ilcplex/cplex.h>
 
 #include "cpu_time.h"
 
 #include "linprog/cplex.h"
+#include "linprog/session.h"
 
 class CPXSolution : public Solution
 {
@@ -16,7 +18,6 @@ private:
 	const LinearProgram &linprog;
 	const unsigned int num_cols;
 	const unsigned int num_rows;
-	unsigned int num_coeffs;
 
 	double *values;
 	bool solved;
@@ -25,7 +26,6 @@ private:
 
 	bool setup_objective(double lb, double ub);
 	bool add_rows();
-	bool load_coeffs();
 	bool set_column_types();
 
 public:
@@ -52,7 +52,6 @@ CPXSolution::CPXSolution(const LinearProgram& lp, unsigned int max_num_vars,
 	  num_cols(max_num_vars),
 	  num_rows(lp.get_equalities().size() +
 		   lp.get_inequalities().size()),
-	  num_coeffs(0),
 	  values(0),
 	  solved(false)
 {
@@ -94,8 +93,7 @@ void CPXSolution::solve_model(double var_lb, double var_ub)
 
 	if (!setup_objective(var_lb, var_ub) ||
 	    !set_column_types() ||
-	    !add_rows() ||
-	    !load_coeffs())
+	    !add_rows())
 		return;
 
 
@@ -201,103 +199,282 @@ bool CPXSolution::setup_objective(double lb, double ub)
 
 bool CPXSolution::set_column_types()
 {
-	int err;
+	if (!linprog.has_integer_variables() && !linprog.has_binary_variables())
+		return true;
 
-	const char typeINTEGER = 'I';
-	foreach(linprog.get_integer_variables(), var_id)
-	{
-		const int v = *var_id;
+	std::vector<int> indices;
+	std::vector<char> types;
 
-		err = CPXchgctype(env, lp, 1, &v, &typeINTEGER);
-		if (err != 0)
-			return false;
+	for (unsigned int var_id = 0; var_id < num_cols; var_id++)
+	{
+		if (linprog.is_binary_variable(var_id))
+			types.push_back('B');
+		else if (linprog.is_integer_variable(var_id))
+			types.push_back('I');
+		else
+			continue;
+		indices.push_back(var_id);
 	}
 
-	const char typeBINARY   = 'B';
-	foreach(linprog.get_binary_variables(), var_id)
+	return indices.empty() ||
+		CPXchgctype(env, lp, indices.size(), &indices[0], &types[0]) == 0;
+}
+
+/* Copy the rows of m into the arrays expected by CPXaddrows(). Unlike
+ * CPXchgcoef(), CPXaddrows() rejects rows that mention a variable more than
+ * once; such terms are merged such that the last one wins, as before.
+ * pos[v] is the index of variable v's entry in rmatind of the most recent
+ * row that mentions v.
+ */
+static void append_rows(const ConstraintMatrix &m, char sense,
+			std::vector<double> &rhs, std::vector<char> &senses,
+			std::vector<int> &rmatbeg, std::vector<int> &rmatind,
+			std::vector<double> &rmatval, std::vector<int> &pos)
+{
+	for (unsigned int r = 0; r < m.size(); r++)
 	{
-		const int v = *var_id;
+		const int first = rmatind.size();
 
-		err = CPXchgctype(env, lp, 1, &v, &typeBINARY);
-		if (err != 0)
-			return false;
-	}
+		rmatbeg.push_back(first);
+		rhs.push_back(m.get_bound(r));
+		senses.push_back(sense);
 
-	return true;
+		for (const Term *term = m.row_begin(r); term != m.row_end(r); term++)
+		{
+			int &p = pos[term->second];
+			if (p >= first)
+				rmatval[p] = term->first;
+			else
+			{
+				p = rmatind.size();
+				rmatind.push_back(term->second);
+				rmatval.push_back(term->first);
+			}
+		}
+	}
 }
 
 bool CPXSolution::add_rows()
 {
-	double *bounds = new double[num_rows];
-	char   *senses = new char[num_rows];
-	int err;
-
-	unsigned int r = 0;
+	const ConstraintMatrix &equ = linprog.get_equalities();
+	const ConstraintMatrix &inequ = linprog.get_inequalities();
+	const unsigned int num_coeffs = equ.get_num_terms() + inequ.get_num_terms();
+
+	std::vector<double> rhs, rmatval;
+	std::vector<char> senses;
+	std::vector<int> rmatbeg, rmatind;
+	std::vector<int> pos(num_cols, -1);
+
+	if (!num_rows)
+		return true;
+
+	rhs.reserve(num_rows);
+	senses.reserve(num_rows);
+	rmatbeg.reserve(num_rows);
+	rmatind.reserve(num_coeffs);
+	rmatval.reserve(num_coeffs);
+
+	append_rows(equ, 'E', rhs, senses, rmatbeg, rmatind, rmatval, pos);
+	append_rows(inequ, 'L', rhs, senses, rmatbeg, rmatind, rmatval, pos);
+
+	// rows always have at least one term
+	return CPXaddrows(env, lp, 0, num_rows, rmatind.size(), &rhs[0],
+			  &senses[0], &rmatbeg[0], &rmatind[0], &rmatval[0],
+			  NULL, NULL) == 0;
+}
 
-	foreach(linprog.get_equalities(), equ)
+Solution *cpx_solve(const LinearProgram& lp, unsigned int max_num_vars)
+{
+	CPXSolution *sol =  new CPXSolution(lp, max_num_vars);
+	if (sol->is_solved())
+		return sol;
+	else
 	{
-		bounds[r] = equ->second;
-		senses[r] = 'E'; // equality constraint
+		delete sol;
+		return NULL;
+	}
+}
+
 
-		num_coeffs += equ->first->get_terms().size();
-		r++;
+class CPXSession : public IncrementalLPSession, public Solution
+{
+private:
+	CPXENVptr env;
+	CPXLPptr lp;
+
+	std::vector<double> values;
+
+	void get_col_bounds(unsigned int col, double &lb, double &ub) const;
+
+protected:
+	bool load_problem();
+	bool update_rhs(unsigned int row);
+	bool update_row(unsigned int row);
+	bool update_objective(unsigned int col);
+	bool update_bounds(unsigned int col);
+	bool optimize(bool warm);
+	void free_problem();
+
+	const Solution *get_solution() const
+	{
+		return this;
 	}
 
-	foreach(linprog.get_inequalities(), inequ)
+public:
+	CPXSession() : env(0), lp(0) {}
+	~CPXSession();
+
+	double get_value(unsigned int var) const
 	{
-		bounds[r] = inequ->second;
-		senses[r] = 'L'; // less-than-or-equal constraint
+		return values[var];
+	}
+};
 
-		num_coeffs += inequ->first->get_terms().size();
-		r++;
+CPXSession::~CPXSession()
+{
+	int status;
+
+	free_problem();
+
+	if (env)
+	{
+		status = CPXcloseCPLEX(&env);
+		assert(status == 0);
 	}
+}
 
-	err = CPXnewrows(env, lp, num_rows, bounds, senses, NULL, NULL);
+void CPXSession::free_problem()
+{
+	int status;
 
-	delete [] bounds;
-	delete [] senses;
+	if (lp)
+	{
+		status = CPXfreeprob(env, &lp);
+		assert(status == 0);
+	}
+	lp = 0;
+}
 
-	return err == 0;
+void CPXSession::get_col_bounds(unsigned int col, double &lb, double &ub) const
+{
+	const VariableRange &bnds = get_snapshot().bounds[col];
+
+	lb = bnds.has_lower ? bnds.lower_bound : -CPX_INFBOUND;
+	ub = bnds.has_upper ? bnds.upper_bound : CPX_INFBOUND;
 }
 
-bool CPXSolution::load_coeffs()
+bool CPXSession::load_problem()
 {
-	unsigned int r = 0;
+	const LinearProgramSnapshot &snap = get_snapshot();
+	const unsigned int num_cols = snap.num_cols;
+	const unsigned int num_rows = snap.get_num_rows();
 	int err;
 
-	foreach(linprog.get_equalities(), equ)
+	// the environment is kept for the lifetime of the session
+	if (!env)
 	{
-		foreach(equ->first->get_terms(), term)
-		{
-			err = CPXchgcoef(env, lp, r, term->second, term->first);
-			if (err != 0)
-				return false;
-		}
-		r++;
+		env = CPXopenCPLEX(&err);
+		if (!env)
+			return false;
 	}
 
-	foreach(linprog.get_inequalities(), inequ)
+	lp = CPXcreateprob(env, &err, "blocking");
+	if (!lp)
+		return false;
+
+	if (snap.is_mip())
+		CPXchgprobtype(env, lp, CPXPROB_MILP);
+
+	std::vector<double> lbs(num_cols), ubs(num_cols);
+	std::vector<char> types(num_cols);
+	for (unsigned int c = 0; c < num_cols; c++)
 	{
-		foreach(inequ->first->get_terms(), term)
+		get_col_bounds(c, lbs[c], ubs[c]);
+		switch (snap.kind[c])
 		{
-			err = CPXchgcoef(env, lp, r, term->second, term->first);
-			if (err != 0)
-				return false;
+		case LinearProgramSnapshot::INTEGER:
+			types[c] = 'I';
+			break;
+		case LinearProgramSnapshot::BINARY:
+			types[c] = 'B';
+			break;
+		default:
+			types[c] = 'C';
 		}
-		r++;
 	}
 
+	CPXchgobjsen(env, lp, CPX_MAX);
+
+	err = CPXnewcols(env, lp, num_cols, &snap.objective[0],
+			 &lbs[0], &ubs[0], &types[0], NULL);
+	if (err != 0)
+		return false;
+
+	if (num_rows)
+	{
+		std::vector<char> senses(num_rows, 'L');
+		std::fill(senses.begin(), senses.begin() + snap.num_equalities, 'E');
+
+		err = CPXnewrows(env, lp, num_rows, &snap.rhs[0], &senses[0],
+				 NULL, NULL);
+		if (err != 0)
+			return false;
+	}
+
+	for (unsigned int r = 0; r < num_rows; r++)
+		if (!update_row(r))
+			return false;
+
+	values.resize(num_cols);
 	return true;
 }
 
-Solution *cpx_solve(const LinearProgram& lp, unsigned int max_num_vars)
+bool CPXSession::update_rhs(unsigned int row)
 {
-	CPXSolution *sol =  new CPXSolution(lp, max_num_vars);
-	if (sol->is_solved())
-		return sol;
-	else
-	{
-		delete sol;
-		return NULL;
-	}
+	const int r = row;
+
+	return CPXchgrhs(env, lp, 1, &r, &get_snapshot().rhs[row]) == 0;
+}
+
+bool CPXSession::update_row(unsigned int row)
+{
+	const LinearProgramSnapshot &snap = get_snapshot();
+
+	// one by one, so that repeated variables behave as in CPXSolution
+	for (unsigned int k = snap.row_start[row]; k < snap.row_start[row + 1]; k++)
+		if (CPXchgcoef(env, lp, row, snap.cols[k], snap.coeffs[k]) != 0)
+			return false;
+
+	return true;
+}
+
+bool CPXSession::update_objective(unsigned int col)
+{
+	const int c = col;
+
+	return CPXchgobj(env, lp, 1, &c, &get_snapshot().objective[col]) == 0;
+}
+
+bool CPXSession::update_bounds(unsigned int col)
+{
+	const int idx[2] = {(int) col, (int) col};
+	const char lu[2] = {'L', 'U'};
+	double bd[2];
+
+	get_col_bounds(col, bd[0], bd[1]);
+
+	return CPXchgbds(env, lp, 2, idx, lu, bd) == 0;
+}
+
+bool CPXSession::optimize(bool warm)
+{
+	// CPLEX reuses the previous basis of a modified problem by itself
+	return CPXmipopt(env, lp) == 0 &&
+		CPXsolution(env, lp, NULL, NULL, &values[0],
+			    NULL, NULL, NULL) == 0;
+}
+
+LinearProgramSession *cpx_session()
+{
+	return new CPXSession();
 }
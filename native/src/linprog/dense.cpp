@@ -0,0 +1,551 @@
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+
+#include "linprog/dense.h"
+#include "linprog/solver.h"
+
+// read by the worker threads of foreach_task_in_parallel()
+static std::atomic<unsigned int> dense_lp_limit(0);
+
+void set_lp_dense_limit(unsigned int max_size)
+{
+	dense_lp_limit = max_size;
+}
+
+unsigned int get_lp_dense_limit()
+{
+	return dense_lp_limit;
+}
+
+// pivot and optimality tolerance
+static const double EPS = 1e-9;
+// tolerance for integrality and for the final feasibility check
+static const double FEAS_EPS = 1e-6;
+
+static const unsigned int MAX_BB_NODES = 1000;
+
+class DenseSolution : public Solution
+{
+private:
+	std::vector<double> values;
+
+public:
+	DenseSolution(const std::vector<double> &values) : values(values) {}
+
+	double get_value(unsigned int var) const
+	{
+		return values[var];
+	}
+};
+
+typedef std::vector<VariableRange> ColumnBounds;
+
+class DenseSimplex
+{
+public:
+	enum status_t {
+		OPTIMAL,
+		INFEASIBLE,
+		UNBOUNDED,
+		FAILED
+	};
+
+private:
+	const LinearProgram &linprog;
+	const unsigned int num_vars;
+
+	/* Each variable x is expressed in terms of non-negative columns y:
+	 * x = offset + sign * y[col], or x = y[col] - y[col + 1] if x is
+	 * free.
+	 */
+	std::vector<double> offset, sign;
+	std::vector<unsigned int> col;
+	std::vector<bool> is_free;
+	unsigned int num_y;
+
+	// tableau: num_rows constraint rows plus the objective row,
+	// the right-hand side is the last column
+	std::vector<double> tab;
+	std::vector<unsigned int> basis;
+	unsigned int num_rows, num_cols, first_artificial;
+
+	double& at(unsigned int r, unsigned int c)
+	{
+		return tab[r * (num_cols + 1) + c];
+	}
+
+	double& rhs(unsigned int r)
+	{
+		return at(r, num_cols);
+	}
+
+	void map_columns(const ColumnBounds &bounds);
+	unsigned int count_rows(const ColumnBounds &bounds) const;
+	void add_row(unsigned int &r, unsigned int &slack, unsigned int &art,
+		     const Term *begin, const Term *end, double bound,
+		     bool equality);
+	void add_bound_row(unsigned int &r, unsigned int &slack, unsigned int j,
+			   double bound);
+	void pivot(unsigned int r, unsigned int c);
+	status_t iterate(unsigned int allowed_cols);
+	void price_out();
+
+public:
+	DenseSimplex(const LinearProgram &lp, unsigned int num_vars)
+		: linprog(lp), num_vars(num_vars)
+	{}
+
+	status_t solve(const ColumnBounds &bounds, std::vector<double> &x,
+		       double &objective);
+};
+
+void DenseSimplex::map_columns(const ColumnBounds &bounds)
+{
+	offset.assign(num_vars, 0.0);
+	sign.assign(num_vars, 1.0);
+	col.resize(num_vars);
+	is_free.assign(num_vars, false);
+	num_y = 0;
+
+	for (unsigned int j = 0; j < num_vars; j++)
+	{
+		col[j] = num_y++;
+		if (bounds[j].has_lower)
+			offset[j] = bounds[j].lower_bound;
+		else if (bounds[j].has_upper)
+		{
+			offset[j] = bounds[j].upper_bound;
+			sign[j] = -1.0;
+		}
+		else
+		{
+			is_free[j] = true;
+			num_y++;
+		}
+	}
+}
+
+unsigned int DenseSimplex::count_rows(const ColumnBounds &bounds) const
+{
+	unsigned int n = linprog.get_equalities().size()
+		+ linprog.get_inequalities().size();
+	for (unsigned int j = 0; j < num_vars; j++)
+		if (bounds[j].has_lower && bounds[j].has_upper)
+			n++;
+	return n;
+}
+
+void DenseSimplex::add_row(unsigned int &r, unsigned int &slack,
+			   unsigned int &art, const Term *begin,
+			   const Term *end, double bound, bool equality)
+{
+	for (const Term *term = begin; term != end; term++)
+	{
+		unsigned int j = term->second;
+		double a = term->first;
+
+		bound -= a * offset[j];
+		at(r, col[j]) += a * sign[j];
+		if (is_free[j])
+			at(r, col[j] + 1) -= a;
+	}
+
+	const bool negate = bound < 0;
+	if (negate)
+	{
+		for (unsigned int c = 0; c < num_y; c++)
+			at(r, c) = -at(r, c);
+		bound = -bound;
+	}
+	rhs(r) = bound;
+
+	if (!equality)
+		at(r, slack++) = negate ? -1.0 : 1.0;
+
+	if (equality || negate)
+	{
+		at(r, art) = 1.0;
+		basis[r] = art++;
+	}
+	else
+		basis[r] = slack - 1;
+	r++;
+}
+
+void DenseSimplex::add_bound_row(unsigned int &r, unsigned int &slack,
+				 unsigned int j, double bound)
+{
+	// y[col[j]] <= bound, with bound >= 0
+	at(r, col[j]) = 1.0;
+	at(r, slack) = 1.0;
+	rhs(r) = bound;
+	basis[r++] = slack++;
+}
+
+void DenseSimplex::pivot(unsigned int r, unsigned int c)
+{
+	const unsigned int width = num_cols + 1;
+	double *prow = &tab[r * width];
+	const double p = prow[c];
+
+	for (unsigned int k = 0; k < width; k++)
+		prow[k] /= p;
+	prow[c] = 1.0;
+
+	for (unsigned int i = 0; i <= num_rows; i++)
+	{
+		double *row = &tab[i * width];
+		const double f = row[c];
+		if (i == r || f == 0.0)
+			continue;
+		for (unsigned int k = 0; k < width; k++)
+			row[k] -= f * prow[k];
+		row[c] = 0.0;
+	}
+	basis[r] = c;
+}
+
+// run the simplex method on the columns 0 ... allowed_cols-1
+DenseSimplex::status_t DenseSimplex::iterate(unsigned int allowed_cols)
+{
+	const unsigned int max_iter = 50 * (num_rows + num_cols) + 100;
+	bool bland = false;
+
+	for (unsigned int iter = 0; iter < max_iter; iter++)
+	{
+		// entering column: most negative reduced cost, or the first one
+		// with a negative reduced cost after a degenerate pivot
+		unsigned int enter = num_cols;
+		double best = -EPS;
+		for (unsigned int c = 0; c < allowed_cols; c++)
+		{
+			double d = at(num_rows, c);
+			if (d < best)
+			{
+				enter = c;
+				best = d;
+				if (bland)
+					break;
+			}
+		}
+		if (enter == num_cols)
+			return OPTIMAL;
+
+		// leaving row: minimum ratio, ties broken by the basis index
+		unsigned int leave = num_rows;
+		double min_ratio = 0;
+		for (unsigned int r = 0; r < num_rows; r++)
+		{
+			double a = at(r, enter);
+			if (a <= EPS)
+				continue;
+			double ratio = rhs(r) / a;
+			if (leave == num_rows || ratio < min_ratio - EPS
+			    || (ratio <= min_ratio + EPS && basis[r] < basis[leave]))
+			{
+				leave = r;
+				min_ratio = ratio;
+			}
+		}
+		if (leave == num_rows)
+			return UNBOUNDED;
+
+		bland = min_ratio <= EPS;
+		pivot(leave, enter);
+	}
+	return FAILED;
+}
+
+// make the reduced costs of the basic columns zero
+void DenseSimplex::price_out()
+{
+	for (unsigned int r = 0; r < num_rows; r++)
+	{
+		const double f = at(num_rows, basis[r]);
+		if (f == 0.0)
+			continue;
+		for (unsigned int k = 0; k <= num_cols; k++)
+			at(num_rows, k) -= f * at(r, k);
+	}
+}
+
+DenseSimplex::status_t DenseSimplex::solve(const ColumnBounds &bounds,
+					   std::vector<double> &x,
+					   double &objective)
+{
+	for (unsigned int j = 0; j < num_vars; j++)
+		if (bounds[j].has_lower && bounds[j].has_upper
+		    && bounds[j].upper_bound < bounds[j].lower_bound - FEAS_EPS)
+			return INFEASIBLE;
+
+	map_columns(bounds);
+
+	const ConstraintMatrix &equ = linprog.get_equalities();
+	const ConstraintMatrix &inequ = linprog.get_inequalities();
+
+	num_rows = count_rows(bounds);
+	const unsigned int num_slack = num_rows - equ.size();
+
+	// at most one artificial column per row; unused ones stay zero
+	first_artificial = num_y + num_slack;
+	num_cols = first_artificial + num_rows;
+
+	tab.assign((num_rows + 1) * (num_cols + 1), 0.0);
+	basis.resize(num_rows);
+
+	unsigned int r = 0, slack = num_y, art = first_artificial;
+	for (unsigned int i = 0; i < equ.size(); i++)
+		add_row(r, slack, art, equ.row_begin(i), equ.row_end(i),
+			equ.get_bound(i), true);
+	for (unsigned int i = 0; i < inequ.size(); i++)
+		add_row(r, slack, art, inequ.row_begin(i), inequ.row_end(i),
+			inequ.get_bound(i), false);
+	for (unsigned int j = 0; j < num_vars; j++)
+		if (bounds[j].has_lower && bounds[j].has_upper)
+			add_bound_row(r, slack, j, std::max(0.0,
+				bounds[j].upper_bound - bounds[j].lower_bound));
+
+	// phase 1: maximize the negated sum of the artificial columns
+	if (art > first_artificial)
+	{
+		for (unsigned int c = first_artificial; c < art; c++)
+			at(num_rows, c) = 1.0;
+		price_out();
+
+		if (iterate(num_cols) != OPTIMAL)
+			return FAILED;
+		if (rhs(num_rows) < -FEAS_EPS)
+			return INFEASIBLE;
+
+		// Pivot the remaining (zero) artificial columns out of the
+		// basis. If that is impossible, the row is redundant and its
+		// artificial column remains basic at zero.
+		for (unsigned int i = 0; i < num_rows; i++)
+			if (basis[i] >= first_artificial)
+				for (unsigned int c = 0; c < first_artificial; c++)
+					if (std::fabs(at(i, c)) > EPS)
+					{
+						pivot(i, c);
+						break;
+					}
+	}
+
+	// phase 2: the actual objective
+	for (unsigned int k = 0; k <= num_cols; k++)
+		at(num_rows, k) = 0.0;
+	foreach(linprog.get_objective()->get_terms(), term)
+	{
+		unsigned int j = term->second;
+		at(num_rows, col[j]) -= term->first * sign[j];
+		if (is_free[j])
+			at(num_rows, col[j] + 1) += term->first;
+	}
+	price_out();
+
+	status_t status = iterate(first_artificial);
+	if (status != OPTIMAL)
+		return status;
+
+	std::vector<double> y(num_cols, 0.0);
+	for (unsigned int i = 0; i < num_rows; i++)
+		y[basis[i]] = rhs(i);
+
+	x.resize(num_vars);
+	objective = 0;
+	for (unsigned int j = 0; j < num_vars; j++)
+	{
+		x[j] = offset[j] + sign[j] * y[col[j]];
+		if (is_free[j])
+			x[j] -= y[col[j] + 1];
+	}
+	foreach(linprog.get_objective()->get_terms(), term)
+		objective += term->first * x[term->second];
+
+	return OPTIMAL;
+}
+
+class DenseBranchAndBound
+{
+private:
+	const LinearProgram &linprog;
+	DenseSimplex simplex;
+	const unsigned int num_vars;
+
+	bool have_incumbent, aborted;
+	double best;
+	std::vector<double> incumbent;
+	unsigned int num_nodes;
+
+	void explore(ColumnBounds &bounds);
+
+public:
+	DenseBranchAndBound(const LinearProgram &lp, unsigned int num_vars)
+		: linprog(lp), simplex(lp, num_vars), num_vars(num_vars),
+		  have_incumbent(false), aborted(false), best(0), num_nodes(0)
+	{}
+
+	// returns true if an optimal solution was found
+	bool solve(ColumnBounds &bounds)
+	{
+		explore(bounds);
+		return have_incumbent && !aborted;
+	}
+
+	const std::vector<double>& get_solution() const
+	{
+		return incumbent;
+	}
+};
+
+void DenseBranchAndBound::explore(ColumnBounds &bounds)
+{
+	std::vector<double> x;
+	double obj;
+
+	if (aborted || ++num_nodes > MAX_BB_NODES)
+	{
+		aborted = true;
+		return;
+	}
+
+	DenseSimplex::status_t status = simplex.solve(bounds, x, obj);
+	if (status == DenseSimplex::INFEASIBLE)
+		return;
+	if (status != DenseSimplex::OPTIMAL)
+	{
+		aborted = true;
+		return;
+	}
+	if (have_incumbent && obj <= best + FEAS_EPS)
+		// cannot improve on the incumbent
+		return;
+
+	// branch on the most fractional integer variable
+	unsigned int branch = num_vars;
+	double max_frac = FEAS_EPS;
+	for (unsigned int j = 0; j < num_vars; j++)
+		if (linprog.is_integer_variable(j) || linprog.is_binary_variable(j))
+		{
+			double frac = std::fabs(x[j] - std::floor(x[j] + 0.5));
+			if (frac > max_frac)
+			{
+				branch = j;
+				max_frac = frac;
+			}
+		}
+
+	if (branch == num_vars)
+	{
+		have_incumbent = true;
+		best = obj;
+		incumbent.swap(x);
+		return;
+	}
+
+	const VariableRange saved = bounds[branch];
+	const double down = std::floor(x[branch]);
+	const bool up_first = x[branch] - down >= 0.5;
+
+	for (int k = 0; k < 2 && !aborted; k++)
+	{
+		bounds[branch] = saved;
+		if ((k == 0) == up_first)
+		{
+			bounds[branch].has_lower = true;
+			bounds[branch].lower_bound = down + 1;
+		}
+		else
+		{
+			bounds[branch].has_upper = true;
+			bounds[branch].upper_bound = down;
+		}
+		explore(bounds);
+	}
+	bounds[branch] = saved;
+}
+
+static bool is_feasible(const LinearProgram &lp, const ConstraintMatrix &m,
+			const std::vector<double> &x, bool equality)
+{
+	for (unsigned int i = 0; i < m.size(); i++)
+	{
+		double lhs = 0;
+		for (const Term *term = m.row_begin(i); term != m.row_end(i); term++)
+			lhs += term->first * x[term->second];
+
+		const double bound = m.get_bound(i);
+		const double tol = FEAS_EPS * (1 + std::fabs(bound));
+		if (lhs > bound + tol || (equality && lhs < bound - tol))
+			return false;
+	}
+	return true;
+}
+
+Solution *dense_solve(const LinearProgram& lp, unsigned int max_num_vars,
+		      double var_lb, double var_ub)
+{
+	VariableRange dflt;
+	dflt.variable_id = 0;
+	dflt.has_lower = dflt.has_upper = true;
+	dflt.lower_bound = var_lb;
+	dflt.upper_bound = var_ub;
+
+	ColumnBounds bounds(max_num_vars, dflt);
+	foreach(lp.get_non_default_variable_ranges(), bnds)
+		bounds[bnds->variable_id] = *bnds;
+
+	const bool is_mip = lp.has_binary_variables() || lp.has_integer_variables();
+	std::vector<double> x;
+
+	if (is_mip)
+	{
+		// same column bounds as used with GLPK
+		for (unsigned int j = 0; j < max_num_vars; j++)
+			if (lp.is_binary_variable(j))
+			{
+				bounds[j].has_lower = bounds[j].has_upper = true;
+				bounds[j].lower_bound = 0;
+				bounds[j].upper_bound = 1;
+			}
+			else if (lp.is_integer_variable(j))
+			{
+				bounds[j].has_lower = true;
+				bounds[j].has_upper = false;
+				bounds[j].lower_bound = 0;
+			}
+
+		DenseBranchAndBound bb(lp, max_num_vars);
+		if (!bb.solve(bounds))
+			return NULL;
+		x = bb.get_solution();
+
+		for (unsigned int j = 0; j < max_num_vars; j++)
+			if (lp.is_binary_variable(j) || lp.is_integer_variable(j))
+				x[j] = std::floor(x[j] + 0.5);
+	}
+	else
+	{
+		DenseSimplex simplex(lp, max_num_vars);
+		double obj;
+		if (simplex.solve(bounds, x, obj) != DenseSimplex::OPTIMAL)
+			return NULL;
+	}
+
+	// Snap values that are integral up to round-off, so that callers that
+	// floor() the objective do not lose a unit to the dense tableau's noise.
+	for (unsigned int j = 0; j < max_num_vars; j++)
+	{
+		const double r = std::floor(x[j] + 0.5);
+		if (std::fabs(x[j] - r) <= FEAS_EPS)
+			x[j] = r;
+	}
+
+	// guard against numerical trouble in the dense tableau
+	if (!is_feasible(lp, lp.get_equalities(), x, true)
+	    || !is_feasible(lp, lp.get_inequalities(), x, false))
+		return NULL;
+
+	return new DenseSolution(x);
+}
@@ -7,6 +7,7 @@
 #include "cpu_time.h"
 
 #include "linprog/glpk.h"
+#include "linprog/session.h"
 
 class GLPKSolution : public Solution
 {
@@ -15,7 +16,7 @@ private:
 	const LinearProgram &linprog;
 	const unsigned int num_cols;
 	const unsigned int num_rows;
-	unsigned int num_coeffs;
+	const unsigned int num_coeffs;
 	const bool is_mip;
 
 	int simplex_code;
@@ -56,8 +57,10 @@ GLPKSolution::GLPKSolution(const LinearProgram& lp, unsigned int max_num_vars,
 	  num_cols(max_num_vars),
 	  num_rows(lp.get_equalities().size() +
 		   lp.get_inequalities().size()),
-	  num_coeffs(0),
+	  num_coeffs(lp.get_equalities().get_num_terms() +
+		     lp.get_inequalities().get_num_terms()),
 	  is_mip(lp.has_binary_variables() || lp.has_integer_variables()),
+	  simplex_code(0),
 	  solved(false)
 {
 	if (num_cols)
@@ -158,23 +161,17 @@ void GLPKSolution::set_objective()
 
 void GLPKSolution::set_bounds(double col_lb, double col_ub)
 {
+	const ConstraintMatrix &equ = linprog.get_equalities();
+	const ConstraintMatrix &inequ = linprog.get_inequalities();
 	unsigned int r = 1;
 
-	foreach(linprog.get_equalities(), equ)
-	{
+	for (unsigned int i = 0; i < equ.size(); i++)
 		glp_set_row_bnds(glpk, r++, GLP_FX,
-				 equ->second, equ->second);
-
-	        num_coeffs += equ->first->get_terms().size();
-	}
+				 equ.get_bound(i), equ.get_bound(i));
 
-	foreach(linprog.get_inequalities(), inequ)
-	{
+	for (unsigned int i = 0; i < inequ.size(); i++)
 		glp_set_row_bnds(glpk, r++, GLP_UP,
-				 0, inequ->second);
-
-		num_coeffs += inequ->first->get_terms().size();
-	}
+				 0, inequ.get_bound(i));
 
 	for (unsigned int c = 1; c <= num_cols; c++)
 		glp_set_col_bnds(glpk, c, GLP_DB, col_lb, col_ub);
@@ -199,6 +196,19 @@ void GLPKSolution::set_bounds(double col_lb, double col_ub)
 	}
 }
 
+static void append_matrix(const ConstraintMatrix &m, unsigned int &r,
+			  unsigned int &k, int *row_idx, int *col_idx,
+			  double *coeff)
+{
+	for (unsigned int i = 0; i < m.size(); i++, r++)
+		for (const Term *term = m.row_begin(i); term != m.row_end(i); term++, k++)
+		{
+			row_idx[k] = r;
+			col_idx[k] = 1 + term->second;
+			coeff[k]   = term->first;
+		}
+}
+
 void GLPKSolution::set_coefficients()
 {
 	int *row_idx, *col_idx;
@@ -210,36 +220,10 @@ void GLPKSolution::set_coefficients()
 
 	unsigned int r = 1, k = 1;
 
-	foreach(linprog.get_equalities(), equ)
-	{
-		foreach(equ->first->get_terms(), term)
-		{
-			assert(k <= num_coeffs);
-
-			row_idx[k] = r;
-			col_idx[k] = 1 + term->second;
-			coeff[k]   = term->first;
-
-			k += 1;
-		}
-		r += 1;
-	}
-
-
-	foreach(linprog.get_inequalities(), inequ)
-	{
-		foreach(inequ->first->get_terms(), term)
-		{
-			assert(k <= num_coeffs);
-
-			row_idx[k] = r;
-			col_idx[k] = 1 + term->second;
-			coeff[k]   = term->first;
+	append_matrix(linprog.get_equalities(), r, k, row_idx, col_idx, coeff);
+	append_matrix(linprog.get_inequalities(), r, k, row_idx, col_idx, coeff);
 
-			k += 1;
-		}
-		r += 1;
-	}
+	assert(k == num_coeffs + 1);
 
 	glp_load_matrix(glpk, num_coeffs, row_idx, col_idx, coeff);
 
@@ -250,93 +234,93 @@ void GLPKSolution::set_coefficients()
 
 void GLPKSolution::set_column_types()
 {
-	unsigned int col_idx;
-
-	foreach(linprog.get_integer_variables(), var_id)
+	for (unsigned int var_id = 0; var_id < num_cols; var_id++)
 	{
-		col_idx = 1 + *var_id;
-		// hack: for integer variables, ignore upper bound for now
-		glp_set_col_bnds(glpk, col_idx, GLP_LO, 0, 0);
-		glp_set_col_kind(glpk, col_idx, GLP_IV);
+		unsigned int col_idx = 1 + var_id;
+
+		if (linprog.is_binary_variable(var_id))
+			glp_set_col_kind(glpk, col_idx, GLP_BV);
+		else if (linprog.is_integer_variable(var_id))
+		{
+			// hack: for integer variables, ignore upper bound for now
+			glp_set_col_bnds(glpk, col_idx, GLP_LO, 0, 0);
+			glp_set_col_kind(glpk, col_idx, GLP_IV);
+		}
 	}
+}
 
-	foreach(linprog.get_binary_variables(), var_id)
+static void show_glpk_error(glp_prob *glpk, int simplex_code)
+{
+	std::cerr << "NOT SOLVED => status: "
+		<< glp_get_status(glpk)
+		<< " (";
+	switch (glp_get_status(glpk))
+	{
+		case GLP_OPT:
+			std::cerr << "GLP_OPT";
+			break;
+		case GLP_FEAS:
+			std::cerr << "GLP_FEAS";
+			break;
+		case GLP_INFEAS:
+			std::cerr << "GLP_INFEAS";
+			break;
+		case GLP_NOFEAS:
+			std::cerr << "GLP_NOFEAS";
+			break;
+		case GLP_UNBND:
+			std::cerr << "GLP_UNBND";
+			break;
+		case GLP_UNDEF:
+			std::cerr << "GLP_UNDEF";
+			break;
+		default:
+			std::cerr << "???";
+	}
+	std::cerr << ") simplex: " << simplex_code << " (";
+	switch (simplex_code)
 	{
-		col_idx = 1 + *var_id;
-		glp_set_col_kind(glpk, col_idx, GLP_BV);
+		case GLP_EBADB:
+			std::cerr << "GLP_EBADB";
+			break;
+		case GLP_ESING:
+			std::cerr << "GLP_ESING";
+			break;
+		case GLP_ECOND:
+			std::cerr << "GLP_ECOND";
+			break;
+		case GLP_EBOUND:
+			std::cerr << "GLP_EBOUND";
+			break;
+		case GLP_EFAIL:
+			std::cerr << "GLP_EFAIL";
+			break;
+		case GLP_EOBJLL:
+			std::cerr << "GLP_EOBJLL";
+			break;
+		case GLP_EOBJUL:
+			std::cerr << "GLP_EOBJUL";
+			break;
+		case GLP_EITLIM:
+			std::cerr << "GLP_EITLIM";
+			break;
+		case GLP_ENOPFS:
+			std::cerr << "GLP_ENOPFS";
+			break;
+		case GLP_ENODFS:
+			std::cerr << "GLP_ENODFS";
+			break;
+		default:
+			std::cerr << "???";
 	}
+
+	std::cerr << ")" << std::endl;
 }
 
 void GLPKSolution::show_error()
 {
 	if (!solved)
-	{
-		std::cerr << "NOT SOLVED => status: "
-			<< glp_get_status(glpk)
-			<< " (";
-		switch (glp_get_status(glpk))
-		{
-			case GLP_OPT:
-				std::cerr << "GLP_OPT";
-				break;
-			case GLP_FEAS:
-				std::cerr << "GLP_FEAS";
-				break;
-			case GLP_INFEAS:
-				std::cerr << "GLP_INFEAS";
-				break;
-			case GLP_NOFEAS:
-				std::cerr << "GLP_NOFEAS";
-				break;
-			case GLP_UNBND:
-				std::cerr << "GLP_UNBND";
-				break;
-			case GLP_UNDEF:
-				std::cerr << "GLP_UNDEF";
-				break;
-			default:
-				std::cerr << "???";
-		}
-		std::cerr << ") simplex: " << simplex_code << " (";
-		switch (glp_get_status(glpk))
-		{
-			case GLP_EBADB:
-				std::cerr << "GLP_EBADB";
-				break;
-			case GLP_ESING:
-				std::cerr << "GLP_ESING";
-				break;
-			case GLP_ECOND:
-				std::cerr << "GLP_ECOND";
-				break;
-			case GLP_EBOUND:
-				std::cerr << "GLP_EBOUND";
-				break;
-			case GLP_EFAIL:
-				std::cerr << "GLP_EFAIL";
-				break;
-			case GLP_EOBJLL:
-				std::cerr << "GLP_EOBJLL";
-				break;
-			case GLP_EOBJUL:
-				std::cerr << "GLP_EOBJUL";
-				break;
-			case GLP_EITLIM:
-				std::cerr << "GLP_EITLIM";
-				break;
-			case GLP_ENOPFS:
-				std::cerr << "GLP_ENOPFS";
-				break;
-			case GLP_ENODFS:
-				std::cerr << "GLP_ENODFS";
-				break;
-			default:
-				std::cerr << "???";
-		}
-
-		std::cerr << ")" << std::endl;
-
-	}
+		show_glpk_error(glpk, simplex_code);
 }
 
 
@@ -352,3 +336,216 @@ Solution *glpk_solve(const LinearProgram& lp, unsigned int max_num_vars)
 		return NULL;
 	}
 }
+
+void glpk_thread_exit()
+{
+	// GLPK keeps its environment in thread-local storage.
+	glp_free_env();
+}
+
+
+class GLPKSession : public IncrementalLPSession, public Solution
+{
+private:
+	glp_prob *glpk;
+	bool is_mip;
+	int simplex_code;
+
+	void set_row(unsigned int row);
+	void set_col_bounds(unsigned int col);
+	bool solve_lp(bool warm);
+
+protected:
+	bool load_problem();
+	bool update_rhs(unsigned int row);
+	bool update_row(unsigned int row);
+	bool update_objective(unsigned int col);
+	bool update_bounds(unsigned int col);
+	bool optimize(bool warm);
+	void free_problem();
+
+	const Solution *get_solution() const
+	{
+		return this;
+	}
+
+	void show_error() const
+	{
+		if (glpk)
+			show_glpk_error(glpk, simplex_code);
+	}
+
+public:
+	GLPKSession() : glpk(NULL), is_mip(false), simplex_code(0) {}
+
+	~GLPKSession()
+	{
+		free_problem();
+	}
+
+	double get_value(unsigned int var) const
+	{
+		if (is_mip)
+			return glp_mip_col_val(glpk, var + 1);
+		else
+			return glp_get_col_prim(glpk, var + 1);
+	}
+};
+
+void GLPKSession::free_problem()
+{
+	if (glpk)
+		glp_delete_prob(glpk);
+	glpk = NULL;
+}
+
+bool GLPKSession::load_problem()
+{
+	const LinearProgramSnapshot &lp = get_snapshot();
+
+	glpk = glp_create_prob();
+	is_mip = lp.is_mip();
+
+	glp_term_out(GLP_OFF);
+	glp_set_obj_dir(glpk, GLP_MAX);
+	glp_add_cols(glpk, lp.num_cols);
+	if (lp.get_num_rows())
+		glp_add_rows(glpk, lp.get_num_rows());
+
+	for (unsigned int c = 0; c < lp.num_cols; c++)
+	{
+		glp_set_obj_coef(glpk, c + 1, lp.objective[c]);
+		if (lp.kind[c] == LinearProgramSnapshot::INTEGER)
+			glp_set_col_kind(glpk, c + 1, GLP_IV);
+		else if (lp.kind[c] == LinearProgramSnapshot::BINARY)
+			glp_set_col_kind(glpk, c + 1, GLP_BV);
+		set_col_bounds(c);
+	}
+
+	for (unsigned int r = 0; r < lp.get_num_rows(); r++)
+	{
+		update_rhs(r);
+		set_row(r);
+	}
+
+	return true;
+}
+
+void GLPKSession::set_row(unsigned int row)
+{
+	const LinearProgramSnapshot &lp = get_snapshot();
+	const unsigned int first = lp.row_start[row];
+	const unsigned int len = lp.row_start[row + 1] - first;
+
+	// GLPK expects 1-based arrays
+	std::vector<int> ind(len + 1);
+	std::vector<double> val(len + 1);
+	for (unsigned int k = 0; k < len; k++)
+	{
+		ind[k + 1] = lp.cols[first + k] + 1;
+		val[k + 1] = lp.coeffs[first + k];
+	}
+	glp_set_mat_row(glpk, row + 1, len, &ind[0], &val[0]);
+}
+
+void GLPKSession::set_col_bounds(unsigned int col)
+{
+	const LinearProgramSnapshot &lp = get_snapshot();
+	const VariableRange &bnds = lp.bounds[col];
+	int col_type;
+
+	switch (lp.kind[col])
+	{
+	case LinearProgramSnapshot::INTEGER:
+		// same hack as in GLPKSolution: ignore the upper bound
+		glp_set_col_bnds(glpk, col + 1, GLP_LO, 0, 0);
+		return;
+	case LinearProgramSnapshot::BINARY:
+		// implied by GLP_BV
+		glp_set_col_bnds(glpk, col + 1, GLP_DB, 0, 1);
+		return;
+	}
+
+	if (bnds.has_upper && bnds.has_lower)
+		col_type = GLP_DB;
+	else if (!bnds.has_upper && !bnds.has_lower)
+		col_type = GLP_FR;
+	else if (bnds.has_upper)
+		col_type = GLP_UP;
+	else
+		col_type = GLP_LO;
+
+	glp_set_col_bnds(glpk, col + 1, col_type,
+			 bnds.lower_bound, bnds.upper_bound);
+}
+
+bool GLPKSession::update_rhs(unsigned int row)
+{
+	const LinearProgramSnapshot &lp = get_snapshot();
+
+	if (row < lp.num_equalities)
+		glp_set_row_bnds(glpk, row + 1, GLP_FX, lp.rhs[row], lp.rhs[row]);
+	else
+		glp_set_row_bnds(glpk, row + 1, GLP_UP, 0, lp.rhs[row]);
+	return true;
+}
+
+bool GLPKSession::update_row(unsigned int row)
+{
+	set_row(row);
+	return true;
+}
+
+bool GLPKSession::update_objective(unsigned int col)
+{
+	glp_set_obj_coef(glpk, col + 1, get_snapshot().objective[col]);
+	return true;
+}
+
+bool GLPKSession::update_bounds(unsigned int col)
+{
+	set_col_bounds(col);
+	return true;
+}
+
+bool GLPKSession::solve_lp(bool warm)
+{
+	glp_smcp glpk_params;
+
+	glp_init_smcp(&glpk_params);
+
+	// Without the presolver, GLPK starts from the basis left by the
+	// previous solve. Cold starts use the same options as GLPKSolution.
+	glpk_params.presolve = warm ? GLP_OFF : GLP_ON;
+	glpk_params.pricing  = GLP_PT_STD;
+	glpk_params.r_test   = GLP_RT_STD;
+
+	simplex_code = glp_simplex(glpk, &glpk_params);
+	return simplex_code == 0 && glp_get_status(glpk) == GLP_OPT;
+}
+
+bool GLPKSession::optimize(bool warm)
+{
+	if (!is_mip)
+		// if the old basis does not work out, start over
+		return (warm && solve_lp(true)) || solve_lp(false);
+
+	glp_iocp glpk_params;
+
+	glp_init_iocp(&glpk_params);
+
+	// Branch-and-bound needs an optimal basis of the relaxation unless
+	// the presolver is used. Warm-start the relaxation if possible.
+	if (warm && solve_lp(true))
+		glpk_params.presolve = GLP_OFF;
+	else
+		glpk_params.presolve = GLP_ON;
+
+	return glp_intopt(glpk, &glpk_params) == 0 &&
+		glp_mip_status(glpk) == GLP_OPT;
+}
+
+LinearProgramSession *glpk_session()
+{
+	return new GLPKSession();
+}
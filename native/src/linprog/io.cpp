@@ -5,23 +5,21 @@
 #include "linprog/solver.h"
 #include "linprog/io.h"
 
-std::ostream& pretty_print_linear_expression(
+static void pretty_print_terms(
 	std::ostream &os,
-	const LinearExpression &exp,
+	const Term *begin, const Term *end,
 	hashmap<unsigned int, std::string> &var_names,
 	const Solution *solution,
 	bool skip_zero_vars)
 {
 	bool first = true;
+	double sum = 0;
 
-#ifdef DEBUG
-	std::string desc = exp.get_debug_description();
-	if (!desc.empty())
-		os << desc << ": ";
-#endif
-
-	foreach (exp.get_terms(), term)
+	for (const Term *term = begin; term != end; term++)
 	{
+		if (solution)
+			sum += term->first * solution->get_value(term->second);
+
 		if (skip_zero_vars && solution && !solution->get_value(term->second))
 			continue;
 
@@ -48,11 +46,47 @@ std::ostream& pretty_print_linear_expression(
 	}
 
 	if (solution && !first)
-		os << "{=" << solution->evaluate(exp) << "} ";
+		os << "{=" << sum << "} ";
+}
+
+std::ostream& pretty_print_linear_expression(
+	std::ostream &os,
+	const LinearExpression &exp,
+	hashmap<unsigned int, std::string> &var_names,
+	const Solution *solution,
+	bool skip_zero_vars)
+{
+#ifdef DEBUG
+	std::string desc = exp.get_debug_description();
+	if (!desc.empty())
+		os << desc << ": ";
+#endif
+
+	const Terms &terms = exp.get_terms();
+	if (!terms.empty())
+		pretty_print_terms(os, &terms[0], &terms[0] + terms.size(),
+				   var_names, solution, skip_zero_vars);
 
 	return os;
 }
 
+static void pretty_print_constraints(
+	std::ostream &os,
+	const ConstraintMatrix &constraints,
+	const char *relation,
+	hashmap<unsigned int, std::string> &var_names,
+	const Solution *solution,
+	bool skip_zero_vars)
+{
+	for (unsigned int r = 0; r < constraints.size(); r++)
+	{
+		pretty_print_terms(os, constraints.row_begin(r),
+				   constraints.row_end(r), var_names,
+				   solution, skip_zero_vars);
+		os << relation << constraints.get_bound(r) << std::endl;
+	}
+}
+
 std::ostream& operator<<(std::ostream &os, const LinearExpression &exp)
 {
 	hashmap<unsigned int, std::string> dummy_map;
@@ -70,18 +104,10 @@ std::ostream& pretty_print_linear_program(
 	pretty_print_linear_expression(os, *lp.get_objective(), var_names,
 	                               solution, skip_zero_vars);
 	os << " subject to:" << std::endl;
-	foreach (lp.get_equalities(), it)
-	{
-		pretty_print_linear_expression(os, *(it->first), var_names,
-	                                   solution, skip_zero_vars);
-		os << " = " << it->second << std::endl;
-	}
-	foreach (lp.get_inequalities(), it)
-	{
-		pretty_print_linear_expression(os, *(it->first), var_names,
-	                                   solution, skip_zero_vars);
-		os << " <= " << it->second << std::endl;
-	}
+	pretty_print_constraints(os, lp.get_equalities(), " = ", var_names,
+	                         solution, skip_zero_vars);
+	pretty_print_constraints(os, lp.get_inequalities(), " <= ", var_names,
+	                         solution, skip_zero_vars);
 
 	return os;
 }
@@ -0,0 +1,162 @@
+#include <algorithm>
+
+#include "linprog/session.h"
+
+static void append_rows(LinearProgramSnapshot &snap, const ConstraintMatrix &m)
+{
+	const unsigned int offset = snap.cols.size();
+
+	foreach(m.get_terms(), term)
+	{
+		snap.cols.push_back(term->second);
+		snap.coeffs.push_back(term->first);
+	}
+	for (unsigned int r = 0; r < m.size(); r++)
+		snap.row_start.push_back(offset + m.get_row_start(r + 1));
+	snap.rhs.insert(snap.rhs.end(), m.get_bounds().begin(), m.get_bounds().end());
+}
+
+void LinearProgramSnapshot::load(const LinearProgram &lp, unsigned int n,
+				 double var_lb, double var_ub)
+{
+	num_cols = n;
+	num_equalities = lp.get_equalities().size();
+
+	objective.assign(num_cols, 0.0);
+	foreach(lp.get_objective()->get_terms(), term)
+		objective[term->second] = term->first;
+
+	VariableRange dflt;
+	dflt.has_lower = dflt.has_upper = true;
+	dflt.lower_bound = var_lb;
+	dflt.upper_bound = var_ub;
+	bounds.resize(num_cols);
+	for (unsigned int c = 0; c < num_cols; c++)
+	{
+		dflt.variable_id = c;
+		bounds[c] = dflt;
+	}
+	foreach(lp.get_non_default_variable_ranges(), bnds)
+		bounds[bnds->variable_id] = *bnds;
+
+	kind.assign(num_cols, CONTINUOUS);
+	for (unsigned int c = 0; c < num_cols; c++)
+		if (lp.is_binary_variable(c))
+			kind[c] = BINARY;
+		else if (lp.is_integer_variable(c))
+			kind[c] = INTEGER;
+
+	const ConstraintMatrix &equ = lp.get_equalities();
+	const ConstraintMatrix &inequ = lp.get_inequalities();
+	const unsigned int num_terms = equ.get_num_terms() + inequ.get_num_terms();
+
+	row_start.clear();
+	cols.clear();
+	coeffs.clear();
+	rhs.clear();
+	row_start.reserve(equ.size() + inequ.size() + 1);
+	cols.reserve(num_terms);
+	coeffs.reserve(num_terms);
+	row_start.push_back(0);
+	append_rows(*this, equ);
+	append_rows(*this, inequ);
+}
+
+bool LinearProgramSnapshot::is_mip() const
+{
+	for (unsigned int c = 0; c < num_cols; c++)
+		if (kind[c] != CONTINUOUS)
+			return true;
+	return false;
+}
+
+bool LinearProgramSnapshot::has_same_structure(
+	const LinearProgramSnapshot &other) const
+{
+	return num_cols == other.num_cols
+		&& num_equalities == other.num_equalities
+		&& kind == other.kind
+		&& row_start == other.row_start
+		&& cols == other.cols;
+}
+
+bool LinearProgramSnapshot::row_differs(
+	const LinearProgramSnapshot &other, unsigned int r) const
+{
+	for (unsigned int k = row_start[r]; k < row_start[r + 1]; k++)
+		if (coeffs[k] != other.coeffs[k])
+			return true;
+	return false;
+}
+
+static bool bounds_differ(const VariableRange &a, const VariableRange &b)
+{
+	return a.has_lower != b.has_lower
+		|| a.has_upper != b.has_upper
+		|| (a.has_lower && a.lower_bound != b.lower_bound)
+		|| (a.has_upper && a.upper_bound != b.upper_bound);
+}
+
+const Solution *IncrementalLPSession::solve(const LinearProgram &lp,
+					    unsigned int max_num_vars)
+{
+	if (!max_num_vars)
+		// Trivial case: no variables.
+		return &empty;
+
+	next.load(lp, max_num_vars, var_lb, var_ub);
+
+	bool ok, warm;
+
+	if (loaded && next.has_same_structure(current))
+	{
+		std::swap(current, next);
+
+		// next now holds the program that the solver has
+		ok = true;
+		for (unsigned int r = 0; ok && r < current.get_num_rows(); r++)
+		{
+			if (current.rhs[r] != next.rhs[r])
+				ok = update_rhs(r);
+			if (ok && current.row_differs(next, r))
+				ok = update_row(r);
+		}
+		for (unsigned int c = 0; ok && c < current.num_cols; c++)
+		{
+			if (current.objective[c] != next.objective[c])
+				ok = update_objective(c);
+			if (ok && bounds_differ(current.bounds[c], next.bounds[c]))
+				ok = update_bounds(c);
+		}
+		warm = true;
+		num_updates++;
+	}
+	else
+	{
+		std::swap(current, next);
+		ok = false;
+	}
+
+	if (!ok)
+	{
+		// rebuild from scratch
+		free_problem();
+		ok = loaded = load_problem();
+		warm = false;
+		num_loads++;
+	}
+
+	if (ok && optimize(warm))
+		return get_solution();
+	else
+	{
+		show_error();
+		return NULL;
+	}
+}
+
+void IncrementalLPSession::reset()
+{
+	free_problem();
+	loaded = false;
+}
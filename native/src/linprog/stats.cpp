@@ -0,0 +1,194 @@
+#include <algorithm>
+#include <map>
+#include <string>
+#include <mutex>
+#include <iterator>
+
+#include "linprog/model.h"
+#include "linprog/stats.h"
+
+#include "cpu_time.h"
+
+static bool stats_enabled = false;
+
+// Entries are never erased, so pointers to them remain valid; the lock
+// also protects their contents.
+static std::map<std::string, LPStats> stats_by_analysis;
+static std::mutex stats_lock;
+
+// per-thread state; costs are merged into the target at phase boundaries
+struct ThreadStats
+{
+	LPStats *target;
+	LPStats pending;
+	// start of the current phase
+	double mark;
+	// whether the current phase follows a solution
+	bool solved;
+};
+
+static thread_local ThreadStats thread_stats;
+
+void LPStats::merge(const LPStats& other)
+{
+	calls          += other.calls;
+	num_lps        += other.num_lps;
+	model_gen_time += other.model_gen_time;
+	solver_time    += other.solver_time;
+	extract_time   += other.extract_time;
+	rows           += other.rows;
+	cols           += other.cols;
+	nonzeros       += other.nonzeros;
+	integer_vars   += other.integer_vars;
+	max_rows     = std::max(max_rows, other.max_rows);
+	max_cols     = std::max(max_cols, other.max_cols);
+	max_nonzeros = std::max(max_nonzeros, other.max_nonzeros);
+}
+
+void set_lp_stats_enabled(bool enabled)
+{
+	stats_enabled = enabled;
+}
+
+bool get_lp_stats_enabled()
+{
+	return stats_enabled;
+}
+
+void reset_lp_stats()
+{
+	std::lock_guard<std::mutex> guard(stats_lock);
+	foreach(stats_by_analysis, it)
+		it->second = LPStats();
+}
+
+unsigned int get_lp_stats_count()
+{
+	std::lock_guard<std::mutex> guard(stats_lock);
+	return stats_by_analysis.size();
+}
+
+const char *get_lp_stats_name(unsigned int index)
+{
+	std::lock_guard<std::mutex> guard(stats_lock);
+	if (index >= stats_by_analysis.size())
+		return NULL;
+	return std::next(stats_by_analysis.begin(), index)->first.c_str();
+}
+
+LPStats get_lp_stats(unsigned int index)
+{
+	std::lock_guard<std::mutex> guard(stats_lock);
+	if (index >= stats_by_analysis.size())
+		return LPStats();
+	return std::next(stats_by_analysis.begin(), index)->second;
+}
+
+// end the current phase of the calling thread and publish its costs
+static void flush_phase(ThreadStats &ts)
+{
+	double elapsed = get_cpu_usage() - ts.mark;
+
+	if (ts.solved)
+		ts.pending.extract_time += elapsed;
+	else
+		ts.pending.model_gen_time += elapsed;
+
+	std::lock_guard<std::mutex> guard(stats_lock);
+	ts.target->merge(ts.pending);
+	ts.pending = LPStats();
+}
+
+void LPStatsScope::enter(LPStats *target)
+{
+	ThreadStats &ts = thread_stats;
+
+	saved_target = ts.target;
+	saved_solved = ts.solved;
+	if (ts.target)
+		flush_phase(ts);
+
+	ts.target = target;
+	ts.solved = false;
+	if (target)
+		ts.mark = get_cpu_usage();
+}
+
+LPStatsScope::LPStatsScope(const char *analysis)
+{
+	LPStats *target = thread_stats.target;
+
+	if (!target && stats_enabled)
+	{
+		std::lock_guard<std::mutex> guard(stats_lock);
+		target = &stats_by_analysis[analysis];
+		target->calls++;
+	}
+	enter(target);
+}
+
+LPStatsScope::LPStatsScope(LPStats *target)
+{
+	enter(target);
+}
+
+LPStatsScope::~LPStatsScope()
+{
+	ThreadStats &ts = thread_stats;
+	bool solved = ts.solved;
+
+	if (ts.target)
+		flush_phase(ts);
+
+	ts.target = saved_target;
+	// whatever the enclosing scope does next follows these solutions
+	ts.solved = saved_solved || solved;
+	if (saved_target)
+		ts.mark = get_cpu_usage();
+}
+
+LPStats *LPStatsScope::current()
+{
+	return thread_stats.target;
+}
+
+void lp_stats_solve_begin()
+{
+	ThreadStats &ts = thread_stats;
+
+	if (ts.target)
+	{
+		double now = get_cpu_usage();
+		ts.pending.model_gen_time += now - ts.mark;
+		ts.mark = now;
+	}
+}
+
+void lp_stats_solve_end(const LinearProgram &lp, unsigned int max_num_vars)
+{
+	ThreadStats &ts = thread_stats;
+
+	if (ts.target)
+	{
+		double now = get_cpu_usage();
+		ts.pending.solver_time += now - ts.mark;
+		ts.mark = now;
+		ts.solved = true;
+
+		unsigned long rows = lp.get_equalities().size()
+			+ lp.get_inequalities().size();
+		unsigned long nonzeros = lp.get_equalities().get_num_terms()
+			+ lp.get_inequalities().get_num_terms();
+
+		LPStats &s = ts.pending;
+		s.num_lps++;
+		s.rows += rows;
+		s.cols += max_num_vars;
+		s.nonzeros += nonzeros;
+		s.integer_vars += lp.get_num_binary_variables()
+			+ lp.get_num_integer_variables();
+		s.max_rows = std::max(s.max_rows, rows);
+		s.max_cols = std::max(s.max_cols, (unsigned long) max_num_vars);
+		s.max_nonzeros = std::max(s.max_nonzeros, nonzeros);
+	}
+}
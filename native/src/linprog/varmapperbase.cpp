@@ -30,10 +30,8 @@ hashmap<unsigned int, std::string> VarMapperBase::get_translation_table() const
 {
 	hashmap<unsigned int, std::string> table;
 
-	foreach(map, kv)
-	{
-		table[kv->second] = key2str(kv->first, kv->second);
-	}
+	for (unsigned int i = 0; i < keys.size(); i++)
+		table[start_var + i] = key2str(keys[i], start_var + i);
 
 	return table;
 }
@@ -0,0 +1,231 @@
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "tasks.h"
+#include "schedulability.h"
+#include "memo.h"
+
+typedef std::vector<unsigned long> WCETs;
+
+// all results for one combination of timing parameters
+struct MemoGroup
+{
+	std::deque<WCETs> accepted; // pairwise incomparable
+	std::deque<WCETs> rejected; // pairwise incomparable
+};
+
+// a <= b component-wise
+static bool dominated_by(const WCETs &a, const WCETs &b)
+{
+	for (unsigned int i = 0; i < a.size(); i++)
+		if (a[i] > b[i])
+			return false;
+	return true;
+}
+
+class MemoTable
+{
+private:
+	std::mutex lock;
+	std::map<std::vector<unsigned long>, MemoGroup> groups;
+	unsigned int max_entries;
+	unsigned int max_groups;
+
+public:
+	unsigned long hits, misses;
+
+	MemoTable(unsigned int max_entries, unsigned int max_groups)
+		: max_entries(max_entries), max_groups(max_groups),
+		  hits(0), misses(0)
+	{}
+
+	// Tasks are ordered by their timing parameters and, among tasks with
+	// equal parameters, by WCET, so that dominance can be checked
+	// position by position.
+	static void make_key(const TaskSet &ts, bool check_preconditions,
+	                     std::vector<unsigned long> &key, WCETs &wcets)
+	{
+		enum { FIELDS = 5 };
+		std::vector<unsigned long> tasks;
+		tasks.reserve(ts.get_task_count() * FIELDS);
+		for (unsigned int i = 0; i < ts.get_task_count(); i++)
+		{
+			tasks.push_back(ts[i].get_period());
+			tasks.push_back(ts[i].get_deadline());
+			tasks.push_back(ts[i].get_self_suspension());
+			tasks.push_back(ts[i].get_tardiness_threshold());
+			tasks.push_back(ts[i].get_wcet());
+		}
+
+		std::vector<unsigned int> order(ts.get_task_count());
+		for (unsigned int i = 0; i < order.size(); i++)
+			order[i] = i;
+		std::sort(order.begin(), order.end(),
+			[&](unsigned int a, unsigned int b)
+			{
+				return std::lexicographical_compare(
+					&tasks[a * FIELDS], &tasks[(a + 1) * FIELDS],
+					&tasks[b * FIELDS], &tasks[(b + 1) * FIELDS]);
+			});
+
+		key.clear();
+		wcets.clear();
+		key.push_back(check_preconditions);
+		for (unsigned int i = 0; i < order.size(); i++)
+		{
+			const unsigned long *t = &tasks[order[i] * FIELDS];
+			key.insert(key.end(), t, t + FIELDS - 1);
+			wcets.push_back(t[FIELDS - 1]);
+		}
+	}
+
+	bool lookup(const std::vector<unsigned long> &key, const WCETs &wcets,
+	            sched_result_t &result)
+	{
+		std::lock_guard<std::mutex> guard(lock);
+
+		std::map<std::vector<unsigned long>, MemoGroup>::const_iterator
+			it = groups.find(key);
+		if (it != groups.end())
+		{
+			for (const WCETs &a : it->second.accepted)
+				if (dominated_by(wcets, a))
+				{
+					hits++;
+					result = SCHED_SCHEDULABLE;
+					return true;
+				}
+			for (const WCETs &r : it->second.rejected)
+				if (dominated_by(r, wcets))
+				{
+					hits++;
+					result = SCHED_UNSCHEDULABLE;
+					return true;
+				}
+		}
+		misses++;
+		return false;
+	}
+
+	void store(const std::vector<unsigned long> &key, const WCETs &wcets,
+	           bool schedulable)
+	{
+		std::lock_guard<std::mutex> guard(lock);
+
+		if (groups.size() >= max_groups && !groups.count(key))
+			groups.clear();
+
+		MemoGroup &group = groups[key];
+		std::deque<WCETs> &entries =
+			schedulable ? group.accepted : group.rejected;
+
+		// drop the entries that the new one makes redundant
+		for (unsigned int i = 0; i < entries.size(); )
+			if (schedulable ? dominated_by(entries[i], wcets)
+			                : dominated_by(wcets, entries[i]))
+				entries.erase(entries.begin() + i);
+			else
+				i++;
+
+		entries.push_back(wcets);
+		if (entries.size() > max_entries)
+			entries.pop_front();
+	}
+
+	void clear()
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		groups.clear();
+		hits = misses = 0;
+	}
+
+	unsigned long get_hits()
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		return hits;
+	}
+
+	unsigned long get_misses()
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		return misses;
+	}
+};
+
+MemoizedTest::MemoizedTest(SchedulabilityTest *test,
+                           unsigned int max_entries,
+                           unsigned int max_groups)
+	: test(test), table(new MemoTable(max_entries, max_groups))
+{
+}
+
+MemoizedTest::~MemoizedTest()
+{
+	delete table;
+}
+
+// Answers from the table if possible; otherwise, calls run() and
+// remembers its result unless the test gave up.
+template <typename Run>
+static sched_result_t memoized(MemoTable *table, const TaskSet &ts,
+                               bool check_preconditions, Run run)
+{
+	// Smaller WCETs may violate the preconditions (e.g., a zero WCET),
+	// so such task sets are left to the test.
+	if (check_preconditions && !ts.has_only_feasible_tasks())
+		return run();
+
+	std::vector<unsigned long> key;
+	WCETs wcets;
+	sched_result_t result;
+
+	MemoTable::make_key(ts, check_preconditions, key, wcets);
+	if (table->lookup(key, wcets, result))
+		return result;
+
+	result = run();
+	if (result != SCHED_UNKNOWN)
+		table->store(key, wcets, result == SCHED_SCHEDULABLE);
+	return result;
+}
+
+bool MemoizedTest::is_schedulable(const TaskSet &ts, bool check_preconditions)
+{
+	return check_default_limits(ts, check_preconditions) == SCHED_SCHEDULABLE;
+}
+
+sched_result_t MemoizedTest::check(const TaskSet &ts, Budget &budget,
+                                   bool check_preconditions)
+{
+	return memoized(table, ts, check_preconditions, [&]()
+		{
+			return test->check(ts, budget, check_preconditions);
+		});
+}
+
+sched_result_t MemoizedTest::check_default_limits(const TaskSet &ts,
+                                                  bool check_preconditions)
+{
+	return memoized(table, ts, check_preconditions, [&]()
+		{
+			return test->check_default_limits(ts, check_preconditions);
+		});
+}
+
+void MemoizedTest::clear()
+{
+	table->clear();
+}
+
+unsigned long MemoizedTest::get_hits() const
+{
+	return table->get_hits();
+}
+
+unsigned long MemoizedTest::get_misses() const
+{
+	return table->get_misses();
+}
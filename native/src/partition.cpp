@@ -0,0 +1,197 @@
+#include <algorithm>
+
+#include "tasks.h"
+#include "schedulability.h"
+#include "partition.h"
+#include "edf/qpa.h"
+
+void UtilizationFit::get_exact_size(const Task &tsk, fractional_t &size) const
+{
+	tsk.get_utilization(size);
+}
+
+void UtilizationFit::reset(const TaskSet &ts, unsigned int num_bins)
+{
+	sizes.resize(ts.get_task_count());
+	for (unsigned int i = 0; i < ts.get_task_count(); i++)
+		get_exact_size(ts[i], sizes[i]);
+
+	loads.assign(num_bins, fractional_t(0));
+	assigned.assign(num_bins, std::vector<unsigned int>());
+}
+
+bool UtilizationFit::try_assign(unsigned int task, unsigned int bin)
+{
+	fractional_t load = loads[bin];
+	load += sizes[task];
+	if (load > capacity)
+		return false;
+
+	loads[bin] = load;
+	assigned[bin].push_back(task);
+	return true;
+}
+
+void UtilizationFit::unassign_last(unsigned int bin)
+{
+	loads[bin] -= sizes[assigned[bin].back()];
+	assigned[bin].pop_back();
+}
+
+void UtilizationFit::get_size(unsigned int task, fractional_t &size) const
+{
+	size = sizes[task];
+}
+
+void DensityFit::get_exact_size(const Task &tsk, fractional_t &size) const
+{
+	size  = tsk.get_wcet();
+	size /= std::min(tsk.get_deadline(), tsk.get_period());
+}
+
+QPAFit::~QPAFit()
+{
+	clear();
+}
+
+void QPAFit::clear()
+{
+	for (unsigned int i = 0; i < bins.size(); i++)
+		delete bins[i];
+	bins.clear();
+}
+
+void QPAFit::reset(const TaskSet &ts, unsigned int num_bins)
+{
+	clear();
+	tasks = &ts;
+	for (unsigned int i = 0; i < num_bins; i++)
+		bins.push_back(new IncrementalQPA());
+}
+
+bool QPAFit::try_assign(unsigned int task, unsigned int bin)
+{
+	const Task &tsk = (*tasks)[task];
+	return bins[bin]->add_task_if_schedulable(
+		tsk.get_wcet(), tsk.get_period(), tsk.get_deadline());
+}
+
+void QPAFit::unassign_last(unsigned int bin)
+{
+	bins[bin]->remove_task(bins[bin]->get_task_count() - 1);
+}
+
+void QPAFit::get_size(unsigned int task, fractional_t &size) const
+{
+	(*tasks)[task].get_utilization(size);
+}
+
+// orders indices by key; ties keep their relative order
+class ByKey
+{
+	const std::vector<fractional_t> &key;
+	bool descending;
+
+  public:
+	ByKey(const std::vector<fractional_t> &key, bool descending)
+		: key(key), descending(descending) {}
+
+	bool operator()(unsigned int a, unsigned int b) const
+	{
+		return descending ? key[a] > key[b] : key[a] < key[b];
+	}
+};
+
+bool Partitioner::partition(const TaskSet &ts, unsigned int num_bins,
+                            PartitionFitTest &fit)
+{
+	const unsigned int n = ts.get_task_count();
+
+	fit.reset(ts, num_bins);
+
+	assignment.assign(n, -1);
+	num_misfits = 0;
+
+	std::vector<fractional_t> sizes(n);
+	std::vector<unsigned int> order(n);
+	for (unsigned int i = 0; i < n; i++)
+	{
+		fit.get_size(i, sizes[i]);
+		order[i] = i;
+	}
+	if (decreasing)
+		std::stable_sort(order.begin(), order.end(), ByKey(sizes, true));
+
+	std::vector<fractional_t> loads(num_bins, fractional_t(0));
+	std::vector<unsigned int> bins(num_bins);
+	unsigned int cur = 0; // next fit only
+
+	for (unsigned int k = 0; k < n; k++)
+	{
+		unsigned int task = order[k];
+		int placed = -1;
+
+		switch (heuristic)
+		{
+		case NEXT_FIT:
+			while (placed < 0 && cur < num_bins)
+				if (fit.try_assign(task, cur))
+					placed = cur;
+				else
+					cur++;
+			break;
+
+		case FIRST_FIT:
+			for (unsigned int b = 0; placed < 0 && b < num_bins; b++)
+				if (fit.try_assign(task, b))
+					placed = b;
+			break;
+
+		case BEST_FIT:
+		case WORST_FIT:
+		case ALMOST_WORST_FIT:
+			for (unsigned int b = 0; b < num_bins; b++)
+				bins[b] = b;
+			std::stable_sort(bins.begin(), bins.end(),
+			                 ByKey(loads, heuristic == BEST_FIT));
+
+			for (unsigned int i = 0; i < num_bins; i++)
+			{
+				unsigned int b = bins[i];
+				if (!fit.try_assign(task, b))
+					continue;
+				if (heuristic != ALMOST_WORST_FIT)
+				{
+					placed = b;
+					break;
+				}
+				else if (placed < 0)
+					// keep looking for the second-lowest load
+					placed = b;
+				else
+				{
+					// on equal loads, stay with the lower index
+					if (loads[b] == loads[placed])
+						fit.unassign_last(b);
+					else
+					{
+						fit.unassign_last(placed);
+						placed = b;
+					}
+					break;
+				}
+			}
+			break;
+		}
+
+		if (placed >= 0)
+		{
+			assignment[task] = placed;
+			loads[placed] += sizes[task];
+		}
+		else
+			num_misfits++;
+	}
+
+	return num_misfits == 0;
+}
@@ -37,21 +37,18 @@ void run_periodic_simulation(ScheduleSimulation& sim,
                              TaskSet& ts,
                              simtime_t end_of_simulation)
 {
-    PeriodicJobSequence** jobs;
+    // reserved up front: the simulator keeps pointers to the jobs
+    std::vector<PeriodicJobSequence> jobs;
+    jobs.reserve(ts.get_task_count());
 
-    jobs = new PeriodicJobSequence*[ts.get_task_count()];
     for (unsigned int i = 0; i < ts.get_task_count(); i++)
     {
-        jobs[i] = new PeriodicJobSequence(ts[i]);
-        jobs[i]->set_simulation(&sim);
-        sim.add_release(jobs[i]);
+        jobs.push_back(PeriodicJobSequence(ts[i]));
+        jobs[i].set_simulation(&sim);
+        sim.add_release(&jobs[i]);
     }
 
     sim.simulate_until(end_of_simulation);
-
-    for (unsigned int i = 0; i < ts.get_task_count(); i++)
-        delete jobs[i];
-    delete [] jobs;
 }
 
 
@@ -0,0 +1,187 @@
+#include <random>
+#include <algorithm>
+
+#include "tasks.h"
+#include "schedulability.h"
+#include "batch.h"
+#include "sweep.h"
+#include "parallel.h"
+
+void TaskSetGenerator::generate(double target_util, unsigned long seed,
+                                TaskSet &ts) const
+{
+	std::mt19937_64 rng(seed);
+	std::uniform_int_distribution<unsigned long> period_dist(min_period, max_period);
+	std::uniform_real_distribution<double> util_dist(min_util, max_util);
+
+	double usum = 0;
+	while (usum < target_util)
+	{
+		unsigned long period = period_dist(rng);
+		unsigned long cost = period * util_dist(rng);
+
+		period = std::max(1UL, period);
+		cost   = std::max(1UL, cost);
+
+		double util = (double) cost / period;
+		usum += util;
+		if (usum > target_util)
+		{
+			if (!squeeze)
+				break;
+			// make last task fit exactly
+			util -= usum - target_util;
+			cost = period * util;
+			if (!cost)
+				break;
+		}
+		ts.add_task(cost, period);
+	}
+}
+
+static unsigned int bucket_of(const TaskSet &ts, double bucket_width)
+{
+	if (!(bucket_width > 0))
+		return 0;
+
+	fractional_t util;
+	ts.get_utilization(util);
+	// tolerate rounding errors at bucket boundaries
+	return util.get_d() / bucket_width + 1E-9;
+}
+
+// task sets from a batch
+class BatchSource
+{
+	const TaskSetBatch &batch;
+
+  public:
+	BatchSource(const TaskSetBatch &batch) : batch(batch) {}
+
+	void get(unsigned long idx, TaskSet &ts) const
+	{
+		batch.get_task_set(idx, ts);
+	}
+};
+
+// samples task sets per step of the target utilization
+class GeneratorSource
+{
+	const TaskSetGenerator &gen;
+	double min_util, step;
+	unsigned int samples;
+	unsigned long seed;
+
+  public:
+	GeneratorSource(const TaskSetGenerator &gen, double min_util,
+	                double step, unsigned int samples, unsigned long seed)
+		: gen(gen), min_util(min_util), step(step),
+		  samples(samples), seed(seed)
+	{}
+
+	void get(unsigned long idx, TaskSet &ts) const
+	{
+		double target = min_util + (idx / samples) * step;
+		gen.generate(target, mix_seed(seed, idx), ts);
+	}
+};
+
+// per-thread partial results, merged after the sweep
+struct SweepCounts
+{
+	std::vector<unsigned long> samples;
+	std::vector<unsigned long> schedulable;
+	std::vector<unsigned long> unknown;
+};
+
+template <typename Source>
+void SchedulabilitySweep::sweep(unsigned long num_task_sets,
+                                const Source &source,
+                                bool check_preconditions)
+{
+	unsigned int threads = num_threads ? num_threads : default_thread_count();
+	std::vector<SweepCounts> counts(threads);
+	const unsigned int num_tests = tests.size();
+
+	parallel_for(num_task_sets, threads,
+		[&](unsigned int worker, unsigned long idx)
+		{
+			TaskSet ts;
+			source.get(idx, ts);
+
+			SweepCounts &c = counts[worker];
+			unsigned int bucket = bucket_of(ts, bucket_width);
+			if (bucket >= c.samples.size())
+			{
+				c.samples.resize(bucket + 1, 0);
+				c.schedulable.resize((bucket + 1) * num_tests, 0);
+				c.unknown.resize((bucket + 1) * num_tests, 0);
+			}
+
+			c.samples[bucket]++;
+			for (unsigned int j = 0; j < num_tests; j++)
+			{
+				sched_result_t result;
+				if (use_budget)
+				{
+					// restart the clock on this thread
+					Budget b = budget;
+					b.reset();
+					result = tests[j]->check(ts, b, check_preconditions);
+				}
+				else if (tests[j]->is_schedulable(ts, check_preconditions))
+					result = SCHED_SCHEDULABLE;
+				else
+					result = SCHED_UNSCHEDULABLE;
+
+				if (result == SCHED_SCHEDULABLE)
+					c.schedulable[bucket * num_tests + j]++;
+				else if (result == SCHED_UNKNOWN)
+					c.unknown[bucket * num_tests + j]++;
+			}
+		});
+
+	samples.clear();
+	schedulable.clear();
+	unknown.clear();
+	for (unsigned int w = 0; w < threads; w++)
+	{
+		const SweepCounts &c = counts[w];
+		if (c.samples.size() > samples.size())
+		{
+			samples.resize(c.samples.size(), 0);
+			schedulable.resize(c.schedulable.size(), 0);
+			unknown.resize(c.unknown.size(), 0);
+		}
+		for (unsigned int b = 0; b < c.samples.size(); b++)
+			samples[b] += c.samples[b];
+		for (unsigned int k = 0; k < c.schedulable.size(); k++)
+		{
+			schedulable[k] += c.schedulable[k];
+			unknown[k] += c.unknown[k];
+		}
+	}
+}
+
+void SchedulabilitySweep::run(const TaskSetBatch &batch,
+                              bool check_preconditions)
+{
+	sweep(batch.get_task_set_count(), BatchSource(batch),
+	      check_preconditions);
+}
+
+void SchedulabilitySweep::run(const TaskSetGenerator &gen,
+                              double min_util, double max_util, double step,
+                              unsigned int samples_per_step,
+                              unsigned long seed,
+                              bool check_preconditions)
+{
+	unsigned long steps = 0;
+	if (step > 0 && max_util >= min_util)
+		// tolerate rounding errors in (max_util - min_util) / step
+		steps = (unsigned long) ((max_util - min_util) / step + 1E-9) + 1;
+
+	sweep(steps * samples_per_step,
+	      GeneratorSource(gen, min_util, step, samples_per_step, seed),
+	      check_preconditions);
+}
@@ -0,0 +1,287 @@
+#include <stdlib.h>
+#include <new>
+
+#include "tasks.h"
+#include "task_columns.h"
+
+/* The kernels use GCC vector extensions, which are mapped to SSE/AVX
+ * instructions where available and to scalar code otherwise. */
+
+#define LANES 4
+#define ALIGNMENT (LANES * sizeof(double))
+
+typedef double vdouble __attribute__((vector_size(LANES * sizeof(double))));
+typedef long   vlong   __attribute__((vector_size(LANES * sizeof(long))));
+
+// 2^52: doubles represent all integers up to here exactly, and adding
+// it to a value in [0, 2^52) rounds that value to the nearest integer.
+static const double EXACT_LIMIT = 4503599627370496.0;
+
+#define SPLAT(x) ((vdouble) {(x), (x), (x), (x)})
+
+#define LOAD(array, i) (*(const vdouble *) ((array) + (i)))
+
+// select a where mask is set, else b
+#define SELECT(mask, a, b) \
+	((vdouble) (((vlong) (a) & (mask)) | ((vlong) (b) & ~(mask))))
+
+// floor(x) for 0 <= x < 2^52
+#define FLOOR_NONNEG(x, res)                                    \
+	do {                                                        \
+		(res) = ((x) + SPLAT(EXACT_LIMIT)) - SPLAT(EXACT_LIMIT); \
+		(res) -= SELECT((res) > (x), SPLAT(1.0), SPLAT(0.0));   \
+	} while (0)
+
+// ceil(x) for 0 <= x < 2^52
+#define CEIL_NONNEG(x, res)                                     \
+	do {                                                        \
+		(res) = ((x) + SPLAT(EXACT_LIMIT)) - SPLAT(EXACT_LIMIT); \
+		(res) += SELECT((res) < (x), SPLAT(1.0), SPLAT(0.0));   \
+	} while (0)
+
+static double horizontal_sum(const vdouble &v)
+{
+	double sum = 0;
+	for (unsigned int i = 0; i < LANES; i++)
+		sum += v[i];
+	return sum;
+}
+
+static double *alloc_column(unsigned int capacity, double padding)
+{
+	void *mem;
+	if (posix_memalign(&mem, ALIGNMENT, capacity * sizeof(double)))
+		throw std::bad_alloc();
+
+	double *column = (double *) mem;
+	for (unsigned int i = 0; i < capacity; i++)
+		column[i] = padding;
+	return column;
+}
+
+TaskColumns::TaskColumns(unsigned int num_tasks)
+	: count(0)
+{
+	capacity = (num_tasks + LANES - 1) / LANES * LANES;
+	if (!capacity)
+		capacity = LANES;
+
+	// Padding tasks have zero cost and thus contribute no demand.
+	wcet     = alloc_column(capacity, 0);
+	period   = alloc_column(capacity, 1);
+	deadline = alloc_column(capacity, 1);
+
+	wcet_sum = 0;
+	util = 0;
+	representable = true;
+	update_max_time();
+}
+
+TaskColumns::TaskColumns(const TaskSet &ts)
+	: TaskColumns(ts.get_task_count())
+{
+	for (unsigned int i = 0; i < ts.get_task_count(); i++)
+		add_task(ts[i].get_wcet(), ts[i].get_period(),
+		         ts[i].get_deadline());
+}
+
+TaskColumns::~TaskColumns()
+{
+	free(wcet);
+	free(period);
+	free(deadline);
+}
+
+static void grow_column(double *&column, unsigned int count,
+                        unsigned int capacity, double padding)
+{
+	double *larger = alloc_column(capacity, padding);
+	for (unsigned int i = 0; i < count; i++)
+		larger[i] = column[i];
+	free(column);
+	column = larger;
+}
+
+void TaskColumns::add_task(unsigned long e, unsigned long p, unsigned long d)
+{
+	if (count == capacity)
+	{
+		capacity *= 2;
+		grow_column(wcet, count, capacity, 0);
+		grow_column(period, count, capacity, 1);
+		grow_column(deadline, count, capacity, 1);
+	}
+
+	wcet[count]     = e;
+	period[count]   = p;
+	deadline[count] = d;
+	count++;
+
+	add_to_sums(e, p, d);
+	update_max_time();
+}
+
+void TaskColumns::remove_task(unsigned int idx)
+{
+	count--;
+	for (unsigned int i = idx; i < count; i++)
+	{
+		wcet[i]     = wcet[i + 1];
+		period[i]   = period[i + 1];
+		deadline[i] = deadline[i + 1];
+	}
+	wcet[count]     = 0;
+	period[count]   = 1;
+	deadline[count] = 1;
+
+	// recompute sums from scratch to avoid accumulating rounding errors
+	wcet_sum = 0;
+	util = 0;
+	representable = true;
+	for (unsigned int i = 0; i < count; i++)
+		add_to_sums(wcet[i], period[i], deadline[i]);
+	update_max_time();
+}
+
+void TaskColumns::add_to_sums(double e, double p, double d)
+{
+	if (e >= EXACT_LIMIT || p >= EXACT_LIMIT || d >= EXACT_LIMIT
+	    || p == 0 || d == 0)
+		// can't represent parameters exactly => always fall back
+		representable = false;
+	else
+	{
+		wcet_sum += e;
+		util     += e / p;
+	}
+}
+
+void TaskColumns::update_max_time()
+{
+	// The demand of each task is at most (time / p_i + 1) * e_i, so the
+	// total is bounded by time * util + wcet_sum. Inflate util slightly
+	// to account for rounding errors in the sum.
+	double util_bound = util * (1 + 1E-9);
+
+	if (!representable || wcet_sum >= EXACT_LIMIT)
+		max_time = 0;
+	else if (util_bound * (EXACT_LIMIT - 1) + wcet_sum < EXACT_LIMIT)
+		max_time = EXACT_LIMIT - 1;
+	else
+		max_time = (EXACT_LIMIT - wcet_sum) / util_bound;
+}
+
+bool TaskColumns::bound_demand(unsigned long time, unsigned long &demand) const
+{
+	if (!is_exact_at(time))
+		return false;
+
+	vdouble t = SPLAT((double) time);
+	vdouble sum = SPLAT(0.0);
+
+	for (unsigned int i = 0; i < capacity; i += LANES)
+	{
+		vdouble diff = t - LOAD(deadline, i);
+		vlong active = diff >= SPLAT(0.0);
+		vdouble jobs;
+
+		diff = SELECT(active, diff, SPLAT(0.0));
+		FLOOR_NONNEG(diff / LOAD(period, i), jobs);
+		jobs += SPLAT(1.0);
+		sum += SELECT(active, jobs * LOAD(wcet, i), SPLAT(0.0));
+	}
+
+	demand = horizontal_sum(sum);
+	return true;
+}
+
+bool TaskColumns::bound_request(unsigned long time, unsigned long &request) const
+{
+	if (!is_exact_at(time))
+		return false;
+
+	vdouble t = SPLAT((double) time);
+	vdouble sum = SPLAT(0.0);
+
+	for (unsigned int i = 0; i < capacity; i += LANES)
+	{
+		vdouble jobs;
+		CEIL_NONNEG(t / LOAD(period, i), jobs);
+		sum += jobs * LOAD(wcet, i);
+	}
+
+	request = horizontal_sum(sum);
+	return true;
+}
+
+bool TaskColumns::demand_per_task(unsigned long time,
+                                  unsigned long *demand) const
+{
+	if (!is_exact_at(time))
+		return false;
+
+	vdouble t = SPLAT((double) time);
+
+	for (unsigned int i = 0; i < capacity; i += LANES)
+	{
+		vdouble diff = t - LOAD(deadline, i);
+		vlong active = diff >= SPLAT(0.0);
+		vdouble jobs, dbf;
+
+		diff = SELECT(active, diff, SPLAT(0.0));
+		FLOOR_NONNEG(diff / LOAD(period, i), jobs);
+		jobs += SPLAT(1.0);
+		dbf = SELECT(active, jobs * LOAD(wcet, i), SPLAT(0.0));
+
+		for (unsigned int j = 0; j < LANES && i + j < count; j++)
+			demand[i + j] = dbf[j];
+	}
+
+	return true;
+}
+
+bool TaskColumns::carry_in_demand_per_task(unsigned long time,
+                                           unsigned long *demand) const
+{
+	if (!is_exact_at(time))
+		return false;
+
+	vdouble t = SPLAT((double) time);
+
+	for (unsigned int i = 0; i < capacity; i += LANES)
+	{
+		vdouble p = LOAD(period, i);
+		vdouble e = LOAD(wcet, i);
+		vdouble jobs, rest, dbf;
+
+		FLOOR_NONNEG(t / p, jobs);
+		// exact: jobs * p <= time
+		rest = t - jobs * p;
+		dbf = jobs * e + SELECT(rest < e, rest, e);
+
+		for (unsigned int j = 0; j < LANES && i + j < count; j++)
+			demand[i + j] = dbf[j];
+	}
+
+	return true;
+}
+
+double TaskColumns::get_utilization() const
+{
+	vdouble sum = SPLAT(0.0);
+
+	for (unsigned int i = 0; i < capacity; i += LANES)
+		sum += LOAD(wcet, i) / LOAD(period, i);
+
+	return horizontal_sum(sum);
+}
+
+double TaskColumns::get_density() const
+{
+	vdouble sum = SPLAT(0.0);
+
+	for (unsigned int i = 0; i < capacity; i += LANES)
+		sum += LOAD(wcet, i) / LOAD(deadline, i);
+
+	return horizontal_sum(sum);
+}
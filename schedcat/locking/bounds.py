@@ -317,6 +317,62 @@ try:
 except ImportError:
     lp_cpp_available = False
 
+def set_lp_threads(num_threads):
+    """Solve the per-task LPs of the LP-based analyses with up to num_threads
+    worker threads (0: one per hardware thread). By default, they are solved
+    sequentially. The results do not depend on this setting."""
+    lp_cpp.set_lp_num_threads(num_threads)
+
+def set_lp_dense_limit(max_size):
+    """Solve LPs with at most max_size variables and constraints with the
+    built-in dense simplex solver instead of GLPK/CPLEX (0: never, the
+    default). The total blocking bounds are the same, but if an LP has several
+    optimal solutions, the split into local and remote blocking may differ."""
+    lp_cpp.set_lp_dense_limit(max_size)
+
+def set_lp_instance_aggregation(enabled):
+    """Let the DPCP and DFLP LPs use one set of variables for all instances of
+    a request instead of one per instance. The bounds are the same, but the
+    LPs are much smaller if periods are short relative to response times."""
+    lp_cpp.set_lp_instance_aggregation(enabled)
+
+def set_lp_cache_size(max_entries):
+    """Memoize the per-task results of the LP-based analyses, up to
+    max_entries of them (0: disabled, the default). A task whose inputs did
+    not change since an earlier call with the same analysis parameters then
+    gets its earlier bounds without solving its LP."""
+    lp_cpp.set_lp_cache_capacity(max_entries)
+    if not max_entries:
+        lp_cpp.clear_lp_cache()
+
+def get_lp_cache_stats():
+    return (lp_cpp.get_lp_cache_hits(), lp_cpp.get_lp_cache_misses())
+
+LP_STATS_FIELDS = ['calls', 'num_lps',
+                   'model_gen_time', 'solver_time', 'extract_time',
+                   'rows', 'cols', 'nonzeros', 'integer_vars',
+                   'max_rows', 'max_cols', 'max_nonzeros']
+
+def set_lp_stats_enabled(enabled):
+    """Record the LP generation, solver, and extraction times (CPU seconds)
+    and the LP sizes of each LP-based analysis (disabled by default)."""
+    lp_cpp.set_lp_stats_enabled(enabled)
+
+def reset_lp_stats():
+    lp_cpp.reset_lp_stats()
+
+def get_lp_stats():
+    """Return a dict that maps the name of each analysis that has been
+    called while recording (e.g., 'lp_dpcp_bounds') to a dict of its
+    totals, see LP_STATS_FIELDS."""
+    stats = {}
+    for i in range(lp_cpp.get_lp_stats_count()):
+        s = lp_cpp.get_lp_stats(i)
+        if s.calls:
+            stats[lp_cpp.get_lp_stats_name(i)] = \
+                dict((f, getattr(s, f)) for f in LP_STATS_FIELDS)
+    return stats
+
 def get_cpp_nested_cs_model(all_tasks):
     model = lp_cpp.CriticalSectionsOfTaskset()
 
@@ -327,28 +383,32 @@ def get_cpp_nested_cs_model(all_tasks):
 
     return model
 
-def apply_lp_dflp_bounds(all_tasks, resource_mapping):
+def apply_lp_dflp_bounds(all_tasks, resource_mapping, sessions=None):
+    # As for the global analyses below, pass the same lp_cpp.LPSessions
+    # object in each step of a response-time iteration to re-solve the
+    # per-task LPs in place.
     model = get_cpp_model(all_tasks)
     topo  = get_cpp_topology(resource_mapping)
-    res = lp_cpp.lp_dflp_bounds(model, topo)
+    res = lp_cpp.lp_dflp_bounds(model, topo, sessions)
     for i, t in enumerate(all_tasks):
         t.suspended = res.get_remote_blocking(i)
         t.blocked   = res.get_blocking_term(i)
     return res
 
-def apply_lp_dpcp_bounds(all_tasks, resource_mapping, use_rta = True):
+def apply_lp_dpcp_bounds(all_tasks, resource_mapping, use_rta = True,
+                         sessions=None):
     model = get_cpp_model(all_tasks)
     topo  = get_cpp_topology(resource_mapping)
-    res = lp_cpp.lp_dpcp_bounds(model, topo, use_rta)
+    res = lp_cpp.lp_dpcp_bounds(model, topo, use_rta, sessions)
     for i, t in enumerate(all_tasks):
         t.suspended = res.get_remote_blocking(i)
         t.blocked   = res.get_blocking_term(i)
     return res
 
 
-def apply_lp_mpcp_bounds(all_tasks):
+def apply_lp_mpcp_bounds(all_tasks, sessions=None):
     model = get_cpp_model(all_tasks)
-    res = lp_cpp.lp_mpcp_bounds(model)
+    res = lp_cpp.lp_mpcp_bounds(model, sessions)
 
     for i,t in enumerate(all_tasks):
         # remote blocking <=> self-suspension time
@@ -359,10 +419,10 @@ def apply_lp_mpcp_bounds(all_tasks):
 
     return res
 
-def apply_lp_part_fmlp_bounds(all_tasks):
+def apply_lp_part_fmlp_bounds(all_tasks, sessions=None):
     # LP-based analysis of the partitioned, preemptive FMLP+
     model = get_cpp_model(all_tasks)
-    res = lp_cpp.lp_part_fmlp_bounds(model)
+    res = lp_cpp.lp_part_fmlp_bounds(model, sessions)
 
     for i,t in enumerate(all_tasks):
         # remote blocking <=> self-suspension time
@@ -493,10 +553,15 @@ def apply_omip_bounds(all_tasks, num_cpus, procs_per_cluster):
     apply_suspension_oblivious(all_tasks, res)
     return res
 
-def apply_pip_bounds(all_tasks, num_cpus):
+def apply_pip_bounds(all_tasks, num_cpus, sessions=None):
     # LP-based analysis of the PIP under global scheduling
+    #
+    # The LP-based global analyses accept an optional lp_cpp.LPSessions
+    # object. Passing the same object in each step of a response-time
+    # iteration over the same task set lets the solver re-solve the
+    # per-task LPs in place instead of rebuilding them.
     model = get_cpp_model(all_tasks)
-    res = lp_cpp.lp_global_pip_bounds(model, num_cpus)
+    res = lp_cpp.lp_global_pip_bounds(model, num_cpus, sessions)
 
     for i,t in enumerate(all_tasks):
         # Note: this is a response-time bound, not just
@@ -505,11 +570,11 @@ def apply_pip_bounds(all_tasks, num_cpus):
         t.response_time = t.cost + res.get_blocking_term(i)
     return res
 
-def apply_ppcp_bounds(all_tasks, num_cpus):
+def apply_ppcp_bounds(all_tasks, num_cpus, sessions=None):
     # LP-based analysis of the PPCP under global scheduling
     model = get_cpp_model(all_tasks)
     reasonable = is_reasonable_priority_assignment(num_cpus, all_tasks)
-    res = lp_cpp.lp_ppcp_bounds(model, num_cpus, reasonable)
+    res = lp_cpp.lp_ppcp_bounds(model, num_cpus, reasonable, sessions)
 
     for i,t in enumerate(all_tasks):
         # Note: this is a response-time bound, not just
@@ -518,10 +583,10 @@ def apply_ppcp_bounds(all_tasks, num_cpus):
         t.response_time = t.cost + res.get_blocking_term(i)
     return res
 
-def apply_sa_gfmlp_bounds(all_tasks, num_cpus):
+def apply_sa_gfmlp_bounds(all_tasks, num_cpus, sessions=None):
     # LP-based s-aware analysis of the FMLP under global scheduling
     model = get_cpp_model(all_tasks)
-    res = lp_cpp.lp_sa_gfmlp_bounds(model, num_cpus)
+    res = lp_cpp.lp_sa_gfmlp_bounds(model, num_cpus, sessions)
 
     for i,t in enumerate(all_tasks):
         # Note: this is a response-time bound, not just
@@ -530,10 +595,10 @@ def apply_sa_gfmlp_bounds(all_tasks, num_cpus):
         t.response_time = t.cost + res.get_blocking_term(i)
     return res
 
-def apply_global_fmlpp_bounds(all_tasks, num_cpus):
+def apply_global_fmlpp_bounds(all_tasks, num_cpus, sessions=None):
     # LP-based s-aware analysis of the FMLP+ under global scheduling
     model = get_cpp_model(all_tasks)
-    res = lp_cpp.lp_global_fmlpp_bounds(model, num_cpus)
+    res = lp_cpp.lp_global_fmlpp_bounds(model, num_cpus, sessions)
 
     for i,t in enumerate(all_tasks):
         # Note: this is a response-time bound, not just
@@ -542,10 +607,10 @@ def apply_global_fmlpp_bounds(all_tasks, num_cpus):
         t.response_time = t.cost + res.get_blocking_term(i)
     return res
 
-def apply_prsb_bounds(all_tasks, num_cpus):
+def apply_prsb_bounds(all_tasks, num_cpus, sessions=None):
     # LP-based s-aware analysis of the PRSB under global scheduling
     model = get_cpp_model(all_tasks)
-    res = lp_cpp.lp_prsb_bounds(model, num_cpus)
+    res = lp_cpp.lp_prsb_bounds(model, num_cpus, sessions)
 
     for i,t in enumerate(all_tasks):
         # Note: this is a response-time bound, not just
@@ -554,10 +619,10 @@ def apply_prsb_bounds(all_tasks, num_cpus):
         t.response_time = t.cost + res.get_blocking_term(i)
     return res
 
-def apply_no_progress_fifo_bounds(all_tasks, num_cpus):
+def apply_no_progress_fifo_bounds(all_tasks, num_cpus, sessions=None):
     # LP-based s-aware analysis for no progress and fifo queuing under global scheduling
     model = get_cpp_model(all_tasks)
-    res = lp_cpp.lp_no_progress_fifo_bounds(model, num_cpus)
+    res = lp_cpp.lp_no_progress_fifo_bounds(model, num_cpus, sessions)
 
     for i,t in enumerate(all_tasks):
         # Note: this is a response-time bound, not just
@@ -566,10 +631,10 @@ def apply_no_progress_fifo_bounds(all_tasks, num_cpus):
         t.response_time = t.cost + res.get_blocking_term(i)
     return res
 
-def apply_no_progress_priority_bounds(all_tasks, num_cpus):
+def apply_no_progress_priority_bounds(all_tasks, num_cpus, sessions=None):
     # LP-based s-aware analysis for no progress and priority queuing under global scheduling
     model = get_cpp_model(all_tasks)
-    res = lp_cpp.lp_no_progress_priority_bounds(model, num_cpus)
+    res = lp_cpp.lp_no_progress_priority_bounds(model, num_cpus, sessions)
 
     for i,t in enumerate(all_tasks):
         # Note: this is a response-time bound, not just
@@ -586,25 +651,29 @@ def apply_pfp_nested_fifo_spinlock_bounds(all_tasks):
         all_tasks[i].blocked = res.get_blocking_term(i)
     return res
 
-def pedf_msrp_is_schedulable(all_tasks):
+# The P-EDF analyses below return lp_cpp.SCHED_SCHEDULABLE or
+# lp_cpp.SCHED_UNSCHEDULABLE. They accept an optional lp_cpp.Budget; if it
+# runs out, they return lp_cpp.SCHED_UNKNOWN.
+
+def pedf_msrp_is_schedulable(all_tasks, budget=None):
     # LP-based schedulability analysis based processor-demand criterion (PDC) for MSRP
     model = get_cpp_model(all_tasks, use_task_deadline=True)
-    return lp_cpp.lp_pedf_msrp_is_schedulable(model)
+    return lp_cpp.lp_pedf_msrp_is_schedulable(model, budget)
 
-def pedf_fifo_preempt_is_schedulable(all_tasks):
+def pedf_fifo_preempt_is_schedulable(all_tasks, budget=None):
     # LP-based schedulability analysis based processor-demand criterion (PDC) for FIFO preemptive spin locks
     model = get_cpp_model(all_tasks, use_task_deadline=True)
-    return lp_cpp.lp_pedf_fifo_preempt_is_schedulable(model)
+    return lp_cpp.lp_pedf_fifo_preempt_is_schedulable(model, budget)
 
-def pedf_lockfree_preempt_is_schedulable(all_tasks):
+def pedf_lockfree_preempt_is_schedulable(all_tasks, budget=None):
     # LP-based schedulability analysis based processor-demand criterion (PDC) for preemptive lock-free
     model = get_cpp_model(all_tasks, use_task_deadline=True)
-    return lp_cpp.lp_pedf_lockfree_preempt_is_schedulable(model)
+    return lp_cpp.lp_pedf_lockfree_preempt_is_schedulable(model, budget)
 
-def pedf_lockfree_NP_is_schedulable(all_tasks):
+def pedf_lockfree_NP_is_schedulable(all_tasks, budget=None):
     # LP-based schedulability analysis based processor-demand criterion (PDC) for NP lock-free
     model = get_cpp_model(all_tasks, use_task_deadline=True)
-    return lp_cpp.lp_pedf_lockfree_NP_is_schedulable(model)
+    return lp_cpp.lp_pedf_lockfree_NP_is_schedulable(model, budget)
 
 def pedf_msrp_classic_is_schedulable(all_tasks, num_cpus):
     # MSRP classic analysis based on QPA
@@ -1,6 +1,11 @@
 
 # Python model to C++ model conversion code.
 
+from array import array
+
+def _array_bytes(a):
+    # tostring() was renamed to tobytes() in Python 3
+    return a.tobytes() if hasattr(a, 'tobytes') else a.tostring()
 
 try:
     from .native import TaskSet
@@ -23,6 +28,23 @@ try:
                     ts.add_task(t.cost, t.period, t.deadline)
         return ts
 
+    from .native import TaskSetBatch
+
+    def get_native_batch(tasksets):
+        """Pack a list of task systems into a single native TaskSetBatch,
+        which requires only one call into the native code.
+        """
+        offsets = array('L', [0])
+        params  = array('L')
+        for tasks in tasksets:
+            for t in tasks:
+                params.extend((t.cost, t.period, t.deadline))
+            offsets.append(offsets[-1] + len(tasks))
+        batch = TaskSetBatch()
+        ok = batch.load_packed(_array_bytes(offsets), _array_bytes(params))
+        assert ok
+        return batch
+
 except ImportError:
     # Nope, C++ impl. not available. Use Python implementation.
     using_native = False
@@ -30,6 +52,9 @@ except ImportError:
     def get_native_taskset(tasks):
         assert False # C++ implementation not available
 
+    def get_native_batch(tasksets):
+        assert False # C++ implementation not available
+
 if using_native:
     try:
         from .native import AffinityRestrictions
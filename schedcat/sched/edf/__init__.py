@@ -86,12 +86,62 @@ import schedcat.sched
 if schedcat.sched.using_native:
     import schedcat.sched.native as native
 
+    # configuration -> (test, memoizing wrapper or test); tests that
+    # remember results or learn across calls are kept here; the wrapper
+    # does not own the test, so both are kept alive
+    _memoized_tests = {}
+
     def is_schedulable_cpp(no_cpus, tasks,
                            rta_min_step=1,
                            want_baruah=True,
                            want_rta=True,
                            want_ffdbf=False,
-                           want_load=False):
+                           want_load=False,
+                           memoize=False,
+                           adaptive=False):
+        """With memoize=True, the results are remembered across calls, and
+        a task set that differs from a previously tested one only by
+        smaller (larger) WCETs is accepted (rejected) without testing it
+        again. This pays off when the same task set is tested repeatedly
+        with varying overheads charged.
+
+        With adaptive=True, the order of the G-EDF sub-tests is learned
+        across calls with the same configuration (see
+        GlobalEDF.set_adaptive()). clear_memoized_results() forgets what
+        has been learned as well."""
+        config = (no_cpus, rta_min_step, want_baruah != False, want_rta,
+                  want_ffdbf, want_load, memoize, adaptive)
+        if (memoize or adaptive) and config in _memoized_tests:
+            native_test = _memoized_tests[config][1]
+        else:
+            if no_cpus == 1:
+                native_test = native.QPATest(no_cpus);
+            else:
+                native_test = native.GlobalEDF(no_cpus, rta_min_step,
+                                               want_baruah != False,
+                                               want_rta,
+                                               want_ffdbf,
+                                               want_load)
+                native_test.set_adaptive(adaptive)
+            wrapper = native_test
+            if memoize:
+                wrapper = native.MemoizedTest(native_test)
+            if memoize or adaptive:
+                _memoized_tests[config] = (native_test, wrapper)
+            native_test = wrapper
+        ts = schedcat.sched.get_native_taskset(tasks)
+        return native_test.is_schedulable(ts)
+
+    def clear_memoized_results():
+        _memoized_tests.clear()
+
+    def is_schedulable_batch_cpp(no_cpus, tasksets,
+                                 rta_min_step=1,
+                                 want_baruah=True,
+                                 want_rta=True,
+                                 want_ffdbf=False,
+                                 want_load=False,
+                                 adaptive=False):
         if no_cpus == 1:
             native_test = native.QPATest(no_cpus);
         else:
@@ -100,14 +150,59 @@ if schedcat.sched.using_native:
                                            want_rta,
                                            want_ffdbf,
                                            want_load)
-        ts = schedcat.sched.get_native_taskset(tasks)
-        return native_test.is_schedulable(ts)
+            # learn the cheapest order of the sub-tests over the batch
+            native_test.set_adaptive(adaptive)
+        batch = schedcat.sched.get_native_batch(tasksets)
+        batch_test = native.BatchSchedulabilityTest()
+        batch_test.add_test(native_test)
+        batch_test.run(batch)
+        return [batch_test.is_schedulable(i, 0) for i in range(len(tasksets))]
+
+    PARTITION_HEURISTICS = {
+        'next-fit'         : native.NEXT_FIT,
+        'first-fit'        : native.FIRST_FIT,
+        'best-fit'         : native.BEST_FIT,
+        'worst-fit'        : native.WORST_FIT,
+        'almost-worst-fit' : native.ALMOST_WORST_FIT,
+        }
+
+    PARTITION_FIT_TESTS = {
+        'utilization' : native.UtilizationFit,
+        'density'     : native.DensityFit,
+        'qpa'         : native.QPAFit,
+        }
+
+    def partition_cpp(no_cpus, tasks, heuristic='first-fit',
+                      decreasing=False, fit='qpa'):
+        """Assign tasks to no_cpus processors with a native bin-packing
+        heuristic and store the result in t.partition. fit is either the
+        name of a fit test or a native PartitionFitTest (e.g., a
+        schedcat.locking.native.MSRPPartitionFit). Returns the list of tasks
+        that did not fit (their partition is left untouched).
+        """
+        if not hasattr(fit, 'try_assign'):
+            fit = PARTITION_FIT_TESTS[fit]()
+        p = native.Partitioner(PARTITION_HEURISTICS[heuristic], decreasing)
+        p.partition(schedcat.sched.get_native_taskset(tasks), no_cpus, fit)
+        misfits = []
+        for i, t in enumerate(tasks):
+            cpu = p.get_assignment(i)
+            if cpu < 0:
+                misfits.append(t)
+            else:
+                t.partition = cpu
+        return misfits
 
     is_schedulable = is_schedulable_cpp
+    is_schedulable_batch = is_schedulable_batch_cpp
 
 else:
     is_schedulable = is_schedulable_py
 
+    def is_schedulable_batch(no_cpus, tasksets, *args, **kargs):
+        return [is_schedulable_py(no_cpus, ts, *args, **kargs)
+                for ts in tasksets]
+
 
 def bound_response_times(no_cpus, tasks, *args, **kargs):
     if is_schedulable(no_cpus, tasks, *args, **kargs):
@@ -15,3 +15,25 @@ def time_of_first_miss(no_cpus, tasks, simulation_length=60, preemptive=True):
 
 def no_counter_example(*args, **kargs):
     return not is_deadline_missed(*args, **kargs)
+
+def observe_tardiness_monte_carlo(no_cpus, tasks, scenarios,
+                                  simulation_length=60, preemptive=True,
+                                  max_offset=0, max_jitter=0,
+                                  min_cost_ratio=1, bucket_width=1,
+                                  buckets=0, seed=0, threads=0):
+    """Simulate randomized sporadic scenarios of the task system and return
+    the native EDFTardinessMonteCarlo object holding the per-task tardiness
+    statistics (get_task_stats(), get_stats()) and, if buckets > 0, the
+    tardiness histograms (get_histogram_count()). Offsets and jitter are
+    given in the time unit of the tasks.
+    """
+    ts = sim.get_native_taskset(tasks)
+    mc = cpp.EDFTardinessMonteCarlo(no_cpus, ts,
+                                    int(sec2us(simulation_length)),
+                                    preemptive)
+    mc.set_max_offset(max_offset)
+    mc.set_max_jitter(max_jitter)
+    mc.set_min_cost_ratio(min_cost_ratio)
+    mc.set_histogram(bucket_width, buckets)
+    mc.run(scenarios, seed, threads)
+    return mc
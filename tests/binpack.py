@@ -7,6 +7,10 @@ import unittest
 import schedcat.mapping.binpack as bp
 import schedcat.mapping.rollback as rb
 
+import schedcat.model.tasks as tasks
+import schedcat.sched as sched
+import schedcat.sched.edf as edf
+
 class TooLarge(unittest.TestCase):
     def setUp(self):
         self.cap   = 10
@@ -122,6 +126,64 @@ class KnownExample(unittest.TestCase):
         self.assertEqual(sets, self.expected)
 
 
+class NativePartitioning(unittest.TestCase):
+    def setUp(self):
+        self.items = [8, 5, 7, 6, 2, 4, 1]
+        self.ts = tasks.TaskSystem([tasks.SporadicTask(c, 10)
+                                    for c in self.items])
+
+    def bins(self, no_cpus, heuristic, decreasing=False, fit='utilization'):
+        misfits = edf.partition_cpp(no_cpus, self.ts, heuristic,
+                                    decreasing, fit)
+        sets = [[] for _ in range(no_cpus)]
+        for t in self.ts:
+            if not t in misfits:
+                sets[t.partition].append(t.cost)
+        return [sorted(s) for s in sets]
+
+    def test_same_as_python(self):
+        for (name, h) in [('next-fit', bp.next_fit),
+                          ('first-fit', bp.first_fit),
+                          ('worst-fit', bp.worst_fit),
+                          ('best-fit', bp.best_fit)]:
+            for no_cpus in [3, 4, 5]:
+                expected = h(self.items, no_cpus, 10)
+                self.assertEqual(self.bins(no_cpus, name),
+                                 [sorted(s) for s in expected])
+                expected = bp.decreasing(h)(self.items, no_cpus, 10)
+                self.assertEqual(self.bins(no_cpus, name, True),
+                                 [sorted(s) for s in expected])
+
+    def test_almost_worst_fit(self):
+        expected = bp.almost_worst_fit(self.items, 4, 10)
+        self.assertEqual(self.bins(4, 'almost-worst-fit'),
+                         [sorted(s) for s in expected])
+
+    def test_misfits(self):
+        misfits = edf.partition_cpp(2, self.ts, 'first-fit', fit='density')
+        self.assertEqual([t.cost for t in misfits], [7, 6])
+
+    def test_qpa_fit(self):
+        ts = tasks.TaskSystem([
+            tasks.SporadicTask(6000, 31000, deadline=18000),
+            tasks.SporadicTask(2000,  9800, deadline= 9000),
+            tasks.SporadicTask(1000, 17000, deadline=12000),
+            tasks.SporadicTask(  90,  4200, deadline= 3000),
+            tasks.SporadicTask(   8,    96, deadline=   78),
+            tasks.SporadicTask(   2,    12, deadline=   16),
+            tasks.SporadicTask(  10,   280, deadline=  120),
+            tasks.SporadicTask(  26,   660, deadline=  160),
+            tasks.SporadicTask(  10,   100, deadline=   15),
+            ])
+        for h in ['first-fit', 'worst-fit', 'best-fit']:
+            self.assertEqual(edf.partition_cpp(2, ts, h, True, 'qpa'), [])
+            qpa = edf.native.QPATest(1)
+            for cpu in range(2):
+                part = tasks.TaskSystem([t for t in ts if t.partition == cpu])
+                self.assertTrue(qpa.is_schedulable(
+                    sched.get_native_taskset(part)))
+
+
 class RollbackBins(unittest.TestCase):
     def setUp(self):
         self.bin = rb.Bin([0.2])
@@ -112,6 +112,31 @@ class Test_ffdbf(unittest.TestCase):
             ffdbf.ffdbf(self.t2, 12001, one),
             5001)
 
+    def test_native(self):
+        sets = [[(10, 100), (33, 200), (10, 300, 100)],
+                [(10, 100), (33, 200), (27, 28)]]
+        expected = [True, False]
+        for (params, ok) in zip(sets, expected):
+            # huge parameters take the rational path, which must agree
+            for scale in [1, 10**15]:
+                ts = sched.get_native_taskset(tasks.TaskSystem(
+                    [tasks.SporadicTask(*[x * scale for x in t])
+                     for t in params]))
+                self.assertEqual(edf.native.FFDBFGedf(2).is_schedulable(ts),
+                                 ok)
+                self.assertEqual(edf.native.FFDBFGedf(2, 10, 50, 3)
+                                 .is_schedulable(ts), ok)
+
+    def test_native_parallel_rounds(self):
+        # a small epsilon yields a testing interval that is scanned in
+        # several rounds of windows
+        ts = sched.get_native_taskset(tasks.TaskSystem(
+            [tasks.SporadicTask(3, 10), tasks.SporadicTask(4, 10),
+             tasks.SporadicTask(5, 12), tasks.SporadicTask(2, 7)]))
+        for threads in [1, 3]:
+            self.assertTrue(edf.native.FFDBFGedf(2, 10000, 50, threads)
+                            .is_schedulable(ts))
+
     def test_test_points(self):
         one = Fraction(1)
         pts = ffdbf.test_points(self.t1, one, 0)
@@ -204,6 +229,273 @@ class Test_QPA(unittest.TestCase):
             ])
         self.assertFalse(qpa.is_schedulable(sched.get_native_taskset(ts2)))
 
+    def test_incremental_qpa(self):
+        qpa = edf.native.QPATest(1)
+        inc = edf.native.IncrementalQPA()
+        for t in self.ts:
+            self.assertTrue(inc.add_task_if_schedulable(t.cost, t.period,
+                                                        t.deadline))
+        self.assertEqual(inc.get_task_count(), len(self.ts))
+        self.assertTrue(inc.is_schedulable())
+        self.assertTrue(qpa.is_schedulable(inc.get_tasks()))
+
+        # rejected tasks are rolled back
+        self.assertFalse(inc.add_task_if_schedulable(10, 100, 15))
+        self.assertEqual(inc.get_task_count(), len(self.ts))
+        self.assertTrue(inc.is_schedulable())
+
+        inc.add_task(10, 100, 15)
+        self.assertFalse(inc.is_schedulable())
+        self.assertFalse(qpa.is_schedulable(inc.get_tasks()))
+
+        inc.remove_task(len(self.ts))
+        self.assertTrue(inc.is_schedulable())
+
+class Test_batch(unittest.TestCase):
+
+    def setUp(self):
+        self.tasksets = [
+            tasks.TaskSystem([
+                tasks.SporadicTask(331, 15000, deadline=2688),
+                tasks.SporadicTask(3654, 77000, deadline=3849)
+                ]),
+            tasks.TaskSystem([
+                tasks.SporadicTask(6000, 31000, deadline=18000),
+                tasks.SporadicTask(2000,  9800, deadline= 9000),
+                tasks.SporadicTask(1000, 17000, deadline=12000),
+                tasks.SporadicTask(  90,  4200, deadline= 3000),
+                ]),
+            tasks.TaskSystem([
+                tasks.SporadicTask(80, 100),
+                tasks.SporadicTask(33, 66),
+                tasks.SporadicTask(7, 10),
+                ]),
+            ]
+
+    def test_batch_matches_single(self):
+        for m in [1, 2]:
+            expected = [edf.is_schedulable(m, ts) for ts in self.tasksets]
+            self.assertEqual(edf.is_schedulable_batch(m, self.tasksets),
+                             expected)
+
+    def test_multiple_tests(self):
+        batch = sched.get_native_batch(self.tasksets)
+        self.assertEqual(batch.get_task_set_count(), 3)
+        self.assertEqual(batch.get_task_count(0), 2)
+        self.assertEqual(batch.get_task_count(1), 4)
+
+        tests = [edf.native.QPATest(1), edf.native.GFBGedf(2),
+                 edf.native.BakerGedf(2)]
+        bt = edf.native.BatchSchedulabilityTest()
+        for t in tests:
+            bt.add_test(t)
+        bt.run(batch)
+
+        self.assertEqual(bt.get_task_set_count(), 3)
+        self.assertEqual(bt.get_test_count(), 3)
+        for j, t in enumerate(tests):
+            count = 0
+            for i, ts in enumerate(self.tasksets):
+                native_ts = sched.get_native_taskset(ts)
+                self.assertEqual(bt.is_schedulable(i, j),
+                                 t.is_schedulable(native_ts))
+                count += t.is_schedulable(native_ts)
+            self.assertEqual(bt.count_schedulable(j), count)
+
+    def test_malformed(self):
+        batch = edf.native.TaskSetBatch()
+        self.assertFalse(batch.load_packed(b'', b''))
+        self.assertFalse(batch.load_packed(b'x', b''))
+
+class Test_sweep(unittest.TestCase):
+
+    def test_batch_buckets(self):
+        tasksets = [tasks.TaskSystem([tasks.SporadicTask(c, 10)
+                                      for c in range(1, n + 1)])
+                    for n in range(1, 8)]
+        batch = sched.get_native_batch(tasksets)
+
+        gfb = edf.native.GFBGedf(2)
+        sweep = edf.native.SchedulabilitySweep(0.5, 4)
+        sweep.add_test(gfb)
+        sweep.run(batch)
+
+        for b in range(sweep.get_bucket_count()):
+            in_bucket = [ts for ts in tasksets
+                         if int(ts.utilization() / 0.5) == b]
+            ok = [ts for ts in in_bucket
+                  if gfb.is_schedulable(sched.get_native_taskset(ts))]
+            self.assertEqual(sweep.get_sample_count(b), len(in_bucket))
+            self.assertEqual(sweep.get_schedulable_count(b, 0), len(ok))
+
+        single = edf.native.SchedulabilitySweep(0, 2)
+        single.add_test(gfb)
+        single.run(batch)
+        self.assertEqual(single.get_bucket_count(), 1)
+        self.assertEqual(single.get_sample_count(0), len(tasksets))
+
+    def test_generator_is_deterministic(self):
+        gen = edf.native.TaskSetGenerator(10, 100, 0.1, 0.4)
+        gedf = edf.native.GlobalEDF(2)
+        results = []
+        for threads in [1, 3]:
+            sweep = edf.native.SchedulabilitySweep(0.1, threads)
+            sweep.add_test(gedf)
+            sweep.run(gen, 0.5, 2.0, 0.25, 20, 1234)
+            results.append([(sweep.get_sample_count(b),
+                             sweep.get_schedulable_count(b, 0))
+                            for b in range(sweep.get_bucket_count())])
+        self.assertEqual(results[0], results[1])
+        self.assertEqual(sum(n for (n, _) in results[0]), 7 * 20)
+
+class Test_adaptive_gedf(unittest.TestCase):
+
+    def test_same_results(self):
+        gen = edf.native.TaskSetGenerator(5, 100, 0.05, 0.5)
+        fixed = edf.native.GlobalEDF(2, 1, True, True, True)
+        adaptive = edf.native.GlobalEDF(2, 1, True, True, True)
+        adaptive.set_adaptive(True)
+        self.assertTrue(adaptive.is_adaptive())
+
+        sweep = edf.native.SchedulabilitySweep(0.25, 1)
+        sweep.add_test(fixed)
+        sweep.add_test(adaptive)
+        sweep.run(gen, 0.5, 2.0, 0.25, 30, 42)
+        for b in range(sweep.get_bucket_count()):
+            self.assertEqual(sweep.get_schedulable_count(b, 0),
+                             sweep.get_schedulable_count(b, 1))
+
+        self.assertEqual(adaptive.get_subtest_calls(edf.native.GEDF_LOAD), 0)
+        self.assertTrue(adaptive.get_subtest_calls(edf.native.GEDF_BAKER) > 0)
+        accepts = sum(adaptive.get_subtest_accepts(t)
+                      for t in range(edf.native.GEDF_NUM_SUBTESTS))
+        self.assertEqual(accepts, sum(sweep.get_schedulable_count(b, 1)
+                         for b in range(sweep.get_bucket_count())))
+
+        adaptive.set_adaptive(False)
+        self.assertEqual(adaptive.get_subtest_calls(edf.native.GEDF_BAKER), 0)
+
+class Test_memoized(unittest.TestCase):
+
+    def native(self, *tasks_):
+        return sched.get_native_taskset(tasks.TaskSystem(
+            [tasks.SporadicTask(*t) for t in tasks_]))
+
+    def test_dominance(self):
+        gedf = edf.native.GlobalEDF(2)
+        memo = edf.native.MemoizedTest(gedf)
+
+        self.assertTrue(memo.is_schedulable(
+            self.native((10, 100), (33, 200), (10, 300, 100))))
+        self.assertEqual(memo.get_misses(), 1)
+        # smaller WCETs, other order
+        self.assertTrue(memo.is_schedulable(
+            self.native((10, 300, 100), (5, 100), (33, 200))))
+        self.assertEqual(memo.get_hits(), 1)
+        # a larger WCET must be tested
+        self.assertTrue(memo.is_schedulable(
+            self.native((10, 100), (34, 200), (10, 300, 100))))
+        self.assertEqual(memo.get_misses(), 2)
+
+        self.assertFalse(memo.is_schedulable(
+            self.native((90, 100), (90, 100), (90, 100))))
+        self.assertFalse(memo.is_schedulable(
+            self.native((95, 100), (90, 100), (91, 100))))
+        self.assertEqual(memo.get_hits(), 2)
+        # other timing parameters must be tested
+        self.assertFalse(memo.is_schedulable(
+            self.native((95, 100), (90, 100), (91, 101))))
+        self.assertEqual(memo.get_misses(), 4)
+
+        memo.clear()
+        self.assertEqual(memo.get_hits(), 0)
+
+    def test_preconditions(self):
+        memo = edf.native.MemoizedTest(edf.native.GlobalEDF(2))
+        self.assertTrue(memo.is_schedulable(
+            self.native((10, 100), (33, 200), (10, 300, 100))))
+        # dominated, but a zero WCET fails the preconditions
+        self.assertFalse(memo.is_schedulable(
+            self.native((0, 100), (33, 200), (10, 300, 100))))
+        self.assertEqual(memo.get_hits(), 0)
+
+    def test_unknown_not_remembered(self):
+        ts = self.native((6000, 31000, 18000), (2000, 9800, 9000),
+                         (1000, 17000, 12000), (90, 4200, 3000),
+                         (4000, 5000, 4500))
+        memo = edf.native.MemoizedTest(edf.native.BaruahGedf(2))
+        self.assertEqual(memo.check(ts, edf.native.Budget(0, 0, 1)),
+                         edf.native.SCHED_UNKNOWN)
+        self.assertEqual(memo.check(ts, edf.native.Budget()),
+                         edf.native.SCHED_UNSCHEDULABLE)
+        self.assertEqual(memo.get_hits(), 0)
+        self.assertFalse(memo.is_schedulable(ts))
+        self.assertEqual(memo.check_default_limits(ts),
+                         edf.native.SCHED_UNSCHEDULABLE)
+        self.assertEqual(memo.get_hits(), 2)
+
+    def test_cpp_wrapper(self):
+        ts = tasks.TaskSystem([
+            tasks.SporadicTask(10, 100),
+            tasks.SporadicTask(33, 200),
+            tasks.SporadicTask(27, 28),
+        ])
+        for memoize, adaptive in [(False, False), (True, False), (True, False),
+                                  (False, True), (False, True), (True, True)]:
+            self.assertTrue(edf.is_schedulable_cpp(2, ts, memoize=memoize,
+                                                   adaptive=adaptive))
+            self.assertFalse(edf.is_schedulable_cpp(1, ts, memoize=memoize,
+                                                    adaptive=adaptive))
+        edf.clear_memoized_results()
+
+class Test_budget(unittest.TestCase):
+
+    def setUp(self):
+        self.ts = tasks.TaskSystem([
+            tasks.SporadicTask(6000, 31000, deadline=18000),
+            tasks.SporadicTask(2000,  9800, deadline= 9000),
+            tasks.SporadicTask(1000, 17000, deadline=12000),
+            tasks.SporadicTask(  90,  4200, deadline= 3000),
+            tasks.SporadicTask(4000,  5000, deadline= 4500),
+            ])
+        self.native_ts = sched.get_native_taskset(self.ts)
+
+    def test_unknown(self):
+        bar = edf.native.BaruahGedf(2)
+        self.assertEqual(bar.check(self.native_ts, edf.native.Budget()),
+                         edf.native.SCHED_UNSCHEDULABLE)
+
+        budget = edf.native.Budget(0, 0, 1)
+        self.assertEqual(bar.check(self.native_ts, budget),
+                         edf.native.SCHED_UNKNOWN)
+        self.assertTrue(budget.is_exhausted())
+
+        # the chain gives up as well if no other test succeeds
+        gedf = edf.native.GlobalEDF(2)
+        self.assertEqual(gedf.check(self.native_ts,
+                                    edf.native.Budget(0, 0, 1)),
+                         edf.native.SCHED_UNKNOWN)
+
+    def test_batch(self):
+        batch = sched.get_native_batch([self.ts, self.ts])
+        bt = edf.native.BatchSchedulabilityTest()
+        bt.add_test(edf.native.BaruahGedf(2))
+        bt.set_budget(edf.native.Budget(0, 0, 1))
+        bt.run(batch)
+        self.assertEqual(bt.count_unknown(0), 2)
+        self.assertEqual(bt.count_schedulable(0), 0)
+
+    def test_parallel(self):
+        for threads in [2, 3, 0]:
+            bar = edf.native.BaruahGedf(2, threads)
+            self.assertEqual(bar.check(self.native_ts, edf.native.Budget()),
+                             edf.native.SCHED_UNSCHEDULABLE)
+            self.assertEqual(bar.check(self.native_ts,
+                                       edf.native.Budget(0, 0, 1)),
+                             edf.native.SCHED_UNKNOWN)
+            self.assertTrue(edf.native.BaruahGedf(3, threads).is_schedulable(
+                self.native_ts))
+
 class Test_gy_rta(unittest.TestCase):
     def setUp(self):
         self.ts1 = tasks.TaskSystem([tasks.SporadicTask(3,12), tasks.SporadicTask(2,4)])
@@ -169,3 +169,18 @@ class GlobalPPCPAnalysis(unittest.TestCase):
         self.assertEqual(self.trivial_ts[3].response_time, self.trivial_ts[3].cost + 50)
         self.assertEqual(self.trivial_ts[4].response_time, self.trivial_ts[4].cost + 135)
 
+    @unittest.skipIf(not schedcat.locking.bounds.lp_cpp_available, "no native LP solver available")
+    def test_ppcp_sessions(self):
+        # response-time iteration, once from scratch and once in sessions
+        sessions = lb.lp_cpp.LPSessions()
+        for step in range(3):
+            before = [t.response_time for t in self.trivial_ts]
+            lb.apply_ppcp_bounds(self.trivial_ts, self.trivial_num_cpus)
+            expected = [t.response_time for t in self.trivial_ts]
+            for t, r in zip(self.trivial_ts, before):
+                t.response_time = r
+            lb.apply_ppcp_bounds(self.trivial_ts, self.trivial_num_cpus,
+                                 sessions)
+            self.assertEqual([t.response_time for t in self.trivial_ts],
+                             expected)
+
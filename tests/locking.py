@@ -809,6 +809,162 @@ class Test_linprog(unittest.TestCase):
     def test_dflp_cpp(self):
         lb.apply_lp_dflp_bounds(self.ts, self.resource_locality)
 
+    def make_multi_resource_ts(self):
+        # The longer response times span many periods of the shorter tasks,
+        # so requests have several instances (and instance aggregation has
+        # something to merge).
+        rng = random.Random(1)
+        ts = tasks.TaskSystem([tasks.SporadicTask(p // 4, p)
+                               for p in [10, 15, 25, 40, 100, 250]])
+        ts.assign_ids()
+        lb.assign_fp_preemption_levels(ts)
+        r.initialize_resource_model(ts)
+        for t in ts:
+            t.response_time = t.period
+            t.partition = t.id % 2
+            for res_id in rng.sample(range(3), 2):
+                for _ in range(rng.randint(1, 2)):
+                    t.resmodel[res_id].add_request(rng.randint(1, 3))
+        return ts
+
+    @unittest.skipIf(not schedcat.locking.bounds.lp_cpp_available, "no native LP solver available")
+    def test_cpp_lp_settings(self):
+        ts = self.make_multi_resource_ts()
+        locality = { 0: 0, 1: 1, 2: 0 }
+        self.assertTrue(ts[-1].response_time > 2 * ts[0].period)
+
+        analyses = [
+            ('DPCP', lambda: lb.apply_lp_dpcp_bounds(ts, locality)),
+            ('DFLP', lambda: lb.apply_lp_dflp_bounds(ts, locality)),
+            ('MPCP', lambda: lb.apply_lp_mpcp_bounds(ts)),
+            ('MSRP', lambda: lb.apply_pfp_lp_msrp_bounds(ts)),
+        ]
+        # setter, default, and the values that must not change the bounds
+        settings = [
+            (lb.set_lp_threads, 1, [2, 0]),
+            (lb.set_lp_dense_limit, 0, [1000]),
+            (lb.set_lp_instance_aggregation, False, [True]),
+        ]
+
+        def blocking(res):
+            return ([res.get_local_blocking(i) for i in range(len(ts))],
+                    [res.get_remote_blocking(i) for i in range(len(ts))],
+                    [res.get_blocking_term(i) for i in range(len(ts))])
+
+        for name, apply_bounds in analyses:
+            local, remote, total = blocking(apply_bounds())
+            for set_option, default, values in settings:
+                for value in values:
+                    set_option(value)
+                    try:
+                        res = apply_bounds()
+                    finally:
+                        set_option(default)
+                    msg = '%s, %s(%r)' % (name, set_option.__name__, value)
+                    res_local, res_remote, res_total = blocking(res)
+                    self.assertEqual(res_local, local, msg)
+                    self.assertEqual(res_remote, remote, msg)
+                    self.assertEqual(res_total, total, msg)
+
+    @unittest.skipIf(not schedcat.locking.bounds.lp_cpp_available, "no native LP solver available")
+    def test_dpcp_cpp_cache(self):
+        def blocking():
+            res = lb.apply_lp_dpcp_bounds(self.ts, self.resource_locality)
+            return [(res.get_blocking_term(i), res.get_remote_blocking(i))
+                    for i in range(len(self.ts))]
+
+        uncached = blocking()
+        lb.set_lp_cache_size(8)
+        try:
+            self.assertEqual(blocking(), uncached)
+            self.assertEqual(lb.get_lp_cache_stats(), (0, 3))
+            self.assertEqual(blocking(), uncached)
+            self.assertEqual(lb.get_lp_cache_stats(), (3, 3))
+
+            # with use_rta, any response time is an input of all tasks
+            self.ts[0].response_time += 1
+            blocking()
+            self.assertEqual(lb.get_lp_cache_stats(), (3, 6))
+            self.ts[0].response_time -= 1
+        finally:
+            lb.set_lp_cache_size(0)
+
+    @unittest.skipIf(not schedcat.locking.bounds.lp_cpp_available, "no native LP solver available")
+    def test_dflp_cpp_cache(self):
+        def blocking():
+            res = lb.apply_lp_dflp_bounds(self.ts, self.resource_locality)
+            return [(res.get_blocking_term(i), res.get_remote_blocking(i))
+                    for i in range(len(self.ts))]
+
+        self.ts[0].response_time += 1
+        changed = blocking()
+        self.ts[0].response_time -= 1
+
+        lb.set_lp_cache_size(8)
+        try:
+            blocking()
+            self.assertEqual(lb.get_lp_cache_stats(), (0, 3))
+
+            # T3 does not see another job of T1 within its response time,
+            # so only its bounds can be reused
+            self.ts[0].response_time += 1
+            self.assertEqual(blocking(), changed)
+            self.assertEqual(lb.get_lp_cache_stats(), (1, 5))
+        finally:
+            self.ts[0].response_time -= 1
+            lb.set_lp_cache_size(0)
+
+    @unittest.skipIf(not schedcat.locking.bounds.lp_cpp_available, "no native LP solver available")
+    def test_cpp_sessions(self):
+        analyses = [
+            lambda s: lb.apply_lp_dpcp_bounds(self.ts, self.resource_locality,
+                                              sessions=s),
+            lambda s: lb.apply_lp_dflp_bounds(self.ts, self.resource_locality, s),
+            lambda s: lb.apply_lp_mpcp_bounds(self.ts, s),
+            lambda s: lb.apply_lp_part_fmlp_bounds(self.ts, s),
+        ]
+        for apply_bounds in analyses:
+            sessions = lb.lp_cpp.LPSessions()
+            # as in a response-time iteration, once from scratch and once
+            # in sessions
+            for step in range(3):
+                # The split into local and remote blocking may differ
+                # if an LP has several optimal solutions.
+                res = apply_bounds(None)
+                expected = [res.get_blocking_term(i) for i in range(len(self.ts))]
+                res = apply_bounds(sessions)
+                self.assertEqual([res.get_blocking_term(i)
+                                  for i in range(len(self.ts))], expected)
+                for t in self.ts:
+                    t.response_time += 10
+        for t in self.ts:
+            t.response_time = t.period
+
+    @unittest.skipIf(not schedcat.locking.bounds.lp_cpp_available, "no native LP solver available")
+    def test_cpp_lp_stats(self):
+        lb.reset_lp_stats()
+        lb.apply_lp_dpcp_bounds(self.ts, self.resource_locality)
+        self.assertEqual(lb.get_lp_stats(), {})
+
+        lb.set_lp_stats_enabled(True)
+        try:
+            lb.apply_lp_dpcp_bounds(self.ts, self.resource_locality)
+            lb.apply_lp_dpcp_bounds(self.ts, self.resource_locality)
+        finally:
+            lb.set_lp_stats_enabled(False)
+        stats = lb.get_lp_stats()
+        self.assertEqual(list(stats.keys()), ['lp_dpcp_bounds'])
+        dpcp = stats['lp_dpcp_bounds']
+        self.assertEqual(dpcp['calls'], 2)
+        # one LP per task and call
+        self.assertEqual(dpcp['num_lps'], 2 * len(self.ts))
+        self.assertTrue(dpcp['rows'] > 0)
+        self.assertTrue(dpcp['max_cols'] <= dpcp['cols'])
+        self.assertTrue(dpcp['solver_time'] >= 0)
+
+        lb.reset_lp_stats()
+        self.assertEqual(lb.get_lp_stats(), {})
+
 
     @unittest.skipIf(not schedcat.locking.bounds.lp_cpp_available, "no native LP solver available")
     def test_dpcp_cpp_no_req(self):
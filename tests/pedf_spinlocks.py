@@ -73,14 +73,16 @@ class PEDF_Spinlocks(unittest.TestCase):
 
     @unittest.skipIf(not schedcat.locking.bounds.lp_cpp_available, "no native LP solver available")
     def test_MSRP(self):
-        if lb.pedf_msrp_is_schedulable(self.trivial_ts):
+        if (lb.pedf_msrp_is_schedulable(self.trivial_ts) ==
+            lb.lp_cpp.SCHED_SCHEDULABLE):
             print "[MSRP] SCHEDULABLE";
         else:
             print "[MSRP] NOT SCHEDULABLE";
 
     @unittest.skipIf(not schedcat.locking.bounds.lp_cpp_available, "no native LP solver available")
     def test_FIFO_preempt(self):
-        if lb.pedf_fifo_preempt_is_schedulable(self.trivial_ts):
+        if (lb.pedf_fifo_preempt_is_schedulable(self.trivial_ts) ==
+            lb.lp_cpp.SCHED_SCHEDULABLE):
             print "[FIFO Preemptive] SCHEDULABLE";
         else:
             print "[FIFO Preemptive] NOT SCHEDULABLE";
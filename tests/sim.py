@@ -1,12 +1,56 @@
 from __future__ import division
 
 import unittest
+import random
 
 import schedcat.sim.edf as edf
 import schedcat.model.tasks as tasks
 
 from schedcat.util.math import is_integral
 
+def reference_gedf_stats(m, params, end):
+    """Straightforward preemptive G-EDF simulation of periodic tasks given
+    as (cost, period, deadline) triples. Deadline ties are broken by task
+    index. Mirrors the event loop of the native simulator, which runs until
+    the first event after end."""
+    n = len(params)
+    release = [0] * n
+    remaining = [cost for (cost, period, deadline) in params]
+    ready = [False] * n
+    running = []
+    now = 0
+    tardy = ok = total = worst = 0
+    while now <= end:
+        times = [now + remaining[i] for i in running] + \
+                [release[i] for i in range(n) if not ready[i]]
+        if not times:
+            break
+        t = min(times)
+        for i in running:
+            remaining[i] -= t - now
+        now = t
+        for i in running:
+            if remaining[i] == 0:
+                cost, period, deadline = params[i]
+                late = now - (release[i] + deadline)
+                if late > 0:
+                    tardy += 1
+                    total += late
+                    worst = max(worst, late)
+                else:
+                    ok += 1
+                release[i] += period
+                remaining[i] = cost
+                ready[i] = False
+        for i in range(n):
+            if release[i] <= now:
+                ready[i] = True
+        by_prio = sorted([i for i in range(n) if ready[i]],
+                         key=lambda i: (release[i] + params[i][2], i))
+        running = by_prio[:m]
+    return (tardy, ok, total, worst)
+
+
 class EDFSimulator(unittest.TestCase):
     def setUp(self):
         self.ts = tasks.TaskSystem([
@@ -24,3 +68,59 @@ class EDFSimulator(unittest.TestCase):
         self.assertEqual(edf.time_of_first_miss(1, self.ts), 3)
         self.assertEqual(edf.time_of_first_miss(2, self.ts), 3)
         self.assertEqual(edf.time_of_first_miss(3, self.ts, simulation_length=1), 0)
+
+    def test_monte_carlo_periodic(self):
+        mc = edf.observe_tardiness_monte_carlo(2, self.ts, 3,
+                                               simulation_length=1)
+        ts = edf.sim.get_native_taskset(self.ts)
+        ref = edf.cpp.edf_observe_tardiness(2, ts, int(edf.sec2us(1)))
+        total = mc.get_stats()
+        self.assertEqual(mc.get_scenario_count(), 3)
+        self.assertEqual(total.num_tardy_jobs, 3 * ref.num_tardy_jobs)
+        self.assertEqual(total.num_ok_jobs, 3 * ref.num_ok_jobs)
+        self.assertEqual(total.total_tardiness, 3 * ref.total_tardiness)
+        self.assertEqual(total.max_tardiness, ref.max_tardiness)
+
+    def test_monte_carlo_is_deterministic(self):
+        results = []
+        for threads in [1, 3]:
+            mc = edf.observe_tardiness_monte_carlo(2, self.ts, 10,
+                                                   simulation_length=0.1,
+                                                   max_offset=5, max_jitter=2,
+                                                   min_cost_ratio=0.5,
+                                                   bucket_width=1, buckets=4,
+                                                   seed=1234, threads=threads)
+            stats = [mc.get_task_stats(i) for i in range(len(self.ts))]
+            results.append(([(s.num_ok_jobs, s.num_tardy_jobs,
+                              s.total_tardiness, s.max_tardiness)
+                             for s in stats],
+                            [[mc.get_histogram_count(i, b) for b in range(4)]
+                             for i in range(len(self.ts))]))
+        self.assertEqual(results[0], results[1])
+        stats, hist = results[0]
+        for (ok, tardy, _, _), counts in zip(stats, hist):
+            self.assertEqual(sum(counts), ok + tardy)
+
+    def test_monte_carlo_empty(self):
+        mc = edf.observe_tardiness_monte_carlo(2, tasks.TaskSystem([]), 3,
+                                               simulation_length=0.1,
+                                               buckets=4)
+        total = mc.get_stats()
+        self.assertEqual(mc.get_scenario_count(), 3)
+        self.assertEqual(total.num_ok_jobs + total.num_tardy_jobs, 0)
+
+    def test_matches_reference_schedule(self):
+        rng = random.Random(1)
+        for _ in range(100):
+            m = rng.randint(1, 3)
+            params = []
+            for _ in range(rng.randint(m, 3 * m + 2)):
+                period = rng.randint(2, 30)
+                cost = rng.randint(1, period)
+                params.append((cost, period, rng.randint(cost, period)))
+            ts = edf.sim.get_native_taskset(
+                [tasks.SporadicTask(c, p, d) for (c, p, d) in params])
+            s = edf.cpp.edf_observe_tardiness(m, ts, 1000)
+            self.assertEqual((s.num_tardy_jobs, s.num_ok_jobs,
+                              s.total_tardiness, s.max_tardiness),
+                             reference_gedf_stats(m, params, 1000))